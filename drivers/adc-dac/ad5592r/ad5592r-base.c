@@ -326,3 +326,104 @@ int32_t ad5592r_reset_channel_modes(struct ad5592r_dev *dev)
 
 	return ad5592r_set_channel_modes(dev);
 }
+
+/**
+ * Start streaming ADC channels. The sequence is programmed once with the
+ * repeat bit set, the device then keeps converting it for every result read
+ * by ad5592r_adc_stream_read(). Single ADC reads are refused with -EBUSY
+ * until ad5592r_adc_stream_stop(), since they would reprogram the sequence.
+ *
+ * @param dev - The device structure.
+ * @param chans - The ADC channels in the sequence, all in an ADC mode.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5592r_adc_stream_start(struct ad5592r_dev *dev, uint16_t chans)
+{
+	uint16_t adc_chans = 0;
+	int32_t ret;
+	uint8_t i;
+
+	if (!dev || !dev->ops->start_adc_stream)
+		return FAILURE;
+
+	if (dev->adc_stream_chans)
+		return -EBUSY;
+
+	for (i = 0; i < 8; i++)
+		if (dev->channel_modes[i] == CH_MODE_ADC ||
+		    dev->channel_modes[i] == CH_MODE_DAC_AND_ADC)
+			adc_chans |= BIT(i);
+
+	if (!chans || (chans & ~adc_chans))
+		return -EINVAL;
+
+	ret = dev->ops->start_adc_stream(dev, chans);
+	if (ret < 0)
+		return ret;
+
+	dev->adc_stream_chans = chans;
+
+	return 0;
+}
+
+/**
+ * Read sequences from the ADC stream. All the results are read with a single
+ * bus operation, then their channel tags are checked against the sequence and
+ * dropped.
+ *
+ * @param dev - The device structure.
+ * @param values - ADC values, nb_seq times the sequence channels in ascending
+ *                 order.
+ * @param nb_seq - Number of sequences to read.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5592r_adc_stream_read(struct ad5592r_dev *dev, uint16_t *values,
+				uint32_t nb_seq)
+{
+	uint8_t order[8];
+	uint8_t samples = 0;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!dev || !values || !dev->adc_stream_chans)
+		return FAILURE;
+
+	for (i = 0; i < 8; i++)
+		if (dev->adc_stream_chans & BIT(i))
+			order[samples++] = i;
+
+	ret = dev->ops->read_adc_stream(dev, values, nb_seq * samples);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0, j = 0; i < nb_seq * samples; i++) {
+		/* A result out of order means the stream lost its position */
+		if (AD5592R_ADC_RESULT_CHAN(values[i]) != order[j])
+			return FAILURE;
+
+		values[i] = AD5592R_ADC_RESULT_DATA(values[i]);
+		if (++j == samples)
+			j = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop streaming ADC channels.
+ *
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5592r_adc_stream_stop(struct ad5592r_dev *dev)
+{
+	if (!dev)
+		return FAILURE;
+
+	if (!dev->adc_stream_chans)
+		return 0;
+
+	dev->adc_stream_chans = 0;
+
+	return ad5592r_base_reg_write(dev, AD5592R_REG_ADC_SEQ, 0);
+}
@@ -90,6 +90,9 @@ enum ad5592r_registers {
 #define AD5592R_REG_ADC_SEQ_TEMP_READBACK	    BIT(8)
 #define AD5592R_REG_ADC_SEQ_CODE_MSK(x)		    ((x) & 0x0FFF)
 
+#define AD5592R_ADC_RESULT_CHAN(x)		    (((x) >> 12) & 0xF)
+#define AD5592R_ADC_RESULT_DATA(x)		    ((x) & 0x0FFF)
+
 #define AD5592R_REG_GPIO_OUT_EN_ADC_NOT_BUSY	    BIT(8)
 
 #define AD5592R_REG_LDAC_IMMEDIATE_OUT		    0x00
@@ -112,6 +115,9 @@ struct ad5592r_rw_ops {
 	int32_t (*reg_read)(struct ad5592r_dev *dev, uint8_t reg,
 			    uint16_t *value);
 	int32_t (*gpio_read)(struct ad5592r_dev *dev, uint8_t *value);
+	int32_t (*start_adc_stream)(struct ad5592r_dev *dev, uint16_t chans);
+	int32_t (*read_adc_stream)(struct ad5592r_dev *dev, uint16_t *values,
+				   uint32_t nb_values);
 };
 
 struct ad5592r_init_param {
@@ -132,6 +138,7 @@ struct ad5592r_dev {
 	uint8_t gpio_in;
 	uint8_t gpio_val;
 	uint8_t ldac_mode;
+	uint16_t adc_stream_chans;
 };
 
 int32_t ad5592r_base_reg_write(struct ad5592r_dev *dev, uint8_t reg,
@@ -147,5 +154,9 @@ int32_t ad5592r_gpio_direction_output(struct ad5592r_dev *dev,
 int32_t ad5592r_software_reset(struct ad5592r_dev *dev);
 int32_t ad5592r_set_channel_modes(struct ad5592r_dev *dev);
 int32_t ad5592r_reset_channel_modes(struct ad5592r_dev *dev);
+int32_t ad5592r_adc_stream_start(struct ad5592r_dev *dev, uint16_t chans);
+int32_t ad5592r_adc_stream_read(struct ad5592r_dev *dev, uint16_t *values,
+				uint32_t nb_seq);
+int32_t ad5592r_adc_stream_stop(struct ad5592r_dev *dev);
 
 #endif /* AD5592R_BASE_H_ */
@@ -47,6 +47,8 @@ const struct ad5592r_rw_ops ad5592r_rw_ops = {
 	.reg_write = ad5592r_reg_write,
 	.reg_read = ad5592r_reg_read,
 	.gpio_read = ad5592r_gpio_read,
+	.start_adc_stream = ad5592r_start_adc_stream,
+	.read_adc_stream = ad5592r_read_adc_stream,
 };
 
 /**
@@ -107,6 +109,10 @@ int32_t ad5592r_read_adc(struct ad5592r_dev *dev, uint8_t chan,
 	if (!dev)
 		return FAILURE;
 
+	/* The sequence register is owned by the stream until it is stopped */
+	if (dev->adc_stream_chans)
+		return -EBUSY;
+
 	dev->spi_msg = swab16((uint16_t)(AD5592R_REG_ADC_SEQ << 11) |
 			      BIT(chan));
 
@@ -150,6 +156,9 @@ int32_t ad5592r_multi_read_adc(struct ad5592r_dev *dev, uint16_t chans,
 	if (!dev)
 		return FAILURE;
 
+	if (dev->adc_stream_chans)
+		return -EBUSY;
+
 	samples = hweight8(chans);
 
 	dev->spi_msg = swab16((uint16_t)(AD5592R_REG_ADC_SEQ << 11) | chans);
@@ -177,6 +186,67 @@ int32_t ad5592r_multi_read_adc(struct ad5592r_dev *dev, uint16_t chans,
 	return 0;
 }
 
+/**
+ * Start a repeated ADC sequence.
+ *
+ * @param dev - The device structure.
+ * @param chans - The ADC channels in the sequence
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5592r_start_adc_stream(struct ad5592r_dev *dev, uint16_t chans)
+{
+	int32_t ret;
+
+	if (!dev)
+		return FAILURE;
+
+	dev->spi_msg = swab16((uint16_t)(AD5592R_REG_ADC_SEQ << 11) |
+			      AD5592R_REG_ADC_SEQ_REP | chans);
+
+	ret = spi_write_and_read(dev->spi, (uint8_t *)&dev->spi_msg,
+				 sizeof(dev->spi_msg));
+	if (ret < 0)
+		return ret;
+
+	/*
+	 * Invalid data:
+	 * See Figure 40. Single-Channel ADC Conversion Sequence
+	 */
+	return ad5592r_spi_wnop_r16(dev, &dev->spi_msg);
+}
+
+/**
+ * Read results of the repeated ADC sequence.
+ *
+ * Every conversion is started by a SYNC edge, so each result still needs its
+ * own 16-bit frame. The frames are clocked in place in the values array.
+ *
+ * @param dev - The device structure.
+ * @param values - ADC results, with their channel tags
+ * @param nb_values - Number of results to read
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5592r_read_adc_stream(struct ad5592r_dev *dev, uint16_t *values,
+				uint32_t nb_values)
+{
+	int32_t ret;
+	uint32_t i;
+
+	if (!dev)
+		return FAILURE;
+
+	for (i = 0; i < nb_values; i++) {
+		values[i] = 0; /* NOP */
+		ret = spi_write_and_read(dev->spi, (uint8_t *)&values[i],
+					 sizeof(values[i]));
+		if (ret < 0)
+			return ret;
+		values[i] = swab16(values[i]);
+	}
+
+	return 0;
+}
+
 /**
  * Write register.
  *
@@ -51,6 +51,8 @@
 #define STOP_BIT	1
 #define RESTART_BIT	0
 #define AD5593R_ADC_VALUES_BUFF_SIZE	    18
+/* Largest read of ADC results fitting the I2C transfer length */
+#define AD5593R_ADC_STREAM_CHUNK	    127
 
 const struct ad5592r_rw_ops ad5593r_rw_ops = {
 	.write_dac = ad5593r_write_dac,
@@ -59,6 +61,8 @@ const struct ad5592r_rw_ops ad5593r_rw_ops = {
 	.reg_write = ad5593r_reg_write,
 	.reg_read = ad5593r_reg_read,
 	.gpio_read = ad5593r_gpio_read,
+	.start_adc_stream = ad5593r_start_adc_stream,
+	.read_adc_stream = ad5593r_read_adc_stream,
 };
 
 /**
@@ -102,6 +106,10 @@ int32_t ad5593r_read_adc(struct ad5592r_dev *dev, uint8_t chan,
 	if (!dev)
 		return FAILURE;
 
+	/* The sequence register is owned by the stream until it is stopped */
+	if (dev->adc_stream_chans)
+		return -EBUSY;
+
 	temp = BIT(chan);
 
 	data[0] = AD5593R_MODE_CONF | AD5592R_REG_ADC_SEQ;
@@ -144,6 +152,9 @@ int32_t ad5593r_multi_read_adc(struct ad5592r_dev *dev, uint16_t chans,
 	if (!dev)
 		return FAILURE;
 
+	if (dev->adc_stream_chans)
+		return -EBUSY;
+
 	samples = hweight8(chans);
 
 	data[0] = AD5593R_MODE_CONF | AD5592R_REG_ADC_SEQ;
@@ -170,6 +181,72 @@ int32_t ad5593r_multi_read_adc(struct ad5592r_dev *dev, uint16_t chans,
 	return 0;
 }
 
+/**
+ * Start a repeated ADC sequence. The ADC readback pointer is written once,
+ * the reads that follow return results without being addressed again.
+ *
+ * @param dev - The device structure.
+ * @param chans - The ADC channels in the sequence
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5593r_start_adc_stream(struct ad5592r_dev *dev, uint16_t chans)
+{
+	int32_t ret;
+	uint8_t data[3];
+
+	if (!dev)
+		return FAILURE;
+
+	chans |= AD5592R_REG_ADC_SEQ_REP;
+
+	data[0] = AD5593R_MODE_CONF | AD5592R_REG_ADC_SEQ;
+	data[1] = chans >> 8;
+	data[2] = chans & 0xFF;
+
+	ret = i2c_write(dev->i2c, data, sizeof(data), STOP_BIT);
+	if (ret < 0)
+		return ret;
+
+	data[0] = AD5593R_MODE_ADC_READBACK;
+
+	return i2c_write(dev->i2c, data, 1, STOP_BIT);
+}
+
+/**
+ * Read results of the repeated ADC sequence, in the longest reads the I2C
+ * layer allows. The bytes are received in place in the values array.
+ *
+ * @param dev - The device structure.
+ * @param values - ADC results, with their channel tags
+ * @param nb_values - Number of results to read
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t ad5593r_read_adc_stream(struct ad5592r_dev *dev, uint16_t *values,
+				uint32_t nb_values)
+{
+	uint8_t *data;
+	uint32_t i, j, n;
+	int32_t ret;
+
+	if (!dev)
+		return FAILURE;
+
+	for (i = 0; i < nb_values; i += n) {
+		n = min(nb_values - i, (uint32_t)AD5593R_ADC_STREAM_CHUNK);
+		data = (uint8_t *)&values[i];
+
+		ret = i2c_read(dev->i2c, data, 2 * n, STOP_BIT);
+		if (ret < 0)
+			return ret;
+
+		for (j = 0; j < n; j++)
+			values[i + j] = ((uint16_t)data[2 * j] << 8) |
+					data[2 * j + 1];
+	}
+
+	return 0;
+}
+
 /**
  * Write register.
  *
@@ -48,6 +48,9 @@ int32_t ad5593r_read_adc(struct ad5592r_dev *dev, uint8_t chan,
 			 uint16_t *value);
 int32_t ad5593r_multi_read_adc(struct ad5592r_dev *dev,
 			       uint16_t chans, uint16_t *value);
+int32_t ad5593r_start_adc_stream(struct ad5592r_dev *dev, uint16_t chans);
+int32_t ad5593r_read_adc_stream(struct ad5592r_dev *dev, uint16_t *values,
+				uint32_t nb_values);
 int32_t ad5593r_reg_write(struct ad5592r_dev *dev, uint8_t reg,
 			  uint16_t value);
 int32_t ad5593r_reg_read(struct ad5592r_dev *dev, uint8_t reg,
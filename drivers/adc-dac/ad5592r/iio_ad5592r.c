@@ -0,0 +1,208 @@
+/***************************************************************************//**
+ *   @file   iio_ad5592r.c
+ *   @brief  Implementation of the ad5592r/ad5593r IIO driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "error.h"
+#include "iio.h"
+#include "iio_ad5592r.h"
+#include "util.h"
+#include "ad5592r-base.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read the raw value of an ADC channel.
+ * @param device - Device descriptor.
+ * @param buf - Output buffer.
+ * @param len - Length of the output buffer.
+ * @param channel - Channel info.
+ * @param priv - Unused.
+ * @return Number of characters written to buf, negative error code otherwise.
+ */
+static ssize_t iio_ad5592r_read_raw_chan(void *device, char *buf, size_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ad5592r_dev *dev = device;
+	uint16_t value;
+	int32_t ret;
+
+	ret = dev->ops->read_adc(dev, channel->ch_num, &value);
+	if (ret < 0)
+		return ret;
+
+	return snprintf(buf, len, "%"PRIu16, AD5592R_ADC_RESULT_DATA(value));
+}
+
+/**
+ * @brief Start streaming the active ADC channels.
+ * @param dev - Device descriptor.
+ * @param mask - Active channels mask, only channels in an ADC mode.
+ * @return SUCCESS in case of success, -EINVAL if a channel is not an ADC,
+ *	   error code otherwise.
+ */
+static int32_t iio_ad5592r_prepare_transfer(void *dev, uint32_t mask)
+{
+	if (mask & ~(uint32_t)0xFF)
+		return -EINVAL;
+
+	return ad5592r_adc_stream_start(dev, mask);
+}
+
+/**
+ * @brief Stop streaming the ADC channels.
+ * @param dev - Device descriptor.
+ * @return SUCCESS in case of success, error code otherwise.
+ */
+static int32_t iio_ad5592r_end_transfer(void *dev)
+{
+	return ad5592r_adc_stream_stop(dev);
+}
+
+/**
+ * @brief Get a number of samples from all the active channels.
+ * @param dev - Device descriptor.
+ * @param buff - Sample buffer.
+ * @param nb_samples - Number of samples to get.
+ * @return Number of samples read, negative error code otherwise.
+ */
+static int32_t iio_ad5592r_read_samples(void *dev, uint16_t *buff,
+					uint32_t nb_samples)
+{
+	int32_t ret;
+
+	ret = ad5592r_adc_stream_read(dev, buff, nb_samples);
+	if (ret < 0)
+		return ret;
+
+	return nb_samples;
+}
+
+/**
+ * @brief Read a device register.
+ * @param dev - Device descriptor.
+ * @param reg - Register address.
+ * @param readval - Register value.
+ * @return SUCCESS in case of success, error code otherwise.
+ */
+static int32_t iio_ad5592r_reg_read(void *dev, uint32_t reg, uint32_t *readval)
+{
+	uint16_t value;
+	int32_t ret;
+
+	ret = ad5592r_base_reg_read(dev, reg, &value);
+	if (ret < 0)
+		return ret;
+
+	*readval = value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write a device register.
+ * @param dev - Device descriptor.
+ * @param reg - Register address.
+ * @param writeval - Register value.
+ * @return SUCCESS in case of success, error code otherwise.
+ */
+static int32_t iio_ad5592r_reg_write(void *dev, uint32_t reg,
+				     uint32_t writeval)
+{
+	return ad5592r_base_reg_write(dev, reg, writeval);
+}
+
+static struct iio_attribute channel_attributes[] = {
+	{
+		.name = "raw",
+		.priv = 0,
+		.show = iio_ad5592r_read_raw_chan,
+		.store = NULL
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct scan_type ad5592r_iio_scan_type = {
+	.sign = 'u',
+	.realbits = 12,
+	.storagebits = 16,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+#define AD5592R_IIO_CHANN_DEF(nm, ch) \
+	{ \
+		.name = nm, \
+		.ch_type = IIO_VOLTAGE, \
+		.channel = ch, \
+		.scan_index = ch, \
+		.scan_type = &ad5592r_iio_scan_type, \
+		.attributes = channel_attributes, \
+		.ch_out = 0, \
+		.indexed = 1, \
+	}
+
+static struct iio_channel ad5592r_channels[] = {
+	AD5592R_IIO_CHANN_DEF("ch0", 0),
+	AD5592R_IIO_CHANN_DEF("ch1", 1),
+	AD5592R_IIO_CHANN_DEF("ch2", 2),
+	AD5592R_IIO_CHANN_DEF("ch3", 3),
+	AD5592R_IIO_CHANN_DEF("ch4", 4),
+	AD5592R_IIO_CHANN_DEF("ch5", 5),
+	AD5592R_IIO_CHANN_DEF("ch6", 6),
+	AD5592R_IIO_CHANN_DEF("ch7", 7)
+};
+
+struct iio_device iio_ad5592r_device = {
+	.num_ch = ARRAY_SIZE(ad5592r_channels),
+	.channels = ad5592r_channels,
+	.attributes = NULL,
+	.debug_attributes = NULL,
+	.buffer_attributes = NULL,
+	.prepare_transfer = iio_ad5592r_prepare_transfer,
+	.end_transfer = iio_ad5592r_end_transfer,
+	.read_dev = (int32_t (*)())iio_ad5592r_read_samples,
+	.debug_reg_read = iio_ad5592r_reg_read,
+	.debug_reg_write = iio_ad5592r_reg_write
+};
@@ -53,6 +53,8 @@
 
 #define CHIPID_AD9081	0x9081
 #define CHIPID_MASK	0xFFFF
+/* Longest API transfer: 2 address bytes and a 12 byte register burst */
+#define AD9081_SPI_XFER_MAX_BYTES	16
 
 static int32_t ad9081_nco_sync_master_slave(struct ad9081_phy *phy,
 		bool master)
@@ -853,12 +855,14 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 			       uint8_t *out_data, uint32_t size_bytes)
 {
 	struct ad9081_phy *phy = user_data;
-	uint8_t data[6];
+	uint8_t data[AD9081_SPI_XFER_MAX_BYTES];
 	uint16_t bytes_number;
 	int32_t ret;
 	int32_t i;
 
 	bytes_number = (size_bytes & 0xFF);
+	if (bytes_number > AD9081_SPI_XFER_MAX_BYTES)
+		return FAILURE;
 
 	if (phy->ad9081.hal_info.msb == SPI_MSB_FIRST) {
 		for (i = 0; i < bytes_number; i++)
@@ -874,6 +878,10 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 	if (ret != SUCCESS)
 		return FAILURE;
 
+	/* burst writes do not read anything back */
+	if (!out_data)
+		return SUCCESS;
+
 	if (phy->ad9081.hal_info.msb == SPI_MSB_FIRST) {
 		for (i = 0; i < bytes_number; i++)
 			out_data[i] =  data[i];
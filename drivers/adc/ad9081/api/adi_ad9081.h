@@ -610,6 +610,29 @@ typedef struct {
 	adi_ad9081_serdes_settings_t serdes_info;
 } adi_ad9081_device_t;
 
+/*!
+ * @brief DUC NCO Hop, Precomputed SPI Write Images
+ */
+typedef struct {
+	uint8_t ftw_frame[10]; /*!< Burst write of DATAPATH_CFG, FTW_UPDATE and FTW0..FTW5 */
+	uint8_t acc_frame[14]; /*!< Burst write of ACC_MODULUS0..5 and ACC_DELTA0..5 */
+	uint8_t acc_en; /*!< Write acc_frame on hop, modulus mode entries only */
+} adi_ad9081_dac_nco_hop_t;
+
+/*!
+ * @brief DUC NCO Hop Table, main NCOs or channel NCOs
+ */
+typedef struct {
+	adi_ad9081_dac_nco_hop_t *hops; /*!< Caller provided entries */
+	uint16_t num_hops; /*!< Number of entries */
+	uint8_t dacs; /*!< Main NCOs, AD9081_DAC_NONE for a channel NCO table */
+	uint8_t channels; /*!< Channel NCOs, AD9081_DAC_CH_NONE for a main NCO table */
+	uint8_t main_interp; /*!< Main datapath interpolation, scales channel NCO shifts */
+	uint8_t cfg; /*!< DATAPATH_CFG image with the NCO enabled and the modulus disabled */
+	uint8_t page_frame[3]; /*!< Write selecting the DAC/channel page */
+	uint8_t load_frame[3]; /*!< Write of FTW_UPDATE with the load request set */
+} adi_ad9081_dac_nco_hop_table_t;
+
 /*============= E X P O R T S ==============*/
 #ifdef __cplusplus
 extern "C" {
@@ -1288,6 +1311,78 @@ int32_t adi_ad9081_dac_duc_nco_ftw_set(adi_ad9081_device_t *device,
 int32_t adi_ad9081_dac_duc_nco_set(adi_ad9081_device_t *device, uint8_t dacs,
 				   uint8_t channels, int64_t nco_shift_hz);
 
+/**
+ * @brief  Prepare a NCO Hop Table
+ *         Enables the NCOs and caches their configuration, the entries are
+ *         filled in by adi_ad9081_dac_duc_nco_hop_table_set() or
+ *         adi_ad9081_dac_duc_nco_hop_table_ftw_set().
+ *         Call after adi_ad9081_device_startup_tx().
+ *
+ * @param  device   Pointer to the device structure
+ * @param  table    Hop table
+ * @param  dacs     DAC mask for a main NCO table, AD9081_DAC_NONE otherwise
+ * @param  channels Channel mask for a channel NCO table, AD9081_DAC_CH_NONE otherwise
+ * @param  hops     Storage for the table entries
+ * @param  num_hops Number of entries
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_dac_duc_nco_hop_table_init(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint8_t dacs, uint8_t channels, adi_ad9081_dac_nco_hop_t *hops,
+	uint16_t num_hops);
+
+/**
+ * @brief  Precompute a NCO Hop Table Entry From Its Tuning Words
+ *         No SPI access.
+ *
+ * @param  device      Pointer to the device structure
+ * @param  table       Hop table
+ * @param  index       Entry index
+ * @param  ftw         48bit frequency tuning word
+ * @param  acc_modulus 48bit accumulator modulus, 0 for an integer entry
+ * @param  acc_delta   48bit accumulator delta
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_dac_duc_nco_hop_table_ftw_set(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint16_t index, uint64_t ftw, uint64_t acc_modulus, uint64_t acc_delta);
+
+/**
+ * @brief  Precompute a NCO Hop Table Entry From a Shift Frequency
+ *         Same tuning word as adi_ad9081_dac_duc_nco_set(), no SPI access.
+ *
+ * @param  device       Pointer to the device structure
+ * @param  table        Hop table
+ * @param  index        Entry index
+ * @param  nco_shift_hz NCO shift freq in Hz
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_dac_duc_nco_hop_table_set(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint16_t index, int64_t nco_shift_hz);
+
+/**
+ * @brief  Hop the Table NCOs to a Precomputed Entry
+ *         Page select, one or two burst writes and the load request, all
+ *         NCOs of the table are written at once.
+ *
+ * @param  device Pointer to the device structure
+ * @param  table  Hop table
+ * @param  index  Entry index
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_dac_duc_nco_hop(adi_ad9081_device_t *device,
+				   adi_ad9081_dac_nco_hop_table_t *table,
+				   uint16_t index);
+
 /**
  * @brief  Configure Main NCO's FFH FTW
  *         Call after adi_ad9081_device_startup_tx().
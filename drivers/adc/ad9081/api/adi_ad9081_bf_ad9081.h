@@ -1558,6 +1558,9 @@
 #define BF_DDSM_FTW_LOAD_SYSREF_INFO 0x00000102
 #define BF_DDSM_FTW_LOAD_SYSREF(val) ((val & 0x00000001) << 0x00000002)
 #define BF_DDSM_FTW_LOAD_SYSREF_GET(val) ((val >> 0x00000002) & 0x00000001)
+#define BF_DDSM_FTW_UPDATE_MODE_INFO 0x00000304
+#define BF_DDSM_FTW_UPDATE_MODE(val) ((val & 0x00000007) << 0x00000004)
+#define BF_DDSM_FTW_UPDATE_MODE_GET(val) ((val >> 0x00000004) & 0x00000007)
 
 #define REG_DDSM_FTW0_ADDR 0x000001CB
 #define BF_DDSM_FTW_INFO 0x00003000
@@ -428,8 +428,8 @@ int32_t adi_ad9081_dac_duc_nco_ftw_set(adi_ad9081_device_t *device,
 			AD9081_ERROR_RETURN(err);
 			err = adi_ad9081_hal_2bf_set(
 				device, REG_DDSM_FTW_UPDATE_ADDR,
-				BF_DDSM_FTW_LOAD_SYSREF_INFO, 0, 0x00000304,
-				0); /* paged */
+				BF_DDSM_FTW_LOAD_SYSREF_INFO, 0,
+				BF_DDSM_FTW_UPDATE_MODE_INFO, 0); /* paged */
 			AD9081_ERROR_RETURN(err);
 			err = adi_ad9081_hal_bf_set(
 				device, REG_DDSM_DATAPATH_CFG_ADDR,
@@ -668,6 +668,182 @@ int32_t adi_ad9081_dac_duc_nco_set_f(adi_ad9081_device_t *device, uint8_t dacs,
 }
 #endif
 
+int32_t adi_ad9081_dac_duc_nco_hop_table_init(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint8_t dacs, uint8_t channels, adi_ad9081_dac_nco_hop_t *hops,
+	uint16_t num_hops)
+{
+	int32_t err;
+	uint32_t page_reg, cfg_reg, nco_en_info;
+	uint8_t page, cfg, upd, main_interp = 1;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(table);
+	AD9081_NULL_POINTER_RETURN(hops);
+	AD9081_LOG_FUNC();
+	AD9081_INVALID_PARAM_RETURN(dacs > AD9081_DAC_ALL);
+	AD9081_INVALID_PARAM_RETURN((dacs == AD9081_DAC_NONE) ==
+				    (channels == AD9081_DAC_CH_NONE));
+	AD9081_INVALID_PARAM_RETURN(num_hops == 0);
+	AD9081_INVALID_PARAM_RETURN(device->dev_info.dac_freq_hz == 0);
+
+	/* hops are burst writes, they rely on ascending address increment */
+	if ((device->hal_info.msb != SPI_MSB_FIRST) ||
+	    (device->hal_info.addr_inc != SPI_ADDR_INC_AUTO))
+		return API_CMS_ERROR_NOT_SUPPORTED;
+
+	if (dacs != AD9081_DAC_NONE) {
+		page_reg = REG_PAGEINDX_DAC_MAINDP_DAC_ADDR;
+		page = dacs;
+		cfg_reg = REG_DDSM_DATAPATH_CFG_ADDR;
+		nco_en_info = BF_DDSM_NCO_EN_INFO;
+	} else {
+		err = adi_ad9081_hal_bf_get(device, REG_INTRP_MODE_ADDR,
+					    BF_DP_INTERP_MODE_INFO,
+					    &main_interp, 1);
+		AD9081_ERROR_RETURN(err);
+		AD9081_INVALID_PARAM_RETURN(main_interp == 0);
+		page_reg = REG_PAGEINDX_DAC_CHAN_ADDR;
+		page = channels;
+		cfg_reg = REG_DDSC_DATAPATH_CFG_ADDR;
+		nco_en_info = BF_DDSC_NCO_EN_INFO;
+	}
+
+	/* all the NCOs of the page mask are written at once */
+	err = adi_ad9081_hal_reg_set(device, page_reg, page); /* not paged */
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_bf_set(device, cfg_reg, nco_en_info, 1); /* paged */
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_reg_get(device, cfg_reg, &cfg); /* paged */
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_reg_get(device, cfg_reg + 1, &upd); /* paged */
+	AD9081_ERROR_RETURN(err);
+
+	table->hops = hops;
+	table->num_hops = num_hops;
+	table->dacs = dacs;
+	table->channels = channels;
+	table->main_interp = main_interp;
+	/* modulus enable and load request are set per hop, same as ftw_set */
+	table->cfg = cfg & ~BF_DDSM_MODULUS_EN(1);
+	upd &= ~(BF_DDSM_FTW_LOAD_REQ(1) | BF_DDSM_FTW_LOAD_SYSREF(1) |
+		 BF_DDSM_FTW_UPDATE_MODE(7));
+	table->page_frame[0] = (page_reg >> 8) & 0x3F;
+	table->page_frame[1] = (page_reg >> 0) & 0xFF;
+	table->page_frame[2] = page;
+	table->load_frame[0] = ((cfg_reg + 1) >> 8) & 0x3F;
+	table->load_frame[1] = ((cfg_reg + 1) >> 0) & 0xFF;
+	table->load_frame[2] = upd | BF_DDSM_FTW_LOAD_REQ(1);
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_dac_duc_nco_hop_table_ftw_set(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint16_t index, uint64_t ftw, uint64_t acc_modulus, uint64_t acc_delta)
+{
+	adi_ad9081_dac_nco_hop_t *hop;
+	uint32_t cfg_reg, acc_reg;
+	uint8_t i;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(table);
+	AD9081_NULL_POINTER_RETURN(table->hops);
+	AD9081_INVALID_PARAM_RETURN(index >= table->num_hops);
+	AD9081_INVALID_PARAM_RETURN((ftw >> 48) > 0);
+	AD9081_INVALID_PARAM_RETURN((acc_modulus >> 48) > 0);
+	AD9081_INVALID_PARAM_RETURN((acc_delta >> 48) > 0);
+
+	if (table->dacs != AD9081_DAC_NONE) {
+		cfg_reg = REG_DDSM_DATAPATH_CFG_ADDR;
+		acc_reg = REG_DDSM_ACC_MODULUS0_ADDR;
+	} else {
+		cfg_reg = REG_DDSC_DATAPATH_CFG_ADDR;
+		acc_reg = REG_DDSC_ACC_MODULUS0_ADDR;
+	}
+
+	/* DATAPATH_CFG, FTW_UPDATE and FTW0..5 are consecutive registers */
+	hop = &table->hops[index];
+	hop->ftw_frame[0] = (cfg_reg >> 8) & 0x3F;
+	hop->ftw_frame[1] = (cfg_reg >> 0) & 0xFF;
+	hop->ftw_frame[2] = table->cfg |
+			    BF_DDSM_MODULUS_EN(acc_modulus > 0 ? 1 : 0);
+	hop->ftw_frame[3] = table->load_frame[2] & ~BF_DDSM_FTW_LOAD_REQ(1);
+	for (i = 0; i < 6; i++)
+		hop->ftw_frame[4 + i] = (uint8_t)((ftw >> (8 * i)) & 0xFF);
+
+	/* ACC_MODULUS0..5 and ACC_DELTA0..5 are consecutive registers */
+	hop->acc_en = (acc_modulus > 0) ? 1 : 0;
+	hop->acc_frame[0] = (acc_reg >> 8) & 0x3F;
+	hop->acc_frame[1] = (acc_reg >> 0) & 0xFF;
+	for (i = 0; i < 6; i++) {
+		hop->acc_frame[2 + i] =
+			(uint8_t)((acc_modulus >> (8 * i)) & 0xFF);
+		hop->acc_frame[8 + i] =
+			(uint8_t)((acc_delta >> (8 * i)) & 0xFF);
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_dac_duc_nco_hop_table_set(
+	adi_ad9081_device_t *device, adi_ad9081_dac_nco_hop_table_t *table,
+	uint16_t index, int64_t nco_shift_hz)
+{
+	int32_t err;
+	uint64_t ftw;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(table);
+
+	err = adi_ad9081_hal_calc_tx_nco_ftw(device,
+					     device->dev_info.dac_freq_hz,
+					     nco_shift_hz * table->main_interp,
+					     &ftw);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_dac_duc_nco_hop_table_ftw_set(device, table, index,
+						       ftw, 0, 0);
+	AD9081_ERROR_RETURN(err);
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_dac_duc_nco_hop(adi_ad9081_device_t *device,
+				   adi_ad9081_dac_nco_hop_table_t *table,
+				   uint16_t index)
+{
+	adi_ad9081_dac_nco_hop_t *hop;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
+	AD9081_NULL_POINTER_RETURN(table);
+	AD9081_NULL_POINTER_RETURN(table->hops);
+	AD9081_INVALID_PARAM_RETURN(index >= table->num_hops);
+
+	hop = &table->hops[index];
+	if (API_CMS_ERROR_OK !=
+	    device->hal_info.spi_xfer(device->hal_info.user_data,
+				      table->page_frame, NULL,
+				      sizeof(table->page_frame)))
+		return API_CMS_ERROR_SPI_XFER;
+	if (API_CMS_ERROR_OK !=
+	    device->hal_info.spi_xfer(device->hal_info.user_data,
+				      hop->ftw_frame, NULL,
+				      sizeof(hop->ftw_frame)))
+		return API_CMS_ERROR_SPI_XFER;
+	if (hop->acc_en > 0) {
+		if (API_CMS_ERROR_OK !=
+		    device->hal_info.spi_xfer(device->hal_info.user_data,
+					      hop->acc_frame, NULL,
+					      sizeof(hop->acc_frame)))
+			return API_CMS_ERROR_SPI_XFER;
+	}
+	/* load request rising edge, the FTW burst cleared it */
+	if (API_CMS_ERROR_OK !=
+	    device->hal_info.spi_xfer(device->hal_info.user_data,
+				      table->load_frame, NULL,
+				      sizeof(table->load_frame)))
+		return API_CMS_ERROR_SPI_XFER;
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_dac_duc_main_nco_hopf_ftw_set(adi_ad9081_device_t *device,
 						 uint8_t dacs,
 						 uint8_t hopf_index,
@@ -615,6 +615,81 @@ int32_t adi_ad9081_hal_error_report(adi_ad9081_device_t *device,
 	return API_CMS_ERROR_OK;
 }
 
+/*
+ * 128-bit arithmetic used by the NCO frequency tuning word calculations.
+ * Compilers that provide a native 128-bit integer (64-bit targets) use it,
+ * 32-bit targets use a normalized long division on 32-bit digits instead of
+ * a bit-serial one. Divisions by the same DAC/ADC clock go through a cached
+ * reciprocal, which turns each of them into a multiply and two corrections.
+ */
+#if defined(__SIZEOF_INT128__) && !defined(AD9081_HAL_NO_INT128)
+#define AD9081_HAL_INT128 1
+__extension__ typedef unsigned __int128 adi_ad9081_hal_u128_t;
+#endif
+
+#define AD9081_HAL_RECIP_CACHE_SIZE 4
+
+static adi_ad9081_hal_recip_t
+	adi_ad9081_hal_recip_cache[AD9081_HAL_RECIP_CACHE_SIZE];
+static uint8_t adi_ad9081_hal_recip_next;
+
+static uint8_t adi_ad9081_hal_clz_64(uint64_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_clzll(x);
+#else
+	uint8_t n = 0;
+
+	while (!(x & 0x8000000000000000ull)) {
+		x <<= 1;
+		n++;
+	}
+
+	return n;
+#endif
+}
+
+/* (u1:u0) / v, with u1 < v, see Hacker's Delight, divlu */
+static uint64_t adi_ad9081_hal_divlu_64(uint64_t u1, uint64_t u0, uint64_t v,
+					uint64_t *r)
+{
+	const uint64_t b = 0x100000000ull;
+	uint64_t un1, un0, vn1, vn0, q1, q0, un32, un21, un10, rhat;
+	uint8_t s = adi_ad9081_hal_clz_64(v);
+
+	v <<= s;
+	vn1 = v >> 32;
+	vn0 = v & 0xffffffff;
+	un32 = s ? (u1 << s) | (u0 >> (64 - s)) : u1;
+	un10 = u0 << s;
+	un1 = un10 >> 32;
+	un0 = un10 & 0xffffffff;
+
+	q1 = un32 / vn1;
+	rhat = un32 - q1 * vn1;
+	while ((q1 >= b) || (q1 * vn0 > b * rhat + un1)) {
+		q1--;
+		rhat += vn1;
+		if (rhat >= b)
+			break;
+	}
+
+	un21 = un32 * b + un1 - q1 * v;
+	q0 = un21 / vn1;
+	rhat = un21 - q0 * vn1;
+	while ((q0 >= b) || (q0 * vn0 > b * rhat + un0)) {
+		q0--;
+		rhat += vn1;
+		if (rhat >= b)
+			break;
+	}
+
+	if (r != NULL)
+		*r = (un21 * b + un0 - q0 * v) >> s;
+
+	return q1 * b + q0;
+}
+
 void adi_ad9081_hal_add_128(uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
 			    uint64_t *hi, uint64_t *lo)
 {
@@ -644,6 +719,12 @@ void adi_ad9081_hal_sub_128(uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
 
 void adi_ad9081_hal_mult_128(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
 {
+#ifdef AD9081_HAL_INT128
+	adi_ad9081_hal_u128_t r = (adi_ad9081_hal_u128_t)a * b;
+
+	*lo = (uint64_t)r;
+	*hi = (uint64_t)(r >> 64);
+#else
 	uint64_t ah = a >> 32, al = a & 0xffffffff, bh = b >> 32,
 		 bl = b & 0xffffffff, rh = ah * bh, rl = al * bl, rm1 = ah * bl,
 		 rm2 = al * bh, rm1h = rm1 >> 32, rm2h = rm2 >> 32,
@@ -654,6 +735,7 @@ void adi_ad9081_hal_mult_128(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
 	rh = rh + rmh + c;
 	*lo = rl;
 	*hi = rh;
+#endif
 }
 
 void adi_ad9081_hal_lshift_128(uint64_t *hi, uint64_t *lo)
@@ -672,63 +754,164 @@ void adi_ad9081_hal_rshift_128(uint64_t *hi, uint64_t *lo)
 	*hi >>= 1;
 }
 
+/* Division by zero returns 0 */
 void adi_ad9081_hal_div_128(uint64_t a_hi, uint64_t a_lo, uint64_t b_hi,
 			    uint64_t b_lo, uint64_t *hi, uint64_t *lo)
 {
-	uint64_t remain_lo = a_lo, remain_hi = a_hi, part1_lo = b_lo,
-		 part1_hi = b_hi;
-	uint64_t result_lo = 0, result_hi = 0, mask_lo = 1, mask_hi = 0;
-
-	while (!(part1_hi & 0x8000000000000000ull)) {
-		adi_ad9081_hal_lshift_128(&part1_hi, &part1_lo);
-		adi_ad9081_hal_lshift_128(&mask_hi, &mask_lo);
+#ifdef AD9081_HAL_INT128
+	adi_ad9081_hal_u128_t a = ((adi_ad9081_hal_u128_t)a_hi << 64) | a_lo;
+	adi_ad9081_hal_u128_t b = ((adi_ad9081_hal_u128_t)b_hi << 64) | b_lo;
+	adi_ad9081_hal_u128_t r = b ? a / b : 0;
+
+	*lo = (uint64_t)r;
+	*hi = (uint64_t)(r >> 64);
+#else
+	uint64_t part1_hi, part1_lo, result_lo = 0;
+	uint8_t shift;
+
+	if (b_hi == 0) {
+		if (b_lo == 0) {
+			*hi = 0;
+			*lo = 0;
+			return;
+		}
+		*hi = a_hi / b_lo;
+		*lo = adi_ad9081_hal_divlu_64(a_hi % b_lo, a_lo, b_lo, NULL);
+		return;
 	}
 
+	/* Quotient fits in 64 bits, only walk the bits it can have */
+	*hi = 0;
+	if ((a_hi < b_hi) || ((a_hi == b_hi) && (a_lo < b_lo))) {
+		*lo = 0;
+		return;
+	}
+	shift = adi_ad9081_hal_clz_64(b_hi) - adi_ad9081_hal_clz_64(a_hi);
+	part1_hi = shift ? (b_hi << shift) | (b_lo >> (64 - shift)) : b_hi;
+	part1_lo = b_lo << shift;
 	do {
-		if ((remain_hi > part1_hi) ||
-		    ((remain_hi == part1_hi) && (remain_lo >= part1_lo))) {
-			adi_ad9081_hal_sub_128(remain_hi, remain_lo, part1_hi,
-					       part1_lo, &remain_hi,
-					       &remain_lo);
-			adi_ad9081_hal_add_128(result_hi, result_lo, mask_hi,
-					       mask_lo, &result_hi, &result_lo);
+		result_lo <<= 1;
+		if ((a_hi > part1_hi) ||
+		    ((a_hi == part1_hi) && (a_lo >= part1_lo))) {
+			adi_ad9081_hal_sub_128(a_hi, a_lo, part1_hi, part1_lo,
+					       &a_hi, &a_lo);
+			result_lo |= 1;
 		}
 		adi_ad9081_hal_rshift_128(&part1_hi, &part1_lo);
-		adi_ad9081_hal_rshift_128(&mask_hi, &mask_lo);
-	} while ((mask_hi != 0) || (mask_lo != 0));
+	} while (shift--);
 	*lo = result_lo;
-	*hi = result_hi;
+#endif
+}
+
+void adi_ad9081_hal_recip_init(adi_ad9081_hal_recip_t *recip, uint64_t d)
+{
+	recip->d = d;
+	if (d == 0) {
+		recip->shift = 0;
+		recip->dn = 0;
+		recip->v = 0;
+		return;
+	}
+	recip->shift = adi_ad9081_hal_clz_64(d);
+	recip->dn = d << recip->shift;
+	/* v = floor((2^128 - 1) / dn) - 2^64 */
+	recip->v = adi_ad9081_hal_divlu_64(~recip->dn, ~0ull, recip->dn, NULL);
+}
+
+/*
+ * Division by a precomputed reciprocal, see N. Moller, T. Granlund,
+ * "Improved division by invariant integers". Division by zero returns 0.
+ */
+void adi_ad9081_hal_div_128_recip(const adi_ad9081_hal_recip_t *recip,
+				  uint64_t a_hi, uint64_t a_lo, uint64_t *hi,
+				  uint64_t *lo, uint64_t *rem)
+{
+	uint64_t u1, u0, q1, q0, r;
+	uint8_t s = recip->shift;
+
+	if (recip->d == 0) {
+		*hi = 0;
+		*lo = 0;
+		if (rem != NULL)
+			*rem = 0;
+		return;
+	}
+
+	*hi = 0;
+	if (a_hi >= recip->d) {
+		*hi = a_hi / recip->d;
+		a_hi %= recip->d;
+	}
+
+	u1 = s ? (a_hi << s) | (a_lo >> (64 - s)) : a_hi;
+	u0 = a_lo << s;
+
+	adi_ad9081_hal_mult_128(recip->v, u1, &q1, &q0);
+	adi_ad9081_hal_add_128(q1, q0, u1, u0, &q1, &q0);
+	q1++;
+	r = u0 - q1 * recip->dn;
+	if (r > q0) {
+		q1--;
+		r += recip->dn;
+	}
+	if (r >= recip->dn) {
+		q1++;
+		r -= recip->dn;
+	}
+
+	*lo = q1;
+	if (rem != NULL)
+		*rem = r >> s;
+}
+
+/* Reciprocal of a converter clock, computed once per clock rate */
+static const adi_ad9081_hal_recip_t *
+adi_ad9081_hal_recip_get(uint64_t freq)
+{
+	adi_ad9081_hal_recip_t *recip;
+	uint8_t i;
+
+	for (i = 0; i < AD9081_HAL_RECIP_CACHE_SIZE; i++) {
+		if ((adi_ad9081_hal_recip_cache[i].d == freq) && (freq != 0))
+			return &adi_ad9081_hal_recip_cache[i];
+	}
+
+	recip = &adi_ad9081_hal_recip_cache[adi_ad9081_hal_recip_next];
+	adi_ad9081_hal_recip_next = (adi_ad9081_hal_recip_next + 1) %
+				    AD9081_HAL_RECIP_CACHE_SIZE;
+	adi_ad9081_hal_recip_init(recip, freq);
+
+	return recip;
 }
 
 int32_t adi_ad9081_hal_calc_nco_ftw(adi_ad9081_device_t *device, uint64_t freq,
 				    int64_t nco_shift, uint64_t *ftw,
 				    uint64_t *a, uint64_t *b)
 {
-	uint64_t hi, lo, hi1, hi2, lo2, hi3, lo3, hi4, lo4;
+	const adi_ad9081_hal_recip_t *recip;
+	uint64_t hi, lo, rem;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_LOG_FUNC();
 	AD9081_INVALID_PARAM_RETURN(freq == 0);
 
+	recip = adi_ad9081_hal_recip_get(freq);
+
 	/* ftw + a/b   nco_shift */
 	/* --------- = --------- */
 	/*    2^48        freq   */
 	if (nco_shift >= 0) {
 		adi_ad9081_hal_mult_128(281474976710656ull, nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, freq, &hi1, ftw);
-		adi_ad9081_hal_mult_128(*ftw, freq, &hi2, &lo2);
-		adi_ad9081_hal_sub_128(hi, lo, hi2, lo2, &hi3, &lo3);
-		adi_ad9081_hal_mult_128(lo3, 281474976710655ull, &hi4, &lo4);
-		adi_ad9081_hal_div_128(hi4, lo4, 0, freq, &hi1, a);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, &rem);
+		adi_ad9081_hal_mult_128(rem, 281474976710655ull, &hi, &lo);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, a, NULL);
 		*b = 281474976710655ull;
 	} else {
 		adi_ad9081_hal_mult_128(281474976710656ull, -nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, freq, &hi, ftw);
-		adi_ad9081_hal_mult_128(*ftw, freq, &hi2, &lo2);
-		adi_ad9081_hal_sub_128(hi, lo, hi2, lo2, &hi3, &lo3);
-		adi_ad9081_hal_mult_128(lo3, 281474976710655ull, &hi4, &lo4);
-		adi_ad9081_hal_div_128(hi4, lo4, 0, freq, &hi1, a);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, &rem);
+		adi_ad9081_hal_mult_128(rem, 281474976710655ull, &hi, &lo);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, a, NULL);
 		*b = 281474976710655ull;
 		*a = (*a > 0) ?
 			     (281474976710656ull - *a) :
@@ -778,19 +961,22 @@ int32_t adi_ad9081_hal_calc_rx_nco_ftw(adi_ad9081_device_t *device,
 				       uint64_t adc_freq, int64_t nco_shift,
 				       uint64_t *ftw)
 {
+	const adi_ad9081_hal_recip_t *recip;
 	uint64_t hi, lo;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_LOG_FUNC();
 	AD9081_INVALID_PARAM_RETURN(adc_freq == 0);
 
+	recip = adi_ad9081_hal_recip_get(adc_freq);
+
 	if (nco_shift >= 0) {
 		adi_ad9081_hal_mult_128(281474976710656ull, nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, adc_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 	} else {
 		adi_ad9081_hal_mult_128(281474976710656ull, -nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, adc_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 		*ftw = 281474976710656ull - *ftw;
 	}
 
@@ -801,17 +987,20 @@ int32_t adi_ad9081_hal_calc_rx_nco_ftw32(adi_ad9081_device_t *device,
 					 uint64_t adc_freq, int64_t nco_shift,
 					 uint64_t *ftw)
 {
+	const adi_ad9081_hal_recip_t *recip;
 	uint64_t hi, lo;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_LOG_FUNC();
 	AD9081_INVALID_PARAM_RETURN(adc_freq == 0);
 
+	recip = adi_ad9081_hal_recip_get(adc_freq);
+
 	if (nco_shift >= 0) {
 		adi_ad9081_hal_mult_128(4294967296ull, nco_shift, &hi, &lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, adc_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 	} else {
 		adi_ad9081_hal_mult_128(4294967296ull, -nco_shift, &hi, &lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, adc_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 		*ftw = 4294967296ull - *ftw;
 	}
 
@@ -822,19 +1011,22 @@ int32_t adi_ad9081_hal_calc_tx_nco_ftw(adi_ad9081_device_t *device,
 				       uint64_t dac_freq, int64_t nco_shift,
 				       uint64_t *ftw)
 {
+	const adi_ad9081_hal_recip_t *recip;
 	uint64_t hi, lo;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_LOG_FUNC();
 	AD9081_INVALID_PARAM_RETURN(dac_freq == 0);
 
+	recip = adi_ad9081_hal_recip_get(dac_freq);
+
 	if (nco_shift >= 0) {
 		adi_ad9081_hal_mult_128(281474976710656ull, nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, dac_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 	} else {
 		adi_ad9081_hal_mult_128(281474976710656ull, -nco_shift, &hi,
 					&lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, dac_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 		*ftw = 281474976710656ull - *ftw;
 	}
 
@@ -845,17 +1037,20 @@ int32_t adi_ad9081_hal_calc_tx_nco_ftw32(adi_ad9081_device_t *device,
 					 uint64_t dac_freq, int64_t nco_shift,
 					 uint64_t *ftw)
 {
+	const adi_ad9081_hal_recip_t *recip;
 	uint64_t hi, lo;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_LOG_FUNC();
 	AD9081_INVALID_PARAM_RETURN(dac_freq == 0);
 
+	recip = adi_ad9081_hal_recip_get(dac_freq);
+
 	if (nco_shift >= 0) {
 		adi_ad9081_hal_mult_128(4294967296ull, nco_shift, &hi, &lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, dac_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 	} else {
 		adi_ad9081_hal_mult_128(4294967296ull, -nco_shift, &hi, &lo);
-		adi_ad9081_hal_div_128(hi, lo, 0, dac_freq, &hi, ftw);
+		adi_ad9081_hal_div_128_recip(recip, hi, lo, &hi, ftw, NULL);
 		*ftw = 4294967296ull - *ftw;
 	}
 
@@ -20,6 +20,18 @@
 #include <linux/math64.h>
 #endif
 
+/*============= D A T A ====================*/
+/*!
+ * @brief Precomputed reciprocal of a 64-bit divisor, for repeated divisions
+ *        by the same DAC/ADC clock
+ */
+typedef struct {
+	uint64_t d; /*!< Divisor */
+	uint64_t dn; /*!< Divisor shifted left until its MSB is set */
+	uint64_t v; /*!< floor((2^128 - 1) / dn) - 2^64 */
+	uint8_t shift; /*!< Normalization shift */
+} adi_ad9081_hal_recip_t;
+
 /*============= E X P O R T S ==============*/
 #ifdef __cplusplus
 extern "C" {
@@ -156,6 +168,21 @@ int32_t adi_ad9081_hal_error_report(adi_ad9081_device_t *device,
 				    const char *func_name, uint32_t line_num,
 				    const char *var_name, const char *comment);
 
+void adi_ad9081_hal_add_128(uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
+			    uint64_t *hi, uint64_t *lo);
+void adi_ad9081_hal_sub_128(uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
+			    uint64_t *hi, uint64_t *lo);
+void adi_ad9081_hal_mult_128(uint64_t a, uint64_t b, uint64_t *hi,
+			     uint64_t *lo);
+void adi_ad9081_hal_lshift_128(uint64_t *hi, uint64_t *lo);
+void adi_ad9081_hal_rshift_128(uint64_t *hi, uint64_t *lo);
+void adi_ad9081_hal_div_128(uint64_t a_hi, uint64_t a_lo, uint64_t b_hi,
+			    uint64_t b_lo, uint64_t *hi, uint64_t *lo);
+void adi_ad9081_hal_recip_init(adi_ad9081_hal_recip_t *recip, uint64_t d);
+void adi_ad9081_hal_div_128_recip(const adi_ad9081_hal_recip_t *recip,
+				  uint64_t a_hi, uint64_t a_lo, uint64_t *hi,
+				  uint64_t *lo, uint64_t *rem);
+
 int32_t adi_ad9081_hal_calc_nco_ftw(adi_ad9081_device_t *device, uint64_t freq,
 				    int64_t nco_shift, uint64_t *ftw,
 				    uint64_t *a, uint64_t *b);
@@ -40,6 +40,7 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <inttypes.h>
@@ -182,86 +183,254 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 }
 
 /***************************************************************************//**
- * @brief axi_adc_delay_calibrate
+ * @brief axi_adc_delay_pn_check
+ *
+ * Short PN check of all the channels at once, used while searching the
+ * delay window. Returns as soon as one of the channels reports an error.
 *******************************************************************************/
-int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
-				uint32_t no_of_lanes,
-				enum axi_adc_pn_sel sel)
+static bool axi_adc_delay_pn_check(struct axi_adc *adc,
+				   uint32_t no_of_lanes,
+				   uint32_t delay)
 {
-	uint8_t err_field[32] = {0};
-	uint16_t valid_range[5] = {0};
-	uint16_t invalid_range[5] = {0};
-	uint16_t delay = 0;
-	uint16_t start_valid_delay = 32;
-	uint16_t start_invalid_delay = 32;
-	uint8_t interval = 0;
-	uint8_t max_interval = 0;
-	uint8_t max_valid_range = 0;
-	uint8_t cnt_valid[5] = {0};
-	uint8_t cnt_invalid = 0;
-	uint8_t val = 0;
-	uint8_t max_val = 32;
-
-	for (delay = 0; delay < 32; delay++) {
-		axi_adc_delay_set(adc, no_of_lanes, delay);
-		mdelay(20);
-		if (axi_adc_pn_mon(adc, sel, 100) == 0) {
-			err_field[delay] = 0;
-			start_valid_delay = start_valid_delay == 32 ?
-					    delay : start_valid_delay;
-		} else {
-			err_field[delay] = 1;
+	uint32_t reg_data;
+	uint32_t i;
+	uint8_t ch;
+
+	for (i = 0; i < no_of_lanes; i++)
+		axi_adc_idelay_set(adc, i, delay);
+	mdelay(AXI_ADC_DELAY_SETTLE_MS);
+
+	for (ch = 0; ch < adc->num_channels; ch++)
+		axi_adc_write(adc, AXI_ADC_REG_CHAN_STATUS(ch), 0xff);
+
+	for (i = 0; i < AXI_ADC_DELAY_DWELL_MS; i++) {
+		mdelay(1);
+		for (ch = 0; ch < adc->num_channels; ch++) {
+			axi_adc_read(adc, AXI_ADC_REG_CHAN_STATUS(ch), &reg_data);
+			if (reg_data != 0)
+				return false;
 		}
 	}
-	if (start_valid_delay > 31) {
-		printf("%s FAILED.\n", __func__);
-		axi_adc_delay_set(adc, no_of_lanes, 0);
-		return FAILURE;
+
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_edge
+ *
+ * Binary search of the window edge between a passing and a failing tap,
+ * which are at most AXI_ADC_DELAY_COARSE_STEP taps apart. Returns the last
+ * passing tap on the way from pass to fail.
+*******************************************************************************/
+static int32_t axi_adc_delay_edge(struct axi_adc *adc,
+				  uint32_t no_of_lanes,
+				  int32_t pass,
+				  int32_t fail)
+{
+	int32_t mid;
+
+	while (abs(fail - pass) > 1) {
+		mid = (pass + fail) / 2;
+		if (axi_adc_delay_pn_check(adc, no_of_lanes, mid))
+			pass = mid;
+		else
+			fail = mid;
 	}
 
-	start_valid_delay = 32;
-	start_invalid_delay = 32;
-	for (val = 0; val < max_val; val++) {
-		if (err_field[val] == 0) {
-			if (start_valid_delay == 32) {
-				start_valid_delay = val;
-			}
-			if (start_valid_delay != 32 && start_invalid_delay != 32 ) {
-				start_valid_delay = 32;
-				start_invalid_delay = 32;
-			}
-			cnt_valid[interval]++;
+	return pass;
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_window
+ *
+ * Find the widest window of consecutive passing taps, sampling every step
+ * taps from first. Returns the window width, 0 if no tap passed.
+*******************************************************************************/
+static uint32_t axi_adc_delay_window(struct axi_adc *adc,
+				     uint32_t no_of_lanes,
+				     uint32_t first,
+				     uint32_t step,
+				     int32_t *start,
+				     int32_t *end)
+{
+	int32_t run_start = -1;
+	uint32_t width = 0;
+	int32_t delay;
+
+	for (delay = first; delay < AXI_ADC_DELAY_TAPS + step; delay += step) {
+		if (delay < AXI_ADC_DELAY_TAPS &&
+		    axi_adc_delay_pn_check(adc, no_of_lanes, delay)) {
+			if (run_start < 0)
+				run_start = delay;
+			continue;
 		}
-		if((err_field[val] == 1) || (val == max_val - 1)) {
-			if (start_invalid_delay == 32) {
-				start_invalid_delay = val;
-			}
-			if (start_valid_delay != 32 && start_invalid_delay != 32 ) {
-				valid_range[interval] = start_valid_delay;
-				invalid_range[interval] = start_invalid_delay;
-				start_valid_delay = 32;
-				start_invalid_delay = 32;
-				interval++;
-			}
-			cnt_invalid++;
+		if (run_start >= 0 && (uint32_t)(delay - run_start) > width) {
+			width = delay - run_start;
+			*start = run_start;
+			*end = delay - step;
 		}
+		run_start = -1;
 	}
 
-	for (val = 0; val < 5; val++) {
-		if (cnt_valid[val] > max_valid_range) {
-			max_valid_range = cnt_valid[val];
-			max_interval = val;
-		}
+	return width;
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_search
+ *
+ * Coarse-to-fine search of the eye: a sweep of every
+ * AXI_ADC_DELAY_COARSE_STEP taps locates the widest valid window, then its
+ * edges are refined with a binary search.
+*******************************************************************************/
+static int32_t axi_adc_delay_search(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    struct axi_adc_delay_cal *cal)
+{
+	int32_t start, end;
+
+	if (!axi_adc_delay_window(adc, no_of_lanes, 0,
+				  AXI_ADC_DELAY_COARSE_STEP, &start, &end))
+		return FAILURE;
+
+	if (start > 0)
+		start = axi_adc_delay_edge(adc, no_of_lanes, start,
+					   start - AXI_ADC_DELAY_COARSE_STEP);
+	end = axi_adc_delay_edge(adc, no_of_lanes, end,
+				 min(end + AXI_ADC_DELAY_COARSE_STEP,
+				     AXI_ADC_DELAY_TAPS));
+
+	cal->delay = (start + end) / 2;
+	cal->width = end - start + 1;
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_verify
+ *
+ * Apply a delay to all the lanes and run the full length PN check on it.
+*******************************************************************************/
+static int32_t axi_adc_delay_verify(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    enum axi_adc_pn_sel sel,
+				    uint32_t delay)
+{
+	int32_t ret;
+
+	ret = axi_adc_delay_set(adc, no_of_lanes, delay);
+	if (ret != SUCCESS)
+		return ret;
+	mdelay(AXI_ADC_DELAY_SETTLE_MS);
+
+	return axi_adc_pn_mon(adc, sel, 100);
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_calibrate_cal
+ *
+ * Calibrate the interface delay of all the lanes and return the eye found.
+ * The result is only kept once the eye center passes the full PN check,
+ * otherwise (no window or one narrower than the coarse step) all the taps
+ * are swept.
+*******************************************************************************/
+int32_t axi_adc_delay_calibrate_cal(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    enum axi_adc_pn_sel sel,
+				    struct axi_adc_delay_cal *cal)
+{
+	struct axi_adc_delay_cal found;
+	int32_t start, end;
+	int32_t ret;
+
+	/* Checks the pcore version, enables the PN monitors of all channels */
+	ret = axi_adc_delay_set(adc, no_of_lanes, 0);
+	if (ret != SUCCESS)
+		return ret;
+	axi_adc_pn_mon(adc, sel, 0);
+
+	ret = axi_adc_delay_search(adc, no_of_lanes, &found);
+	if (ret == SUCCESS)
+		ret = axi_adc_delay_verify(adc, no_of_lanes, sel, found.delay);
+
+	if (ret != SUCCESS &&
+	    axi_adc_delay_window(adc, no_of_lanes, 0, 1, &start, &end)) {
+		found.delay = (start + end) / 2;
+		found.width = end - start + 1;
+		ret = axi_adc_delay_verify(adc, no_of_lanes, sel, found.delay);
 	}
 
-	delay = (valid_range[max_interval] + invalid_range[max_interval] - 1) / 2;
+	if (ret != SUCCESS) {
+		printf("%s FAILED.\n", __func__);
+		axi_adc_delay_set(adc, no_of_lanes, 0);
+		return FAILURE;
+	}
 
-	printf("adc_delay: setting zero error delay (%d)\n\r", delay);
-	axi_adc_delay_set(adc, no_of_lanes, delay);
+	printf("adc_delay: setting zero error delay (%d)\n\r", found.delay);
+	cal->delay = found.delay;
+	cal->width = found.width;
 
 	return SUCCESS;
 }
 
+/***************************************************************************//**
+ * @brief axi_adc_delay_calibrate
+*******************************************************************************/
+int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
+				uint32_t no_of_lanes,
+				enum axi_adc_pn_sel sel)
+{
+	struct axi_adc_delay_cal cal;
+
+	return axi_adc_delay_calibrate_cal(adc, no_of_lanes, sel, &cal);
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_restore
+ *
+ * Warm start of the interface delay calibration. The record of a previous
+ * calibration (e.g. kept in EEPROM or flash) is applied without a sweep when
+ * it was made on the same board, at a close temperature, and its delay still
+ * passes the PN check. Otherwise the delay is calibrated again and the
+ * record is updated for the caller to store it.
+ * @param adc - The ADC core.
+ * @param no_of_lanes - Number of lanes.
+ * @param sel - PN sequence sent by the converter.
+ * @param board_id - Identifier of the board (serial number, EEPROM id...).
+ * @param temp_mdeg - Current temperature, in milli degrees Celsius.
+ * @param cal - Stored record, width 0 if there is none. Updated when a new
+ *              calibration is made.
+ * @return SUCCESS if the record was reused, 1 if it was updated, FAILURE if
+ *         no delay could be found.
+*******************************************************************************/
+int32_t axi_adc_delay_restore(struct axi_adc *adc,
+			      uint32_t no_of_lanes,
+			      enum axi_adc_pn_sel sel,
+			      uint32_t board_id,
+			      int32_t temp_mdeg,
+			      struct axi_adc_delay_cal *cal)
+{
+	int32_t ret;
+
+	if (cal->width && cal->board_id == board_id &&
+	    abs(cal->temp_mdeg - temp_mdeg) <= AXI_ADC_DELAY_TEMP_TOL_MDEG &&
+	    cal->delay < AXI_ADC_DELAY_TAPS) {
+		ret = axi_adc_delay_verify(adc, no_of_lanes, sel, cal->delay);
+		if (ret == SUCCESS) {
+			printf("adc_delay: restored delay (%d)\n\r", cal->delay);
+			return SUCCESS;
+		}
+	}
+
+	ret = axi_adc_delay_calibrate_cal(adc, no_of_lanes, sel, cal);
+	if (ret != SUCCESS)
+		return ret;
+
+	cal->board_id = board_id;
+	cal->temp_mdeg = temp_mdeg;
+
+	return 1;
+}
+
 /***************************************************************************//**
  * @brief axi_adc_set_calib_phase_scale
 *******************************************************************************/
@@ -114,6 +114,13 @@
 
 #define AXI_ADC_REG_DELAY(l)		(0x0800 + (l) * 0x4)
 
+/* Interface delay calibration */
+#define AXI_ADC_DELAY_TAPS		32
+#define AXI_ADC_DELAY_COARSE_STEP	4
+#define AXI_ADC_DELAY_SETTLE_MS		2
+#define AXI_ADC_DELAY_DWELL_MS		10
+#define AXI_ADC_DELAY_TEMP_TOL_MDEG	10000
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -131,6 +138,22 @@ struct axi_adc_init {
 	uint8_t	num_channels;
 };
 
+/**
+ * @struct axi_adc_delay_cal
+ * @brief Result of an interface delay calibration, to be stored by the
+ *        application and given back to axi_adc_delay_restore() on warm boots.
+ */
+struct axi_adc_delay_cal {
+	/** Board the calibration was made on */
+	uint32_t board_id;
+	/** Temperature during the calibration, in milli degrees Celsius */
+	int32_t temp_mdeg;
+	/** Center of the valid window, applied to all the lanes */
+	uint8_t delay;
+	/** Width of the valid window in taps, 0 for an empty record */
+	uint8_t width;
+};
+
 enum axi_adc_pn_sel {
 	AXI_ADC_PN9 = 0,
 	AXI_ADC_PN23A = 1,
@@ -174,6 +197,16 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 int32_t axi_adc_delay_calibrate(struct axi_adc *core,
 				uint32_t no_of_lanes,
 				enum axi_adc_pn_sel sel);
+int32_t axi_adc_delay_calibrate_cal(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    enum axi_adc_pn_sel sel,
+				    struct axi_adc_delay_cal *cal);
+int32_t axi_adc_delay_restore(struct axi_adc *adc,
+			      uint32_t no_of_lanes,
+			      enum axi_adc_pn_sel sel,
+			      uint32_t board_id,
+			      int32_t temp_mdeg,
+			      struct axi_adc_delay_cal *cal);
 int32_t axi_adc_set_calib_phase(struct axi_adc *adc,
 				uint32_t chan,
 				int32_t val,
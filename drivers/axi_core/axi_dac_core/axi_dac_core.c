@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 #include "error.h"
 #include "delay.h"
 #include "util.h"
@@ -106,6 +107,9 @@
 #define AXI_DAC_IQCOR_COEFF_2(x)		(((x) & 0xFFFF) << 0)
 #define AXI_DAC_TO_IQCOR_COEFF_2(x)		(((x) >> 0) & 0xFFFF)
 
+/* Slack added to the wait for the DMAC to leave a swapped out buffer */
+#define AXI_DAC_WAVEFORM_SWAP_TIMEOUT_US	100000
+
 const uint16_t sine_lut[128] = {
 	0x000, 0x064, 0x0C8, 0x12C, 0x18F, 0x1F1, 0x252, 0x2B1,
 	0x30F, 0x36B, 0x3C5, 0x41C, 0x471, 0x4C3, 0x512, 0x55F,
@@ -797,6 +801,235 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 	return SUCCESS;
 }
 
+/***************************************************************************//**
+ * @brief axi_dac_waveform_init
+ *******************************************************************************/
+int32_t axi_dac_waveform_init(struct axi_dac_waveform **waveform,
+			      const struct axi_dac_waveform_init *init)
+{
+	struct axi_dac_waveform *wf;
+	uint8_t i;
+
+	if (!init->dac || !init->dmac || !(init->dmac->flags & DMA_CYCLIC) ||
+	    init->dmac->direction != DMA_MEM_TO_DEV || !init->buff_size ||
+	    (init->buff_size - 1) > init->dmac->transfer_max_size)
+		return FAILURE;
+
+	for (i = 0; i < AXI_DAC_WAVEFORM_NUM_BUFFS; i++)
+		if (!init->buff[i])
+			return FAILURE;
+
+	wf = (struct axi_dac_waveform *)calloc(1, sizeof(*wf));
+	if (!wf)
+		return FAILURE;
+
+	wf->dac = init->dac;
+	wf->dmac = init->dmac;
+	wf->buff_size = init->buff_size;
+	wf->dcache_flush_range = init->dcache_flush_range;
+	for (i = 0; i < AXI_DAC_WAVEFORM_NUM_BUFFS; i++)
+		wf->buff[i] = init->buff[i];
+
+	*waveform = wf;
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_dac_waveform_pack
+ *
+ * Replicate each IQ word on all the TX channels, with one loop per common
+ * channel count so the compiler can keep the inner loop branch free.
+ *******************************************************************************/
+static void axi_dac_waveform_pack(uint32_t *dst, const uint32_t *src,
+				  uint32_t count, uint8_t num_tx_channels)
+{
+	uint32_t index;
+	uint8_t chan;
+
+	switch (num_tx_channels) {
+	case 1:
+		memcpy(dst, src, count * sizeof(*src));
+		break;
+	case 2:
+		for (index = 0; index < count; index++) {
+			dst[0] = src[index];
+			dst[1] = src[index];
+			dst += 2;
+		}
+		break;
+	case 4:
+		for (index = 0; index < count; index++) {
+			dst[0] = src[index];
+			dst[1] = src[index];
+			dst[2] = src[index];
+			dst[3] = src[index];
+			dst += 4;
+		}
+		break;
+	default:
+		for (index = 0; index < count; index++)
+			for (chan = 0; chan < num_tx_channels; chan++)
+				*dst++ = src[index];
+		break;
+	}
+}
+
+/***************************************************************************//**
+ * @brief axi_dac_waveform_swap_wait
+ *
+ * The cyclic DMAC increments its transfer ID each time it re-queues the
+ * transfer, latching the source address at that point. Once the ID has moved
+ * twice past the swap, the request reading the previous buffer is complete.
+ * The ID is two bits wide, so a swap more than three periods old may look
+ * recent: it only costs up to two extra periods of waiting.
+ *******************************************************************************/
+static int32_t axi_dac_waveform_swap_wait(struct axi_dac_waveform *waveform)
+{
+	uint8_t num_tx_channels;
+	uint64_t timeout_us;
+	uint32_t samples;
+	uint32_t last;
+	uint32_t id;
+	uint8_t seen;
+
+	if (!waveform->swap_pending)
+		return SUCCESS;
+
+	/* Three periods of the playing waveform, or a fixed bound if the rate is unknown */
+	num_tx_channels = max(waveform->dac->num_channels / 2, 1);
+	samples = waveform->size[waveform->active] /
+		  (num_tx_channels * sizeof(uint32_t));
+	if (waveform->dac->clock_hz)
+		timeout_us = (uint64_t)samples * 3000000 / waveform->dac->clock_hz +
+			     AXI_DAC_WAVEFORM_SWAP_TIMEOUT_US;
+	else
+		timeout_us = AXI_DAC_WAVEFORM_SWAP_TIMEOUT_US;
+
+	axi_dmac_read(waveform->dmac, AXI_DMAC_REG_TRANSFER_ID, &id);
+	seen = (id - waveform->swap_id) & 0x3;
+	last = id;
+	while (seen < 2) {
+		if (!timeout_us--)
+			return -EBUSY;
+		udelay(1);
+		axi_dmac_read(waveform->dmac, AXI_DMAC_REG_TRANSFER_ID, &id);
+		seen += (id - last) & 0x3;
+		last = id;
+	}
+
+	waveform->swap_pending = false;
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_dac_waveform_load
+ *
+ * Build the interleaved buffer for all the TX channels in the buffer the DMAC
+ * is not reading, flush it from the data cache once and play it in cyclic
+ * mode. When a waveform of the same length is already playing, only the
+ * source address of the cyclic transfer is changed. The DMAC latches it when
+ * it re-queues the transfer, so the switch happens on a waveform boundary,
+ * without stopping the DAC. A waveform of another length restarts the
+ * transfer, since the address and the length cannot be changed atomically.
+ * Before reusing the buffer of the previous swap, the call waits until the
+ * DMAC is done reading it, and returns -EBUSY if the DMAC does not progress.
+ *******************************************************************************/
+int32_t axi_dac_waveform_load(struct axi_dac_waveform *waveform,
+			      const uint32_t *data_iq,
+			      uint32_t count)
+{
+	uint8_t num_tx_channels;
+	uint32_t bytes;
+	uint32_t address;
+	uint8_t next;
+	uint8_t chan;
+	int32_t ret;
+
+	if (!waveform || !data_iq || !count)
+		return FAILURE;
+
+	num_tx_channels = max(waveform->dac->num_channels / 2, 1);
+	bytes = count * num_tx_channels * sizeof(uint32_t);
+	if (bytes > waveform->buff_size)
+		return FAILURE;
+
+	if (waveform->running) {
+		ret = axi_dac_waveform_swap_wait(waveform);
+		if (ret != SUCCESS)
+			return ret;
+
+		if (bytes != waveform->size[waveform->active])
+			axi_dac_waveform_stop(waveform);
+	}
+
+	next = waveform->running ?
+	       (waveform->active + 1) % AXI_DAC_WAVEFORM_NUM_BUFFS :
+	       waveform->active;
+
+	axi_dac_waveform_pack(waveform->buff[next], data_iq, count,
+			      num_tx_channels);
+	address = (uint32_t)(uintptr_t)waveform->buff[next];
+	if (waveform->dcache_flush_range)
+		waveform->dcache_flush_range(address, bytes);
+
+	waveform->size[next] = bytes;
+	waveform->active = next;
+
+	if (waveform->running) {
+		axi_dmac_write(waveform->dmac, AXI_DMAC_REG_SRC_ADDRESS, address);
+		axi_dmac_read(waveform->dmac, AXI_DMAC_REG_TRANSFER_ID,
+			      &waveform->swap_id);
+		waveform->swap_pending = true;
+
+		return SUCCESS;
+	}
+
+	for (chan = 0; chan < waveform->dac->num_channels; chan++) {
+		axi_dac_write(waveform->dac, AXI_DAC_REG_DATA_SELECT((chan*2)+0), 0x2);
+		axi_dac_write(waveform->dac, AXI_DAC_REG_DATA_SELECT((chan*2)+1), 0x2);
+	}
+	axi_dac_write(waveform->dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
+
+	if (axi_dmac_transfer(waveform->dmac, address, bytes))
+		return FAILURE;
+
+	waveform->running = true;
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_dac_waveform_stop
+ *******************************************************************************/
+int32_t axi_dac_waveform_stop(struct axi_dac_waveform *waveform)
+{
+	if (!waveform)
+		return FAILURE;
+
+	axi_dmac_write(waveform->dmac, AXI_DMAC_REG_CTRL, 0x0);
+	waveform->running = false;
+	waveform->swap_pending = false;
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_dac_waveform_remove
+ *******************************************************************************/
+int32_t axi_dac_waveform_remove(struct axi_dac_waveform *waveform)
+{
+	if (!waveform)
+		return FAILURE;
+
+	if (waveform->running)
+		axi_dac_waveform_stop(waveform);
+
+	free(waveform);
+
+	return SUCCESS;
+}
 
 /***************************************************************************//**
  * @brief axi_dac_init
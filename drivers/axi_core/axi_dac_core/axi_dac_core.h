@@ -43,6 +43,14 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
+#include "axi_dmac.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Number of buffers a waveform is double buffered in */
+#define AXI_DAC_WAVEFORM_NUM_BUFFS	2
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -87,6 +95,27 @@ struct axi_dac_channel {
 	enum axi_dac_data_sel sel;      // set to one of the enumerated type above.
 };
 
+struct axi_dac_waveform {
+	struct axi_dac *dac;
+	struct axi_dmac *dmac;			// cyclic MEM_TO_DEV dmac feeding the dac
+	uint32_t *buff[AXI_DAC_WAVEFORM_NUM_BUFFS];
+	uint32_t buff_size;			// size of each buffer in bytes
+	uint32_t size[AXI_DAC_WAVEFORM_NUM_BUFFS]; // bytes loaded in each buffer
+	uint8_t active;				// buffer read by the dmac
+	bool running;
+	bool swap_pending;			// previous buffer may still be read
+	uint32_t swap_id;			// dmac transfer id after the last swap
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+};
+
+struct axi_dac_waveform_init {
+	struct axi_dac *dac;
+	struct axi_dmac *dmac;			// must have the DMA_CYCLIC flag set
+	uint32_t *buff[AXI_DAC_WAVEFORM_NUM_BUFFS]; // cacheable, DMA reachable
+	uint32_t buff_size;			// size of each buffer in bytes
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -137,5 +166,12 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 				 uint32_t custom_tx_count,
 				 uint32_t address);
 int32_t axi_dac_data_setup(struct axi_dac *dac);
+int32_t axi_dac_waveform_init(struct axi_dac_waveform **waveform,
+			      const struct axi_dac_waveform_init *init);
+int32_t axi_dac_waveform_load(struct axi_dac_waveform *waveform,
+			      const uint32_t *data_iq,
+			      uint32_t count);
+int32_t axi_dac_waveform_stop(struct axi_dac_waveform *waveform);
+int32_t axi_dac_waveform_remove(struct axi_dac_waveform *waveform);
 
 #endif
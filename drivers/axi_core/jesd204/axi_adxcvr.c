@@ -433,3 +433,47 @@ int32_t adxcvr_remove(struct adxcvr *xcvr)
 
 	return SUCCESS;
 }
+
+/**
+ * @brief adxcvr_link_phy_start
+ *
+ * Link bring-up PHY phase: release the reset, as adxcvr_clk_enable() does,
+ * without waiting.
+ */
+static int32_t adxcvr_link_phy_start(void *dev)
+{
+	return adxcvr_write(dev, ADXCVR_REG_RESETN, ADXCVR_RESETN);
+}
+
+/**
+ * @brief adxcvr_link_phy_poll
+ *
+ * Link bring-up PHY phase: poll for the PLL lock and reset done status.
+ */
+static int32_t adxcvr_link_phy_poll(void *dev)
+{
+	struct adxcvr *xcvr = dev;
+	uint32_t status;
+	int32_t ret;
+
+	ret = adxcvr_read(xcvr, ADXCVR_REG_STATUS, &status);
+	if (ret)
+		return ret;
+
+	if (!(status & ADXCVR_STATUS))
+		return JESD204_LINK_BUSY;
+
+	printf("%s: OK (%"PRId32" kHz)\n", xcvr->name, xcvr->lane_rate_khz);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief JESD204 link bring-up operations of the transceiver.
+ */
+const struct jesd204_link_op adxcvr_link_ops[JESD204_LINK_PHASE_NUM] = {
+	[JESD204_LINK_PHASE_PHY] = {
+		.start = adxcvr_link_phy_start,
+		.poll = adxcvr_link_phy_poll,
+	},
+};
@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "xilinx_transceiver.h"
+#include "jesd204_link.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -94,4 +95,7 @@ int32_t adxcvr_remove(struct adxcvr *xcvr);
 int32_t adxcvr_clk_set_rate(struct adxcvr *xcvr,
 			    uint32_t rate,
 			    uint32_t parent_rate);
+
+/* JESD204 link bring-up operations */
+extern const struct jesd204_link_op adxcvr_link_ops[JESD204_LINK_PHASE_NUM];
 #endif
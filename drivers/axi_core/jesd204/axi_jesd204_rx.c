@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include "error.h"
 #include "delay.h"
@@ -62,6 +63,10 @@
 #define JESD204_RX_ENCODER_MASK			GENMASK(9, 8)
 #define JESD204_RX_ENCODER_GET(x)	field_get(JESD204_RX_ENCODER_MASK, x)
 
+#define JESD204_RX_REG_IRQ_ENABLE		0x80
+#define JESD204_RX_REG_IRQ_PENDING		0x84
+#define JESD204_RX_REG_IRQ_SOURCE		0x88
+
 #define JESD204_RX_REG_LINK_DISABLE		0xc0
 #define JESD204_RX_REG_LINK_STATE		0xc4
 #define JESD204_RX_REG_LINK_CLK_RATIO	0xc8
@@ -96,6 +101,12 @@
 #define PCORE_VERSION_MINOR(x)		(((x) >> 8) & 0xff)
 #define PCORE_VERSION_PATCH(x)		((x) & 0xff)
 
+#define JESD204_RX_LINK_STATUS_DATA		3
+
+/* Supervisor defaults */
+#define JESD204_RX_SUPERVISOR_POLL_INTERVAL	1000
+#define JESD204_RX_SUPERVISOR_SYNC_TIMEOUT	1000
+
 enum {
 	JESD204_EMB_STATE_INIT = 1,
 	JESD204_EMB_STATE_HUNT,
@@ -392,28 +403,36 @@ int32_t axi_jesd204_rx_laneinfo_read(struct axi_jesd204_rx *jesd, uint32_t lane)
 	return SUCCESS;
 }
 
+/**
+ * @brief axi_jesd204_rx_lane_synced
+ */
+static bool axi_jesd204_rx_lane_synced(struct axi_jesd204_rx *jesd,
+				       uint32_t lane)
+{
+	uint32_t status;
+
+	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LANE_STATUS(lane), &status);
+
+	if (jesd->encoder == JESD204_RX_ENCODER_8B10B)
+		return (status & 0x3) != 0x0;
+
+	status = JESD204_EMB_STATE_GET(status);
+
+	return status > JESD204_EMB_STATE_INIT &&
+	       status <= JESD204_EMB_STATE_LOCK;
+}
+
 /**
  * @brief axi_jesd204_rx_check_lane_status
  */
 bool axi_jesd204_rx_check_lane_status(struct axi_jesd204_rx *jesd,
 				      uint32_t lane)
 {
-	uint32_t status;
 	uint32_t errors;
 	char error_str[sizeof(" (4294967295 errors)")];
 
-	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LANE_STATUS(lane), &status);
-
-	if (jesd->encoder == JESD204_RX_ENCODER_8B10B) {
-		status &= 0x3;
-		if (status != 0x0)
-			return false;
-	} else {
-		status = JESD204_EMB_STATE_GET(status);
-		if (status > JESD204_EMB_STATE_INIT &&
-		    status <= JESD204_EMB_STATE_LOCK)
-			return false;
-	}
+	if (axi_jesd204_rx_lane_synced(jesd, lane))
+		return false;
 
 	if (PCORE_VERSION_MINOR(jesd->version) >= 2) {
 		axi_jesd204_rx_read(jesd, JESD204_RX_REG_LANE_ERRORS(lane), &errors);
@@ -455,6 +474,265 @@ int32_t axi_jesd204_rx_watchdog(struct axi_jesd204_rx *jesd)
 	return SUCCESS;
 }
 
+/**
+ * @brief axi_jesd204_rx_supervisor_irq
+ *
+ * Interrupt handler: acknowledges the core's interrupt and leaves the
+ * status check to the next supervisor step.
+ */
+static void axi_jesd204_rx_supervisor_irq(void *ctx, uint32_t event,
+		void *extra)
+{
+	struct axi_jesd204_rx_supervisor *sup = ctx;
+	uint32_t pending;
+
+	axi_jesd204_rx_read(sup->jesd, JESD204_RX_REG_IRQ_PENDING, &pending);
+	axi_jesd204_rx_write(sup->jesd, JESD204_RX_REG_IRQ_PENDING, pending);
+
+	sup->stats.irqs++;
+	sup->event = true;
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_lanes
+ *
+ * Update the lane statistics and tell if all the lanes are in sync.
+ */
+static bool axi_jesd204_rx_supervisor_lanes(struct axi_jesd204_rx_supervisor *sup,
+		bool count_desyncs)
+{
+	struct axi_jesd204_rx *jesd = sup->jesd;
+	struct axi_jesd204_rx_lane_stats *lane;
+	bool synced = true;
+	uint32_t errors;
+	uint32_t i;
+
+	for (i = 0; i < jesd->num_lanes; i++) {
+		lane = &sup->stats.lane[i];
+
+		if (PCORE_VERSION_MINOR(jesd->version) >= 2) {
+			axi_jesd204_rx_get_lane_errors(jesd, i, &errors);
+			/* The counter restarts from 0 with the link */
+			lane->errors += errors >= lane->last_errors ?
+					errors - lane->last_errors : errors;
+			lane->last_errors = errors;
+		}
+
+		if (!axi_jesd204_rx_lane_synced(jesd, i)) {
+			synced = false;
+			if (count_desyncs)
+				lane->desyncs++;
+		}
+	}
+
+	return synced;
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_restart
+ */
+static void axi_jesd204_rx_supervisor_restart(struct axi_jesd204_rx_supervisor *sup)
+{
+	axi_jesd204_rx_write(sup->jesd, JESD204_RX_REG_LINK_DISABLE, 0x1);
+	sup->stats.restarts++;
+	sup->state = AXI_JESD204_RX_LINK_RESET;
+	sup->steps = 0;
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_step
+ *
+ * Run the link supervisor state machine, to be called from the main loop.
+ * It never waits: a lost link is put in reset on one step, released on the
+ * next one and then checked at every step until all the lanes are in DATA.
+ * While the link is up, steps without a pending interrupt don't access the
+ * core, except every poll_interval steps.
+ * @param sup - The supervisor.
+ * @return The link state.
+ */
+enum axi_jesd204_rx_link_state axi_jesd204_rx_supervisor_step(
+	struct axi_jesd204_rx_supervisor *sup)
+{
+	uint32_t link_disabled;
+	uint32_t link_status;
+
+	sup->steps++;
+	if (sup->state != AXI_JESD204_RX_LINK_UP)
+		sup->recovery++;
+
+	switch (sup->state) {
+	case AXI_JESD204_RX_LINK_UP:
+		if (!sup->event && sup->steps < sup->poll_interval)
+			break;
+	/* Intended fallthrough */
+	case AXI_JESD204_RX_LINK_DOWN:
+		sup->event = false;
+		sup->steps = 0;
+
+		axi_jesd204_rx_read(sup->jesd, JESD204_RX_REG_LINK_STATE,
+				    &link_disabled);
+		if (link_disabled) {
+			sup->state = AXI_JESD204_RX_LINK_DOWN;
+			break;
+		}
+
+		axi_jesd204_rx_read(sup->jesd, JESD204_RX_REG_LINK_STATUS,
+				    &link_status);
+		if (link_status == JESD204_RX_LINK_STATUS_DATA &&
+		    axi_jesd204_rx_supervisor_lanes(sup,
+				    sup->state == AXI_JESD204_RX_LINK_UP)) {
+			sup->state = AXI_JESD204_RX_LINK_UP;
+			break;
+		}
+
+		sup->recovery = 0;
+		if (link_status == JESD204_RX_LINK_STATUS_DATA) {
+			axi_jesd204_rx_supervisor_restart(sup);
+		} else {
+			/* The core is already synchronizing again */
+			sup->state = AXI_JESD204_RX_LINK_WAIT_SYNC;
+		}
+		break;
+	case AXI_JESD204_RX_LINK_RESET:
+		axi_jesd204_rx_write(sup->jesd, JESD204_RX_REG_LINK_DISABLE, 0x0);
+		sup->state = AXI_JESD204_RX_LINK_WAIT_SYNC;
+		sup->steps = 0;
+		break;
+	case AXI_JESD204_RX_LINK_WAIT_SYNC:
+		axi_jesd204_rx_read(sup->jesd, JESD204_RX_REG_LINK_STATUS,
+				    &link_status);
+		if (link_status == JESD204_RX_LINK_STATUS_DATA &&
+		    axi_jesd204_rx_supervisor_lanes(sup, false)) {
+			/* Status changes of the resynchronization */
+			sup->event = false;
+			sup->state = AXI_JESD204_RX_LINK_UP;
+			sup->steps = 0;
+			sup->stats.recovery_steps = sup->recovery;
+			break;
+		}
+
+		if (sup->steps >= sup->sync_timeout) {
+			sup->stats.failed_restarts++;
+			axi_jesd204_rx_supervisor_restart(sup);
+		}
+		break;
+	}
+
+	return sup->state;
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_reset_stats
+ */
+void axi_jesd204_rx_supervisor_reset_stats(struct axi_jesd204_rx_supervisor *sup)
+{
+	uint32_t i;
+
+	sup->stats.irqs = 0;
+	sup->stats.restarts = 0;
+	sup->stats.failed_restarts = 0;
+	sup->stats.recovery_steps = 0;
+	for (i = 0; i < sup->jesd->num_lanes; i++) {
+		sup->stats.lane[i].desyncs = 0;
+		sup->stats.lane[i].errors = 0;
+	}
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_init
+ *
+ * Start supervising a link, as a replacement of the periodic
+ * axi_jesd204_rx_watchdog() calls. With an interrupt controller, the
+ * core's interrupt flags the status changes to the step.
+ * @param sup - Address where to store the supervisor.
+ * @param init - Supervisor parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t axi_jesd204_rx_supervisor_init(struct axi_jesd204_rx_supervisor **sup,
+				       const struct axi_jesd204_rx_supervisor_init *init)
+{
+	struct callback_desc callback;
+	struct axi_jesd204_rx_supervisor *s;
+	int32_t ret;
+
+	if (!sup || !init || !init->jesd)
+		return -EINVAL;
+
+	s = (struct axi_jesd204_rx_supervisor *)calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->stats.lane = calloc(init->jesd->num_lanes, sizeof(*s->stats.lane));
+	if (!s->stats.lane) {
+		free(s);
+		return -ENOMEM;
+	}
+
+	s->jesd = init->jesd;
+	s->irq_ctrl = init->irq_ctrl;
+	s->irq_id = init->irq_id;
+	s->sync_timeout = init->sync_timeout ? init->sync_timeout :
+			  JESD204_RX_SUPERVISOR_SYNC_TIMEOUT;
+	if (!s->irq_ctrl)
+		s->poll_interval = 1;
+	else if (init->poll_interval)
+		s->poll_interval = init->poll_interval;
+	else
+		s->poll_interval = JESD204_RX_SUPERVISOR_POLL_INTERVAL;
+	/* Check the link on the first step */
+	s->state = AXI_JESD204_RX_LINK_DOWN;
+
+	if (s->irq_ctrl) {
+		callback.callback = axi_jesd204_rx_supervisor_irq;
+		callback.ctx = s;
+		callback.config = NULL;
+		ret = irq_register_callback(s->irq_ctrl, s->irq_id, &callback);
+		if (ret != SUCCESS)
+			goto error;
+
+		axi_jesd204_rx_write(s->jesd, JESD204_RX_REG_IRQ_PENDING,
+				     0xffffffff);
+		axi_jesd204_rx_write(s->jesd, JESD204_RX_REG_IRQ_ENABLE,
+				     0xffffffff);
+		ret = irq_enable(s->irq_ctrl, s->irq_id);
+		if (ret != SUCCESS) {
+			axi_jesd204_rx_write(s->jesd, JESD204_RX_REG_IRQ_ENABLE,
+					     0x0);
+			irq_unregister(s->irq_ctrl, s->irq_id);
+			goto error;
+		}
+	}
+
+	*sup = s;
+
+	return SUCCESS;
+error:
+	free(s->stats.lane);
+	free(s);
+
+	return ret;
+}
+
+/**
+ * @brief axi_jesd204_rx_supervisor_remove
+ */
+int32_t axi_jesd204_rx_supervisor_remove(struct axi_jesd204_rx_supervisor *sup)
+{
+	if (!sup)
+		return -EINVAL;
+
+	if (sup->irq_ctrl) {
+		axi_jesd204_rx_write(sup->jesd, JESD204_RX_REG_IRQ_ENABLE, 0x0);
+		irq_disable(sup->irq_ctrl, sup->irq_id);
+		irq_unregister(sup->irq_ctrl, sup->irq_id);
+	}
+
+	free(sup->stats.lane);
+	free(sup);
+
+	return SUCCESS;
+}
+
 /**
  * @brief axi_jesd204_rx_apply_config
  */
@@ -578,3 +856,45 @@ int32_t axi_jesd204_rx_remove(struct axi_jesd204_rx *jesd)
 
 	return SUCCESS;
 }
+
+/**
+ * @brief axi_jesd204_rx_link_enable
+ *
+ * Link bring-up ENABLE phase.
+ */
+static int32_t axi_jesd204_rx_link_enable(void *dev)
+{
+	return axi_jesd204_rx_lane_clk_enable(dev);
+}
+
+/**
+ * @brief axi_jesd204_rx_link_running
+ *
+ * Link bring-up RUNNING phase: poll for DATA.
+ */
+static int32_t axi_jesd204_rx_link_running(void *dev)
+{
+	uint32_t link_status;
+	int32_t ret;
+
+	ret = axi_jesd204_rx_read(dev, JESD204_RX_REG_LINK_STATUS, &link_status);
+	if (ret)
+		return ret;
+
+	if ((link_status & 0x3) != JESD204_RX_LINK_STATUS_DATA)
+		return JESD204_LINK_BUSY;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief JESD204 link bring-up operations of the RX core.
+ */
+const struct jesd204_link_op axi_jesd204_rx_link_ops[JESD204_LINK_PHASE_NUM] = {
+	[JESD204_LINK_PHASE_ENABLE] = {
+		.start = axi_jesd204_rx_link_enable,
+	},
+	[JESD204_LINK_PHASE_RUNNING] = {
+		.poll = axi_jesd204_rx_link_running,
+	},
+};
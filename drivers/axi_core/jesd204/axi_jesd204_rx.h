@@ -44,6 +44,8 @@
 /******************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include "irq.h"
+#include "jesd204_link.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -84,6 +86,70 @@ struct jesd204_rx_init {
 	uint32_t lane_clk_khz;
 };
 
+/* State of a link watched by the supervisor */
+enum axi_jesd204_rx_link_state {
+	/* Disabled by the application, not supervised */
+	AXI_JESD204_RX_LINK_DOWN,
+	/* Held in reset by the supervisor */
+	AXI_JESD204_RX_LINK_RESET,
+	/* Waiting for all the lanes to reach DATA */
+	AXI_JESD204_RX_LINK_WAIT_SYNC,
+	/* All the lanes in DATA */
+	AXI_JESD204_RX_LINK_UP,
+};
+
+struct axi_jesd204_rx_lane_stats {
+	/* Times the lane was found out of sync */
+	uint32_t desyncs;
+	/* Errors reported by the lane (core version 1.2 and later) */
+	uint32_t errors;
+	/* Last value of the lane error counter, cleared by a link reset */
+	uint32_t last_errors;
+};
+
+struct axi_jesd204_rx_link_stats {
+	/* Link status change interrupts */
+	uint32_t irqs;
+	/* Link resets issued by the supervisor */
+	uint32_t restarts;
+	/* Resets after which the link didn't reach DATA in time */
+	uint32_t failed_restarts;
+	/* Steps the last recovery took, from loss of sync to DATA */
+	uint32_t recovery_steps;
+	/* Per lane statistics, num_lanes entries */
+	struct axi_jesd204_rx_lane_stats *lane;
+};
+
+struct axi_jesd204_rx_supervisor_init {
+	struct axi_jesd204_rx *jesd;
+	/* Interrupt controller the core's interrupt is routed to, NULL to
+	 * check the link status at every step */
+	struct irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_id;
+	/* Steps between status checks without interrupt, in case the core
+	 * doesn't signal the change, 0 for 1000 */
+	uint32_t poll_interval;
+	/* Steps to wait for DATA after a reset before resetting again,
+	 * 0 for 1000 */
+	uint32_t sync_timeout;
+};
+
+struct axi_jesd204_rx_supervisor {
+	struct axi_jesd204_rx *jesd;
+	struct irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_id;
+	uint32_t poll_interval;
+	uint32_t sync_timeout;
+	enum axi_jesd204_rx_link_state state;
+	/* Set by the interrupt handler, cleared by the step */
+	volatile bool event;
+	/* Steps spent in the current state */
+	uint32_t steps;
+	/* Steps since the loss of sync */
+	uint32_t recovery;
+	struct axi_jesd204_rx_link_stats stats;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -93,7 +159,16 @@ uint32_t axi_jesd204_rx_status_read(struct axi_jesd204_rx *jesd);
 int32_t axi_jesd204_rx_laneinfo_read(struct axi_jesd204_rx *jesd,
 				     uint32_t lane);
 int32_t axi_jesd204_rx_watchdog(struct axi_jesd204_rx *jesd);
+int32_t axi_jesd204_rx_supervisor_init(struct axi_jesd204_rx_supervisor **sup,
+				       const struct axi_jesd204_rx_supervisor_init *init);
+int32_t axi_jesd204_rx_supervisor_remove(struct axi_jesd204_rx_supervisor *sup);
+enum axi_jesd204_rx_link_state axi_jesd204_rx_supervisor_step(
+	struct axi_jesd204_rx_supervisor *sup);
+void axi_jesd204_rx_supervisor_reset_stats(struct axi_jesd204_rx_supervisor *sup);
 int32_t axi_jesd204_rx_init(struct axi_jesd204_rx **jesd204,
 			    const struct jesd204_rx_init *init);
 int32_t axi_jesd204_rx_remove(struct axi_jesd204_rx *jesd);
+
+/* JESD204 link bring-up operations */
+extern const struct jesd204_link_op axi_jesd204_rx_link_ops[JESD204_LINK_PHASE_NUM];
 #endif
@@ -84,6 +84,8 @@
 #define PCORE_VERSION_MINOR(x)		(((x) >> 8) & 0xff)
 #define PCORE_VERSION_PATCH(x)		((x) & 0xff)
 
+#define JESD204_TX_LINK_STATUS_DATA		3
+
 const char *axi_jesd204_tx_link_status_label[] = {
 	"WAIT",
 	"CGS",
@@ -425,3 +427,46 @@ int32_t axi_jesd204_tx_remove(struct axi_jesd204_tx *jesd)
 
 	return SUCCESS;
 }
+
+/**
+ * @brief axi_jesd204_tx_link_enable
+ *
+ * Link bring-up SETUP phase: a DAC link enables the link layer before its
+ * transceiver comes up, and the DAC is configured last.
+ */
+static int32_t axi_jesd204_tx_link_enable(void *dev)
+{
+	return axi_jesd204_tx_lane_clk_enable(dev);
+}
+
+/**
+ * @brief axi_jesd204_tx_link_running
+ *
+ * Link bring-up RUNNING phase: poll for DATA.
+ */
+static int32_t axi_jesd204_tx_link_running(void *dev)
+{
+	uint32_t link_status;
+	int32_t ret;
+
+	ret = axi_jesd204_tx_read(dev, JESD204_TX_REG_LINK_STATUS, &link_status);
+	if (ret)
+		return ret;
+
+	if ((link_status & 0x3) != JESD204_TX_LINK_STATUS_DATA)
+		return JESD204_LINK_BUSY;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief JESD204 link bring-up operations of the TX core.
+ */
+const struct jesd204_link_op axi_jesd204_tx_link_ops[JESD204_LINK_PHASE_NUM] = {
+	[JESD204_LINK_PHASE_SETUP] = {
+		.start = axi_jesd204_tx_link_enable,
+	},
+	[JESD204_LINK_PHASE_RUNNING] = {
+		.poll = axi_jesd204_tx_link_running,
+	},
+};
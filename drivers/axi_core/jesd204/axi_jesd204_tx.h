@@ -44,6 +44,7 @@
 /******************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include "jesd204_link.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -109,4 +110,7 @@ uint32_t axi_jesd204_tx_status_read(struct axi_jesd204_tx *jesd);
 int32_t axi_jesd204_tx_init(struct axi_jesd204_tx **jesd204,
 			    const struct jesd204_tx_init *init);
 int32_t axi_jesd204_tx_remove(struct axi_jesd204_tx *jesd);
+
+/* JESD204 link bring-up operations */
+extern const struct jesd204_link_op axi_jesd204_tx_link_ops[JESD204_LINK_PHASE_NUM];
 #endif
@@ -0,0 +1,338 @@
+/***************************************************************************//**
+ *   @file   jesd204_link.c
+ *   @brief  JESD204 link bring-up sequencer.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "error.h"
+#include "delay.h"
+#include "jesd204_link.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define JESD204_LINK_POLL_US		100
+#define JESD204_LINK_TIMEOUT_MS		1000
+
+static const char *jesd204_link_phase_label[JESD204_LINK_PHASE_NUM] = {
+	"clocks",
+	"setup",
+	"phy",
+	"enable",
+	"running",
+};
+
+/******************************************************************************/
+/************************** Functions Implementation **************************/
+/******************************************************************************/
+
+/**
+ * @brief jesd204_link_time
+ *
+ * Time since the start of the bring-up, in microseconds.
+ */
+static uint32_t jesd204_link_time(const struct jesd204_link_bringup_param *param,
+				  uint32_t start, uint32_t polled)
+{
+	if (param->get_time_us)
+		return param->get_time_us() - start;
+
+	return polled;
+}
+
+/**
+ * @brief jesd204_link_op_get
+ */
+static const struct jesd204_link_op *jesd204_link_op_get(
+	const struct jesd204_link_dev *dev, enum jesd204_link_phase phase)
+{
+	if (!dev->dev || !dev->ops)
+		return NULL;
+
+	if (!dev->ops[phase].start && !dev->ops[phase].poll)
+		return NULL;
+
+	return &dev->ops[phase];
+}
+
+/**
+ * @brief jesd204_link_owner
+ *
+ * Find the previous link, if any, which handles a shared device in this
+ * phase: the first one having the same device and operations.
+ * @return true if the device is handled by another link.
+ */
+static bool jesd204_link_owner(const struct jesd204_link *links,
+			       uint32_t link, uint32_t type,
+			       uint32_t *owner, uint32_t *owner_type)
+{
+	const struct jesd204_link_dev *dev = &links[link].dev[type];
+	uint32_t i, j;
+
+	for (i = 0; i < link; i++) {
+		if (links[i].phase != links[link].phase)
+			continue;
+
+		for (j = 0; j < JESD204_LINK_DEV_NUM; j++) {
+			if (links[i].dev[j].dev == dev->dev &&
+			    links[i].dev[j].ops == dev->ops) {
+				*owner = i;
+				*owner_type = j;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief jesd204_link_fail
+ */
+static void jesd204_link_fail(struct jesd204_link *link, int32_t error)
+{
+	link->error = error;
+	link->pending = 0;
+	printf("%s: %s phase failed (%"PRIi32")\n", link->name,
+	       jesd204_link_phase_label[link->phase], error);
+}
+
+/**
+ * @brief jesd204_link_phase_start
+ *
+ * Start a phase on all the devices of a link. Shared devices are started
+ * by their owner only.
+ */
+static void jesd204_link_phase_start(struct jesd204_link *links,
+				     uint32_t link,
+				     enum jesd204_link_phase phase)
+{
+	struct jesd204_link *l = &links[link];
+	const struct jesd204_link_op *op;
+	uint32_t owner, owner_type;
+	int32_t ret;
+	uint32_t i;
+
+	l->phase = phase;
+	l->pending = 0;
+
+	for (i = 0; i < JESD204_LINK_DEV_NUM; i++) {
+		op = jesd204_link_op_get(&l->dev[i], phase);
+		if (!op)
+			continue;
+
+		if (op->start && !jesd204_link_owner(links, link, i, &owner,
+						     &owner_type)) {
+			ret = op->start(l->dev[i].dev);
+			if (ret < 0) {
+				jesd204_link_fail(l, ret);
+				return;
+			}
+		}
+
+		if (op->poll)
+			l->pending |= 1 << i;
+	}
+}
+
+/**
+ * @brief jesd204_link_phase_poll
+ *
+ * Poll the devices of a link still busy with the current phase. A shared
+ * device is polled by its owner, the other links wait for the owner to be
+ * done with it.
+ * @return true if the link is done with the phase.
+ */
+static bool jesd204_link_phase_poll(struct jesd204_link *links, uint32_t link)
+{
+	struct jesd204_link *l = &links[link];
+	uint32_t owner, owner_type;
+	int32_t ret;
+	uint32_t i;
+
+	for (i = 0; i < JESD204_LINK_DEV_NUM; i++) {
+		if (!(l->pending & (1 << i)))
+			continue;
+
+		if (jesd204_link_owner(links, link, i, &owner, &owner_type)) {
+			if (links[owner].pending & (1 << owner_type))
+				ret = JESD204_LINK_BUSY;
+			else
+				ret = links[owner].error;
+		} else {
+			ret = l->dev[i].ops[l->phase].poll(l->dev[i].dev);
+		}
+
+		if (ret < 0) {
+			jesd204_link_fail(l, ret);
+			return true;
+		}
+		if (ret == SUCCESS)
+			l->pending &= ~(1 << i);
+	}
+
+	return !l->pending;
+}
+
+/**
+ * @brief jesd204_link_bringup
+ *
+ * Bring up the links, advancing them concurrently through the phases.
+ * All the links complete a phase before any of them starts the next one,
+ * so a clock provider or transceiver quad shared by several links sees a
+ * consistent state, and within a phase the devices are polled instead of
+ * waited for with fixed delays. The bring-up time is thus the sum, over
+ * the phases, of the slowest link. A failed link stops advancing, while
+ * the others go on.
+ * @param links - The links.
+ * @param num_links - Number of links.
+ * @param param - Bring-up parameters, NULL for the defaults.
+ * @return SUCCESS if all the links reached DATA, FAILURE otherwise. The
+ *         error of each link is in its error field.
+ */
+int32_t jesd204_link_bringup(struct jesd204_link *links, uint32_t num_links,
+			     const struct jesd204_link_bringup_param *param)
+{
+	const struct jesd204_link_bringup_param defaults = { 0 };
+	uint32_t poll_us, timeout_us;
+	uint32_t start, polled, t0, now;
+	enum jesd204_link_phase phase;
+	bool busy;
+	uint32_t i;
+
+	if (!links || !num_links)
+		return -EINVAL;
+
+	if (!param)
+		param = &defaults;
+
+	poll_us = param->poll_us ? param->poll_us : JESD204_LINK_POLL_US;
+	timeout_us = (param->timeout_ms ? param->timeout_ms :
+		      JESD204_LINK_TIMEOUT_MS) * 1000;
+	start = param->get_time_us ? param->get_time_us() : 0;
+	polled = 0;
+
+	for (i = 0; i < num_links; i++) {
+		links[i].error = SUCCESS;
+		links[i].pending = 0;
+		for (phase = 0; phase < JESD204_LINK_PHASE_NUM; phase++)
+			links[i].phase_us[phase] = 0;
+	}
+
+	for (phase = 0; phase < JESD204_LINK_PHASE_NUM; phase++) {
+		t0 = jesd204_link_time(param, start, polled);
+
+		for (i = 0; i < num_links; i++) {
+			if (links[i].error != SUCCESS)
+				continue;
+
+			jesd204_link_phase_start(links, i, phase);
+			now = jesd204_link_time(param, start, polled);
+			links[i].phase_us[phase] = now - t0;
+		}
+
+		do {
+			busy = false;
+			now = jesd204_link_time(param, start, polled);
+
+			for (i = 0; i < num_links; i++) {
+				if (!links[i].pending)
+					continue;
+
+				if (jesd204_link_phase_poll(links, i)) {
+					links[i].phase_us[phase] = now - t0;
+					continue;
+				}
+
+				if (now - t0 >= timeout_us) {
+					links[i].phase_us[phase] = now - t0;
+					jesd204_link_fail(&links[i], -ETIMEDOUT);
+					continue;
+				}
+
+				busy = true;
+			}
+
+			if (busy) {
+				udelay(poll_us);
+				polled += poll_us;
+			}
+		} while (busy);
+	}
+
+	for (i = 0; i < num_links; i++)
+		if (links[i].error != SUCCESS)
+			return FAILURE;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief jesd204_link_report
+ *
+ * Print the phase reached by each link and the time spent in each phase.
+ * @param links - The links.
+ * @param num_links - Number of links.
+ */
+void jesd204_link_report(const struct jesd204_link *links,
+			 uint32_t num_links)
+{
+	uint32_t i, phase, total;
+
+	for (i = 0; i < num_links; i++) {
+		total = 0;
+		if (links[i].error == SUCCESS)
+			printf("%s: up\n", links[i].name);
+		else
+			printf("%s: failed in the %s phase (%"PRIi32")\n",
+			       links[i].name,
+			       jesd204_link_phase_label[links[i].phase],
+			       links[i].error);
+
+		for (phase = 0; phase <= links[i].phase; phase++) {
+			printf("\t%-8s %8"PRIu32" us\n",
+			       jesd204_link_phase_label[phase],
+			       links[i].phase_us[phase]);
+			total += links[i].phase_us[phase];
+		}
+		printf("\t%-8s %8"PRIu32" us\n", "total", total);
+	}
+}
@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ *   @file   jesd204_link.h
+ *   @brief  JESD204 link bring-up sequencer.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef JESD204_LINK_H_
+#define JESD204_LINK_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Returned by a poll operation while the phase is still in progress */
+#define JESD204_LINK_BUSY	1
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/* Bring-up phases, all the links complete a phase before the next starts */
+enum jesd204_link_phase {
+	/* Device clocks and SYSREF from the clock provider */
+	JESD204_LINK_PHASE_CLOCKS,
+	/* Converter JESD204 configuration, TX link layer enable (a DAC link
+	 * comes up link layer, PHY, then DAC) */
+	JESD204_LINK_PHASE_SETUP,
+	/* Transceiver reset release and PLL lock */
+	JESD204_LINK_PHASE_PHY,
+	/* RX link layer enable, once the PHY is up */
+	JESD204_LINK_PHASE_ENABLE,
+	/* Wait for the link to reach DATA */
+	JESD204_LINK_PHASE_RUNNING,
+	JESD204_LINK_PHASE_NUM
+};
+
+/* Devices of a link, in the order they are started within a phase */
+enum jesd204_link_dev_type {
+	JESD204_LINK_DEV_CLOCK,
+	JESD204_LINK_DEV_CONVERTER,
+	JESD204_LINK_DEV_XCVR,
+	JESD204_LINK_DEV_CORE,
+	JESD204_LINK_DEV_NUM
+};
+
+struct jesd204_link_op {
+	/* Start the phase, SUCCESS or negative error code */
+	int32_t (*start)(void *dev);
+	/* SUCCESS when the phase is done, JESD204_LINK_BUSY while in
+	 * progress or negative error code */
+	int32_t (*poll)(void *dev);
+};
+
+struct jesd204_link_dev {
+	void *dev;
+	/* JESD204_LINK_PHASE_NUM entries, phases without an operation are
+	 * skipped. A device shared by several links (same dev and ops) is
+	 * started once per phase. */
+	const struct jesd204_link_op *ops;
+};
+
+struct jesd204_link {
+	const char *name;
+	struct jesd204_link_dev dev[JESD204_LINK_DEV_NUM];
+	/* Filled in by jesd204_link_bringup() */
+	enum jesd204_link_phase phase;
+	int32_t error;
+	uint32_t phase_us[JESD204_LINK_PHASE_NUM];
+	/* Devices still polled in the current phase, one bit per type */
+	uint32_t pending;
+};
+
+struct jesd204_link_bringup_param {
+	/* Delay between two polls of the pending links, 0 for 100 us */
+	uint32_t poll_us;
+	/* Phase timeout of a link, 0 for 1000 ms */
+	uint32_t timeout_ms;
+	/* Free running microsecond time, NULL to account only for the
+	 * poll delays */
+	uint32_t (*get_time_us)(void);
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Bring up the links, advancing them concurrently through the phases. */
+int32_t jesd204_link_bringup(struct jesd204_link *links, uint32_t num_links,
+			     const struct jesd204_link_bringup_param *param);
+/* Print the phase reached by each link and the time spent in each phase. */
+void jesd204_link_report(const struct jesd204_link *links,
+			 uint32_t num_links);
+#endif
@@ -43,10 +43,18 @@
 /***************************** Include Files *********************************/
 /*****************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "error.h"
 #include "adas1000.h"
 #include "crc.h"
 
+/*****************************************************************************/
+/************************ Variable Definitions *******************************/
+/*****************************************************************************/
+DECLARE_CRC16_TABLE(adas1000_crc16);
+DECLARE_CRC24_TABLE(adas1000_crc24);
+static bool adas1000_crc_populated;
+
 /*****************************************************************************/
 /************************ Function Definitions *******************************/
 /*****************************************************************************/
@@ -261,6 +269,7 @@ int32_t adas1000_set_inactive_framewords(struct adas1000_dev *device,
 	if (ret != SUCCESS)
 		return ret;
 	/** compute the number of inactive words */
+	device->inactive_words = words_mask;
 	device->inactive_words_no = 0;
 	for(i = 0; i < 32; i++) {
 		if(words_mask & ADAS1000_WD_CNT_MASK)
@@ -408,14 +417,213 @@ uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device, uint8_t *buff)
 {
 	uint32_t crc = 0xFFFFFFFFul;
 
-	/** Select the CRC poly and word size based on the frame rate. */
-	if(device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
-		DECLARE_CRC16_TABLE(adas1000_crc16);
+	/** The tables only depend on the polynomials, build them once. */
+	if (!adas1000_crc_populated) {
 		crc16_populate_msb(adas1000_crc16, CRC_POLY_128KHZ);
-		return crc16(adas1000_crc16, buff, device->frame_size, (uint16_t)crc);
-	} else {
-		DECLARE_CRC24_TABLE(adas1000_crc24);
 		crc24_populate_msb(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
+		adas1000_crc_populated = true;
+	}
+
+	/** Select the CRC poly and word size based on the frame rate. */
+	if(device->frame_rate == ADAS1000_128KHZ_FRAME_RATE)
+		return crc16(adas1000_crc16, buff, device->frame_size, (uint16_t)crc);
+	else
 		return crc24(adas1000_crc24, buff, device->frame_size, crc);
+}
+
+/**
+ * @brief Starts streaming frames. The frames read sequence is started and
+ *	  each frame read by adas1000_stream_frame() is validated and stored
+ *	  in a ring buffer, from where adas1000_stream_read() copies it.
+ * @param device - Device structure.
+ * @param param - Stream parameters, may be NULL for the defaults.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_param *param)
+{
+	uint32_t ring_frames = ADAS1000_STREAM_RING_FRAMES;
+	uint8_t *ring;
+	int32_t ret;
+
+	if (!device || device->ring)
+		return FAILURE;
+
+	if (param && param->ring_frames)
+		ring_frames = param->ring_frames;
+
+	/** One extra slot, past the ring, takes the frames read while it is full. */
+	ring = (uint8_t *)calloc(ring_frames + 1, device->frame_size);
+	if (!ring)
+		return FAILURE;
+
+	device->ring_frames = ring_frames;
+	device->ring_head = 0;
+	device->ring_tail = 0;
+	device->crc_errors = 0;
+	device->header_errors = 0;
+	device->missed_frames = 0;
+
+	/** Build the CRC tables before the first frame arrives. */
+	adas1000_compute_frame_crc(device, ring);
+
+	/** Publish the ring last, the DRDY callback ignores frames until then. */
+	device->ring = ring;
+
+	/** Send a FRAMES command to start the frames read sequence. */
+	ret = adas1000_write(device, ADAS1000_FRAMES, 0);
+	if (ret != SUCCESS) {
+		device->ring = NULL;
+		free(ring);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Stops streaming frames and frees the ring buffer.
+ *	  The ring is detached before it is freed, so a DRDY callback that
+ *	  runs afterwards drops its frame. On a platform where the callback can
+ *	  run concurrently with this function (not just preempt it), disable the
+ *	  DRDY interrupt before calling it.
+ * @param device - Device structure.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_stop(struct adas1000_dev *device)
+{
+	uint32_t reg_data;
+	uint8_t *ring;
+	int32_t ret;
+
+	if (!device || !device->ring)
+		return FAILURE;
+
+	ring = device->ring;
+	device->ring = NULL;
+
+	/** Read a register to stop the frames read sequence. */
+	ret = adas1000_read(device, ADAS1000_FRMCTL, &reg_data);
+
+	free(ring);
+
+	return ret;
+}
+
+/**
+ * @brief Reads one frame with a single SPI transfer into the next slot of the
+ *	  ring buffer. The header is checked for the marker and READY bits, its
+ *	  overflow field (frames the device dropped since the last read) is
+ *	  added to the missed frames and the CRC word, if enabled, is checked.
+ *	  Invalid frames are dropped. When the ring is full, the frame is still
+ *	  read, then dropped and counted as missed.
+ *	  Meant to be called from the DRDY interrupt.
+ * @param device - Device structure.
+ * @return SUCCESS if a valid frame was stored, -ENOSPC if the ring was full,
+ *	   negative error code otherwise.
+ */
+int32_t adas1000_stream_frame(struct adas1000_dev *device)
+{
+	uint32_t check;
+	uint8_t *ring;
+	uint8_t *frame;
+	bool full;
+	int32_t ret;
+
+	if (!device)
+		return FAILURE;
+
+	/** Sample the ring once, adas1000_stream_stop() may detach it. */
+	ring = device->ring;
+	if (!ring)
+		return FAILURE;
+
+	/** The frame must be clocked out even when the ring is full, or an
+	edge triggered DRDY is never raised again. It then goes to the scratch
+	slot past the ring and is counted as missed. */
+	full = (device->ring_head - device->ring_tail >= device->ring_frames);
+	if (full)
+		frame = ring + device->ring_frames * device->frame_size;
+	else
+		frame = ring + (device->ring_head % device->ring_frames) *
+			device->frame_size;
+
+	/** Clock out NOPs so the frames read sequence is not interrupted. */
+	memset(frame, 0, device->frame_size);
+	ret = spi_write_and_read(device->spi_desc, frame, device->frame_size);
+	if (ret != SUCCESS)
+		return ret;
+
+	if (full) {
+		device->missed_frames++;
+		return -ENOSPC;
+	}
+
+	if (!(frame[0] & (ADAS1000_FRAMES_MARKER >> 24)) ||
+	    (frame[0] & ADAS1000_RDY_MASK)) {
+		device->header_errors++;
+		return FAILURE;
 	}
+
+	device->missed_frames += ADAS1000_FRAMES_OVERFLOW_CNT(frame[0]);
+
+	if (!(device->inactive_words & ADAS1000_FRMCTL_CRCDIS)) {
+		check = (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) ?
+			CRC_CHECK_CONST_128KHz : CRC_CHECK_CONST_2KHZ_16KHZ;
+		if (adas1000_compute_frame_crc(device, frame) != check) {
+			device->crc_errors++;
+			return FAILURE;
+		}
+	}
+
+	device->ring_head++;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief DRDY interrupt callback, to be registered with irq_register_callback().
+ * @param ctx - Device structure.
+ * @param event - Unused.
+ * @param extra - Unused.
+ */
+void adas1000_stream_drdy_callback(void *ctx, uint32_t event, void *extra)
+{
+	adas1000_stream_frame(ctx);
+}
+
+/**
+ * @brief Copies buffered frames from the ring buffer, without waiting.
+ * @param device - Device structure.
+ * @param data_buff - Buffer to store the frames.
+ * @param frame_cnt - Maximum number of frames to copy.
+ * @return Number of frames copied.
+ */
+uint32_t adas1000_stream_read(struct adas1000_dev *device, uint8_t *data_buff,
+			      uint32_t frame_cnt)
+{
+	uint32_t avail, idx, n, i = 0;
+
+	if (!device || !device->ring || !data_buff)
+		return 0;
+
+	avail = device->ring_head - device->ring_tail;
+	if (frame_cnt > avail)
+		frame_cnt = avail;
+
+	/** Copy in at most two chunks, before and after the ring wraps. */
+	while (i < frame_cnt) {
+		idx = (device->ring_tail + i) % device->ring_frames;
+		n = device->ring_frames - idx;
+		if (n > frame_cnt - i)
+			n = frame_cnt - i;
+
+		memcpy(data_buff + i * device->frame_size,
+		       device->ring + idx * device->frame_size,
+		       n * device->frame_size);
+		i += n;
+	}
+
+	device->ring_tail += frame_cnt;
+
+	return frame_cnt;
 }
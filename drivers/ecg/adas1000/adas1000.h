@@ -1073,6 +1073,14 @@
 #define CRC_POLY_128KHZ				               0x00001021ul
 #define CRC_CHECK_CONST_128KHz			         0x00001D0Ful
 
+/******************************************************************************/
+/* ADAS1000 frame streaming */
+/******************************************************************************/
+/* Number of frames buffered when not specified */
+#define ADAS1000_STREAM_RING_FRAMES		      128
+/* Overflow field of the header, first byte of the frame */
+#define ADAS1000_FRAMES_OVERFLOW_CNT(x)	      (((x) >> 4) & 0x3)
+
 struct adas1000_dev {
 	/** SPI Descriptor */
 	struct spi_desc *spi_desc;
@@ -1082,6 +1090,28 @@ struct adas1000_dev {
 	uint32_t frame_rate;
 	/** Number of inactive words in a frame */
 	uint32_t inactive_words_no;
+	/** Words excluded from a frame, Frame Control Register bits */
+	uint32_t inactive_words;
+	/** Frame ring buffer, NULL if not streaming */
+	uint8_t *volatile ring;
+	/** Number of frames the ring buffer holds */
+	uint32_t ring_frames;
+	/** Number of frames written to the ring buffer */
+	volatile uint32_t ring_head;
+	/** Number of frames read from the ring buffer */
+	volatile uint32_t ring_tail;
+	/** Frames dropped because of a bad CRC */
+	uint32_t crc_errors;
+	/** Frames dropped because of an invalid or busy header */
+	uint32_t header_errors;
+	/** Frames missed by the device, including while the ring was full */
+	uint32_t missed_frames;
+};
+
+struct adas1000_stream_param {
+	/** Number of frames the ring buffer holds,
+	    0 for ADAS1000_STREAM_RING_FRAMES */
+	uint32_t ring_frames;
 };
 
 struct adas1000_init_param {
@@ -1146,4 +1176,21 @@ int32_t adas1000_read_data(struct adas1000_dev *device, uint8_t *data_buff,
 uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device,
 				    uint8_t *buff);
 
+/* Starts streaming frames to a ring buffer */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_param *param);
+
+/* Stops streaming frames */
+int32_t adas1000_stream_stop(struct adas1000_dev *device);
+
+/* Reads one frame into the ring buffer, called on DRDY */
+int32_t adas1000_stream_frame(struct adas1000_dev *device);
+
+/* DRDY interrupt callback, ctx is the device structure */
+void adas1000_stream_drdy_callback(void *ctx, uint32_t event, void *extra);
+
+/* Copies buffered frames from the ring buffer */
+uint32_t adas1000_stream_read(struct adas1000_dev *device, uint8_t *data_buff,
+			      uint32_t frame_cnt);
+
 #endif /* _ADAS1000_H_ */
@@ -0,0 +1,197 @@
+/***************************************************************************//**
+ *   @file   iio_adas1000.c
+ *   @brief  Implementation of the ADAS1000 IIO driver.
+********************************************************************************
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "delay.h"
+#include "iio.h"
+#include "iio_adas1000.h"
+#include "util.h"
+#include "adas1000.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define IIO_ADAS1000_NUM_LEADS		5
+#define IIO_ADAS1000_LEAD_DIS(x)	(ADAS1000_FRMCTL_LEAD_I_LADIS >> (x))
+#define IIO_ADAS1000_LEADS_DIS		(ADAS1000_FRMCTL_LEAD_I_LADIS | \
+					 ADAS1000_FRMCTL_LEAD_II_LLDIS | \
+					 ADAS1000_FRMCTL_LEAD_III_RADIS | \
+					 ADAS1000_FRMCTL_V1DIS | \
+					 ADAS1000_FRMCTL_V2DIS)
+#define IIO_ADAS1000_MAX_FRAME_BYTES	(ADAS1000_2KHZ_FRAME_SIZE * \
+					 ADAS1000_2KHZ_WORD_SIZE / 8)
+/* Frames arrive every 500 us at the slowest rate, allow for a few missed */
+#define IIO_ADAS1000_FRAME_TIMEOUT_US	100000
+#define IIO_ADAS1000_POLL_US		10
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Keep only the active leads in the frames and start streaming.
+ * @param dev - Device descriptor.
+ * @param mask - Active channels mask.
+ * @return SUCCESS in case of success, error code otherwise.
+ */
+static int32_t iio_adas1000_prepare_transfer(void *dev, uint32_t mask)
+{
+	struct adas1000_dev *desc = dev;
+	uint32_t words;
+	int32_t ret;
+	uint8_t i;
+
+	words = desc->inactive_words & ~IIO_ADAS1000_LEADS_DIS;
+	for (i = 0; i < IIO_ADAS1000_NUM_LEADS; i++)
+		if (!(mask & BIT(i)))
+			words |= IIO_ADAS1000_LEAD_DIS(i);
+
+	ret = adas1000_set_inactive_framewords(desc, words);
+	if (ret != SUCCESS)
+		return ret;
+
+	return adas1000_stream_start(desc, NULL);
+}
+
+/**
+ * @brief Stop streaming.
+ * @param dev - Device descriptor.
+ * @return SUCCESS in case of success, error code otherwise.
+ */
+static int32_t iio_adas1000_end_transfer(void *dev)
+{
+	return adas1000_stream_stop(dev);
+}
+
+/**
+ * @brief Get a number of samples from all the active leads. The frames are
+ *	  taken from the stream ring buffer, filled from the DRDY interrupt
+ *	  with adas1000_stream_drdy_callback().
+ * @param dev - Device descriptor.
+ * @param buff - Sample buffer.
+ * @param nb_samples - Number of samples to get.
+ * @return Number of samples read, -ENODEV if the stream is not started or
+ *	   -ETIMEDOUT if no frame arrives in IIO_ADAS1000_FRAME_TIMEOUT_US.
+ */
+static int32_t iio_adas1000_read_samples(void *dev, uint32_t *buff,
+		uint32_t nb_samples)
+{
+	struct adas1000_dev *desc = dev;
+	uint8_t frame[IIO_ADAS1000_MAX_FRAME_BYTES];
+	uint8_t *word;
+	uint32_t i, j = 0;
+	uint32_t timeout;
+	uint8_t lead, pos;
+
+	if (!desc->ring)
+		return -ENODEV;
+
+	for (i = 0; i < nb_samples; i++) {
+		timeout = IIO_ADAS1000_FRAME_TIMEOUT_US / IIO_ADAS1000_POLL_US;
+		while (!adas1000_stream_read(desc, frame, 1)) {
+			if (!desc->ring || !timeout--)
+				return -ETIMEDOUT;
+			udelay(IIO_ADAS1000_POLL_US);
+		}
+
+		/* Active leads follow the header in order */
+		for (lead = 0, pos = 1; lead < IIO_ADAS1000_NUM_LEADS; lead++) {
+			if (desc->inactive_words & IIO_ADAS1000_LEAD_DIS(lead))
+				continue;
+
+			if (desc->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
+				word = frame + pos * 2;
+				buff[j++] = ((uint32_t)word[0] << 8) | word[1];
+			} else {
+				word = frame + pos * 4;
+				buff[j++] = ((uint32_t)word[1] << 16) |
+					    ((uint32_t)word[2] << 8) | word[3];
+			}
+			pos++;
+		}
+	}
+
+	return nb_samples;
+}
+
+static struct scan_type adas1000_iio_scan_type = {
+	.sign = 'u',
+	.realbits = 24,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+#define ADAS1000_IIO_CHANN_DEF(nm, ch) \
+	{ \
+		.name = nm, \
+		.ch_type = IIO_VOLTAGE, \
+		.channel = ch, \
+		.scan_index = ch, \
+		.scan_type = &adas1000_iio_scan_type, \
+		.attributes = NULL, \
+		.ch_out = 0, \
+		.indexed = 1, \
+	}
+
+static struct iio_channel adas1000_channels[] = {
+	ADAS1000_IIO_CHANN_DEF("la", 0),
+	ADAS1000_IIO_CHANN_DEF("ll", 1),
+	ADAS1000_IIO_CHANN_DEF("ra", 2),
+	ADAS1000_IIO_CHANN_DEF("v1", 3),
+	ADAS1000_IIO_CHANN_DEF("v2", 4)
+};
+
+struct iio_device iio_adas1000_device = {
+	.num_ch = ARRAY_SIZE(adas1000_channels),
+	.channels = adas1000_channels,
+	.attributes = NULL,
+	.debug_attributes = NULL,
+	.buffer_attributes = NULL,
+	.prepare_transfer = iio_adas1000_prepare_transfer,
+	.end_transfer = iio_adas1000_end_transfer,
+	.read_dev = (int32_t (*)())iio_adas1000_read_samples,
+	.debug_reg_read = (int32_t (*)())adas1000_read,
+	.debug_reg_write = (int32_t (*)())adas1000_write
+};
@@ -0,0 +1,348 @@
+/***************************************************************************//**
+ *   @file   linux_dma_buf.c
+ *   @brief  Implementation of Linux u-dma-buf DMA buffer support.
+********************************************************************************
+ *   @copyright
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "error.h"
+#include "dma_buf.h"
+#include "linux_dma_buf.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** sync_direction values, same as enum dma_data_direction in the kernel */
+#define LINUX_DMA_BUF_TO_DEVICE		1
+#define LINUX_DMA_BUF_FROM_DEVICE	2
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum linux_dma_buf_attr
+ * @brief u-dma-buf sysfs attributes used for cache maintenance.
+ */
+enum linux_dma_buf_attr {
+	LINUX_DMA_BUF_SYNC_OFFSET,
+	LINUX_DMA_BUF_SYNC_SIZE,
+	LINUX_DMA_BUF_SYNC_DIRECTION,
+	LINUX_DMA_BUF_SYNC_FOR_CPU,
+	LINUX_DMA_BUF_SYNC_FOR_DEVICE,
+	LINUX_DMA_BUF_NB_ATTRS
+};
+
+/**
+ * @struct linux_dma_buf_desc
+ * @brief Linux platform specific DMA buffer region descriptor
+ */
+struct linux_dma_buf_desc {
+	/** /dev/"name" file descriptor */
+	int fd;
+	/** Mapping of the u-dma-buf device */
+	void *map;
+	/** Size of the mapping */
+	uint32_t map_size;
+	/** File descriptors of the sysfs sync attributes, kept open so a sync
+	 *  only costs the writes */
+	int attr_fd[LINUX_DMA_BUF_NB_ATTRS];
+};
+
+/******************************************************************************/
+/************************ Variable Definitions ********************************/
+/******************************************************************************/
+
+/** Class directories used by the different u-dma-buf versions */
+static const char *const linux_dma_buf_class[] = {
+	"/sys/class/u-dma-buf",
+	"/sys/class/udmabuf",
+};
+
+/** Names of the sysfs sync attributes */
+static const char *const linux_dma_buf_attr_name[LINUX_DMA_BUF_NB_ATTRS] = {
+	[LINUX_DMA_BUF_SYNC_OFFSET] = "sync_offset",
+	[LINUX_DMA_BUF_SYNC_SIZE] = "sync_size",
+	[LINUX_DMA_BUF_SYNC_DIRECTION] = "sync_direction",
+	[LINUX_DMA_BUF_SYNC_FOR_CPU] = "sync_for_cpu",
+	[LINUX_DMA_BUF_SYNC_FOR_DEVICE] = "sync_for_device",
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read a numeric sysfs attribute of the u-dma-buf device.
+ * @param dir - sysfs directory of the device.
+ * @param attr - Attribute name.
+ * @param value - The value, decimal or 0x prefixed hexadecimal.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_read_attr(const char *dir, const char *attr,
+				       unsigned long long *value)
+{
+	char path[128];
+	FILE *f;
+	int ret;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, attr);
+	f = fopen(path, "r");
+	if (!f)
+		return -errno;
+
+	ret = fscanf(f, "%lli", (long long *)value);
+	fclose(f);
+
+	return ret == 1 ? SUCCESS : -EIO;
+}
+
+/**
+ * @brief Write a sync attribute of the u-dma-buf device.
+ * @param desc - The Linux region descriptor.
+ * @param attr - Attribute to write.
+ * @param value - The value.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_write_attr(struct linux_dma_buf_desc *desc,
+					enum linux_dma_buf_attr attr,
+					uint32_t value)
+{
+	char buf[16];
+	int len;
+
+	len = snprintf(buf, sizeof(buf), "%u", value);
+	if (pwrite(desc->attr_fd[attr], buf, len, 0) != len)
+		return -errno;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Sync a range of the mapping.
+ * @param region - The region descriptor.
+ * @param addr - Cache line aligned start address.
+ * @param size - Size of the range, multiple of the cache line size.
+ * @param dir - LINUX_DMA_BUF_TO_DEVICE or LINUX_DMA_BUF_FROM_DEVICE.
+ * @param trigger - LINUX_DMA_BUF_SYNC_FOR_DEVICE or LINUX_DMA_BUF_SYNC_FOR_CPU.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_sync(struct dma_buf_region *region,
+				  uintptr_t addr, uint32_t size, uint32_t dir,
+				  enum linux_dma_buf_attr trigger)
+{
+	struct linux_dma_buf_desc *desc = region->extra;
+	int32_t ret;
+
+	ret = linux_dma_buf_write_attr(desc, LINUX_DMA_BUF_SYNC_OFFSET,
+				       addr - (uintptr_t)desc->map);
+	if (ret < 0)
+		return ret;
+	ret = linux_dma_buf_write_attr(desc, LINUX_DMA_BUF_SYNC_SIZE, size);
+	if (ret < 0)
+		return ret;
+	ret = linux_dma_buf_write_attr(desc, LINUX_DMA_BUF_SYNC_DIRECTION, dir);
+	if (ret < 0)
+		return ret;
+
+	return linux_dma_buf_write_attr(desc, trigger, 1);
+}
+
+/**
+ * @brief Write back the dirty cache lines of a range.
+ * @param region - The region descriptor.
+ * @param addr - Cache line aligned start address.
+ * @param size - Size of the range, multiple of the cache line size.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_flush(struct dma_buf_region *region,
+				   uintptr_t addr, uint32_t size)
+{
+	return linux_dma_buf_sync(region, addr, size, LINUX_DMA_BUF_TO_DEVICE,
+				  LINUX_DMA_BUF_SYNC_FOR_DEVICE);
+}
+
+/**
+ * @brief Discard the cache lines of a range.
+ * @param region - The region descriptor.
+ * @param addr - Cache line aligned start address.
+ * @param size - Size of the range, multiple of the cache line size.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_invalidate(struct dma_buf_region *region,
+					uintptr_t addr, uint32_t size)
+{
+	return linux_dma_buf_sync(region, addr, size, LINUX_DMA_BUF_FROM_DEVICE,
+				  LINUX_DMA_BUF_SYNC_FOR_CPU);
+}
+
+/**
+ * @brief Free the resources allocated by linux_dma_buf_init().
+ * @param region - The region descriptor.
+ * @return SUCCESS.
+ */
+static int32_t linux_dma_buf_remove(struct dma_buf_region *region)
+{
+	struct linux_dma_buf_desc *desc = region->extra;
+	uint32_t i;
+
+	if (!desc)
+		return SUCCESS;
+
+	for (i = 0; i < LINUX_DMA_BUF_NB_ATTRS; i++)
+		if (desc->attr_fd[i] >= 0)
+			close(desc->attr_fd[i]);
+	if (desc->map != MAP_FAILED)
+		munmap(desc->map, desc->map_size);
+	if (desc->fd >= 0)
+		close(desc->fd);
+	free(desc);
+	region->extra = NULL;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Map a u-dma-buf device as the region memory.
+ * @param region - The region descriptor.
+ * @param param - The structure that contains the region parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t linux_dma_buf_init(struct dma_buf_region *region,
+				  const struct dma_buf_region_init_param *param)
+{
+	struct linux_dma_buf_init_param *linux_init = param->extra;
+	struct linux_dma_buf_desc *desc;
+	unsigned long long phys_addr;
+	unsigned long long size;
+	char dir[96];
+	char path[128];
+	uint32_t i;
+	int32_t ret;
+
+	if (!linux_init || !linux_init->name)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(linux_dma_buf_class); i++) {
+		snprintf(dir, sizeof(dir), "%s/%s", linux_dma_buf_class[i],
+			 linux_init->name);
+		ret = linux_dma_buf_read_attr(dir, "phys_addr", &phys_addr);
+		if (ret == SUCCESS)
+			break;
+	}
+	if (ret < 0) {
+		printf("%s: Can't find u-dma-buf %s\n\r", __func__,
+		       linux_init->name);
+		return ret;
+	}
+
+	ret = linux_dma_buf_read_attr(dir, "size", &size);
+	if (ret < 0)
+		return ret;
+	if (!size || size > UINT32_MAX || phys_addr > UINT32_MAX)
+		return -EINVAL;
+
+	desc = (struct linux_dma_buf_desc *)calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->map = MAP_FAILED;
+	for (i = 0; i < LINUX_DMA_BUF_NB_ATTRS; i++)
+		desc->attr_fd[i] = -1;
+	region->extra = desc;
+
+	snprintf(path, sizeof(path), "/dev/%s", linux_init->name);
+	desc->fd = open(path, O_RDWR | (linux_init->sync ? O_SYNC : 0));
+	if (desc->fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		ret = -errno;
+		goto error;
+	}
+
+	desc->map_size = size;
+	desc->map = mmap(NULL, desc->map_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED, desc->fd, 0);
+	if (desc->map == MAP_FAILED) {
+		ret = -errno;
+		goto error;
+	}
+
+	if (!linux_init->sync) {
+		for (i = 0; i < LINUX_DMA_BUF_NB_ATTRS; i++) {
+			snprintf(path, sizeof(path), "%s/%s", dir,
+				 linux_dma_buf_attr_name[i]);
+			desc->attr_fd[i] = open(path, O_WRONLY);
+			if (desc->attr_fd[i] < 0) {
+				ret = -errno;
+				goto error;
+			}
+		}
+	}
+
+	region->cpu_addr = (uintptr_t)desc->map;
+	region->bus_addr = phys_addr;
+	region->size = desc->map_size;
+	region->coherent = region->coherent || linux_init->sync;
+
+	return SUCCESS;
+
+error:
+	linux_dma_buf_remove(region);
+
+	return ret;
+}
+
+/**
+ * @brief Linux specific DMA buffer platform ops structure
+ */
+const struct dma_buf_platform_ops linux_dma_buf_platform_ops = {
+	.dma_buf_ops_init = &linux_dma_buf_init,
+	.dma_buf_ops_flush = &linux_dma_buf_flush,
+	.dma_buf_ops_invalidate = &linux_dma_buf_invalidate,
+	.dma_buf_ops_remove = &linux_dma_buf_remove,
+};
@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ *   @file   linux_dma_buf.h
+ *   @brief  Header file of Linux u-dma-buf DMA buffer support.
+********************************************************************************
+ *   @copyright
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_DMA_BUF_H_
+#define LINUX_DMA_BUF_H_
+
+#include <stdbool.h>
+#include "dma_buf.h"
+
+/**
+ * @struct linux_dma_buf_init_param
+ * @brief Structure holding the initialization parameters for Linux platform
+ * specific DMA buffer region parameters. The region is a u-dma-buf device,
+ * its address and size are read from sysfs.
+ */
+struct linux_dma_buf_init_param {
+	/** u-dma-buf device name (/dev/"name"), e.g. "udmabuf0" */
+	const char *name;
+	/** Map the buffer uncached, no cache maintenance is done */
+	bool sync;
+};
+
+/**
+ * @brief Linux specific DMA buffer platform ops structure
+ */
+extern const struct dma_buf_platform_ops linux_dma_buf_platform_ops;
+
+#endif // LINUX_DMA_BUF_H_
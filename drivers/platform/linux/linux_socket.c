@@ -0,0 +1,646 @@
+/***************************************************************************//**
+ *   @file   linux_socket.c
+ *   @brief  Implementation of the Linux network interface over BSD sockets.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#define _GNU_SOURCE /* accept4() */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "error.h"
+#include "linux_socket.h"
+#include "util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Kernel send/receive buffer size requested when none is given */
+#define LINUX_SOCKET_DEFAULT_BUFF_SIZE	(4 * 1024 * 1024)
+/* Sockets with a higher file descriptor are not tracked in the ready map */
+#define LINUX_SOCKET_MAX_FDS		1024
+/* Events collected by one epoll_wait() call */
+#define LINUX_SOCKET_MAX_EVENTS		32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_socket_desc
+ * @brief Linux network interface descriptor, socket ids are file descriptors.
+ */
+struct linux_socket_desc {
+	/** Network interface handed to tcp_socket */
+	struct network_interface interface;
+	/** Local address servers are bound to */
+	struct in_addr bind_addr;
+	/** Time socket_recv waits before -EAGAIN */
+	uint32_t timeout_ms;
+	/** SO_SNDBUF/SO_RCVBUF of the TCP sockets */
+	int buff_size;
+	/** Listening and connected sockets, waited for input together */
+	int epoll_fd;
+	/** Sockets reported readable by epoll and not drained since */
+	uint8_t ready[LINUX_SOCKET_MAX_FDS / 8];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Negative errno of the last failed call, disconnections as -ENOTCONN */
+static int32_t linux_socket_error(void)
+{
+	switch (errno) {
+	case 0:
+		return FAILURE;
+	case EPIPE:
+	case ECONNRESET:
+		return -ENOTCONN;
+	case EWOULDBLOCK:
+		return -EAGAIN;
+	default:
+		return -errno;
+	}
+}
+
+/* Wait until fd is ready for events or timeout_ms (-1 forever) elapses */
+static int32_t linux_socket_wait(int fd, short events, int timeout_ms)
+{
+	struct pollfd pfd = {
+		.fd = fd,
+		.events = events,
+	};
+	int ret;
+
+	do {
+		ret = poll(&pfd, 1, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0)
+		return linux_socket_error();
+
+	return ret ? SUCCESS : -EAGAIN;
+}
+
+/* Untracked sockets are always reported as ready, the caller then tries */
+static bool linux_socket_is_ready(struct linux_socket_desc *desc, int fd)
+{
+	if (fd >= LINUX_SOCKET_MAX_FDS)
+		return true;
+
+	return desc->ready[fd / 8] & (1 << (fd % 8));
+}
+
+static void linux_socket_set_ready(struct linux_socket_desc *desc, int fd,
+				   bool ready)
+{
+	if (fd >= LINUX_SOCKET_MAX_FDS)
+		return;
+
+	if (ready)
+		desc->ready[fd / 8] |= 1 << (fd % 8);
+	else
+		desc->ready[fd / 8] &= ~(1 << (fd % 8));
+}
+
+/* Add a socket to the epoll set */
+static int32_t linux_socket_watch(struct linux_socket_desc *desc, int fd)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLRDHUP,
+		.data.fd = fd,
+	};
+
+	if (epoll_ctl(desc->epoll_fd, EPOLL_CTL_ADD, fd, &ev) &&
+	    errno != EEXIST)
+		return linux_socket_error();
+
+	linux_socket_set_ready(desc, fd, false);
+
+	return SUCCESS;
+}
+
+/*
+ * Mark the readable sockets of the epoll set, without waiting. A single call
+ * refreshes the state of all the sockets, so the accept calls of the idle
+ * listening sockets are skipped afterwards.
+ */
+static int32_t linux_socket_poll(struct linux_socket_desc *desc)
+{
+	struct epoll_event ev[LINUX_SOCKET_MAX_EVENTS];
+	int i, n;
+
+	do {
+		n = epoll_wait(desc->epoll_fd, ev, LINUX_SOCKET_MAX_EVENTS, 0);
+	} while (n < 0 && errno == EINTR);
+
+	if (n < 0)
+		return linux_socket_error();
+
+	for (i = 0; i < n; i++)
+		linux_socket_set_ready(desc, ev[i].data.fd, true);
+
+	return n;
+}
+
+/*
+ * Wait up to timeout_ms for fd to be readable. Only fd is waited for: the
+ * shared epoll set is level-triggered and would return at once while any
+ * other socket has unread data.
+ */
+static int32_t linux_socket_wait_readable(struct linux_socket_desc *desc,
+		int fd, uint32_t timeout_ms)
+{
+	int32_t ret;
+
+	ret = linux_socket_wait(fd, POLLIN | POLLRDHUP, timeout_ms);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	linux_socket_set_ready(desc, fd, true);
+
+	return SUCCESS;
+}
+
+/* Apply the low latency and throughput options of the TCP sockets */
+static int32_t linux_socket_tune(int fd, int buff_size)
+{
+	int on = 1;
+
+	/* Small IIO replies are written in pieces, don't hold them back */
+	if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)))
+		return linux_socket_error();
+
+	/* The kernel caps these to net.core.{w,r}mem_max */
+	if (setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buff_size,
+		       sizeof(buff_size)) ||
+	    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buff_size,
+		       sizeof(buff_size)))
+		return linux_socket_error();
+
+	return SUCCESS;
+}
+
+/* Resolve a socket_address into an IPv4 socket address */
+static int32_t linux_socket_resolve(const struct socket_address *addr,
+				    struct sockaddr_in *sin)
+{
+	struct addrinfo hints = {
+		.ai_family = AF_INET,
+	};
+	struct addrinfo *res;
+
+	if (!addr || !addr->addr)
+		return -EINVAL;
+
+	memset(sin, 0, sizeof(*sin));
+	sin->sin_family = AF_INET;
+	sin->sin_port = htons(addr->port);
+	if (inet_pton(AF_INET, addr->addr, &sin->sin_addr) == 1)
+		return SUCCESS;
+
+	if (getaddrinfo(addr->addr, NULL, &hints, &res))
+		return -EHOSTUNREACH;
+	sin->sin_addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr;
+	freeaddrinfo(res);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief See \ref network_interface.socket_open
+ *        buff_size is a minimum: the kernel buffers of a TCP socket are
+ *        the larger of buff_size and the interface buff_size.
+ */
+static int32_t linux_socket_open(struct linux_socket_desc *desc,
+				 uint32_t *sock_id,
+				 enum socket_protocol proto, uint32_t buff_size)
+{
+	int32_t ret;
+	int fd;
+
+	if (!desc || !sock_id)
+		return -EINVAL;
+
+	if (buff_size > INT_MAX)
+		return -EINVAL;
+
+	fd = socket(AF_INET, (proto == PROTOCOL_TCP ? SOCK_STREAM : SOCK_DGRAM) |
+		    SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return linux_socket_error();
+
+	if (proto == PROTOCOL_TCP) {
+		ret = linux_socket_tune(fd, max_t(int, buff_size,
+						  desc->buff_size));
+		if (IS_ERR_VALUE(ret)) {
+			close(fd);
+			return ret;
+		}
+	}
+
+	*sock_id = fd;
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_close */
+static int32_t linux_socket_close(struct linux_socket_desc *desc,
+				  uint32_t sock_id)
+{
+	epoll_ctl(desc->epoll_fd, EPOLL_CTL_DEL, sock_id, NULL);
+	linux_socket_set_ready(desc, sock_id, false);
+
+	if (close(sock_id))
+		return linux_socket_error();
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_connect */
+static int32_t linux_socket_connect(struct linux_socket_desc *desc,
+				    uint32_t sock_id,
+				    struct socket_address *addr)
+{
+	struct sockaddr_in sin;
+	int32_t ret;
+
+	ret = linux_socket_resolve(addr, &sin);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	if (connect(sock_id, (struct sockaddr *)&sin, sizeof(sin)))
+		return linux_socket_error();
+
+	if (fcntl(sock_id, F_SETFL, fcntl(sock_id, F_GETFL) | O_NONBLOCK))
+		return linux_socket_error();
+
+	return linux_socket_watch(desc, sock_id);
+}
+
+/** @brief See \ref network_interface.socket_disconnect */
+static int32_t linux_socket_disconnect(struct linux_socket_desc *desc,
+				       uint32_t sock_id)
+{
+	if (shutdown(sock_id, SHUT_RDWR) && errno != ENOTCONN)
+		return linux_socket_error();
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_send */
+static int32_t linux_socket_send(struct linux_socket_desc *desc,
+				 uint32_t sock_id,
+				 const void *data, uint32_t size)
+{
+	uint32_t sent = 0;
+	ssize_t ret;
+	int32_t err;
+
+	while (sent < size) {
+		ret = send(sock_id, (const uint8_t *)data + sent, size - sent,
+			   MSG_NOSIGNAL);
+		if (ret >= 0) {
+			sent += ret;
+			continue;
+		}
+		if (errno == EINTR)
+			continue;
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			return linux_socket_error();
+
+		err = linux_socket_wait(sock_id, POLLOUT, -1);
+		if (IS_ERR_VALUE(err))
+			return err;
+	}
+
+	return sent;
+}
+
+/** @brief See \ref network_interface.socket_recv */
+static int32_t linux_socket_recv(struct linux_socket_desc *desc,
+				 uint32_t sock_id,
+				 void *data, uint32_t size)
+{
+	bool waited = false;
+	ssize_t ret;
+	int32_t err;
+
+	while (true) {
+		ret = recv(sock_id, data, size, MSG_DONTWAIT);
+		if (ret > 0)
+			return ret;
+		if (ret == 0)
+			return -ENOTCONN;
+		if (errno == EINTR)
+			continue;
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			return linux_socket_error();
+
+		/* Drained, epoll has to report it again */
+		linux_socket_set_ready(desc, sock_id, false);
+		if (waited || !desc->timeout_ms)
+			return -EAGAIN;
+
+		err = linux_socket_wait_readable(desc, sock_id,
+						 desc->timeout_ms);
+		if (IS_ERR_VALUE(err))
+			return err;
+		waited = true;
+	}
+}
+
+/** @brief See \ref network_interface.socket_sendto */
+static int32_t linux_socket_sendto(struct linux_socket_desc *desc,
+				   uint32_t sock_id,
+				   const void *data, uint32_t size,
+				   const struct socket_address *to)
+{
+	struct sockaddr_in sin;
+	ssize_t ret;
+
+	ret = linux_socket_resolve(to, &sin);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = sendto(sock_id, data, size, MSG_NOSIGNAL,
+		     (struct sockaddr *)&sin, sizeof(sin));
+	if (ret < 0)
+		return linux_socket_error();
+
+	return ret;
+}
+
+/**
+ * @brief See \ref network_interface.socket_recvfrom
+ * from->addr, when set, must have room for INET_ADDRSTRLEN characters.
+ */
+static int32_t linux_socket_recvfrom(struct linux_socket_desc *desc,
+				     uint32_t sock_id,
+				     void *data, uint32_t size,
+				     struct socket_address *from)
+{
+	struct sockaddr_in sin;
+	socklen_t len = sizeof(sin);
+	ssize_t ret;
+
+	ret = recvfrom(sock_id, data, size, MSG_DONTWAIT,
+		       (struct sockaddr *)&sin, &len);
+	if (ret < 0)
+		return linux_socket_error();
+
+	if (from) {
+		from->port = ntohs(sin.sin_port);
+		if (from->addr)
+			inet_ntop(AF_INET, &sin.sin_addr, from->addr,
+				  INET_ADDRSTRLEN);
+	}
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_bind */
+static int32_t linux_socket_bind(struct linux_socket_desc *desc,
+				 uint32_t sock_id, uint16_t port)
+{
+	struct sockaddr_in sin = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr = desc->bind_addr,
+	};
+	int on = 1;
+
+	if (setsockopt(sock_id, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
+		return linux_socket_error();
+
+	if (bind(sock_id, (struct sockaddr *)&sin, sizeof(sin)))
+		return linux_socket_error();
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_listen */
+static int32_t linux_socket_listen(struct linux_socket_desc *desc,
+				   uint32_t sock_id, uint32_t back_log)
+{
+	if (listen(sock_id, back_log ? back_log : SOMAXCONN))
+		return linux_socket_error();
+
+	if (fcntl(sock_id, F_SETFL, fcntl(sock_id, F_GETFL) | O_NONBLOCK))
+		return linux_socket_error();
+
+	return linux_socket_watch(desc, sock_id);
+}
+
+/**
+ * @brief See \ref network_interface.socket_accept
+ *        Never waits: the server polls it between requests of the already
+ *        connected clients, so it is answered from the epoll state when no
+ *        connection is pending.
+ */
+static int32_t linux_socket_accept(struct linux_socket_desc *desc,
+				   uint32_t sock_id,
+				   uint32_t *client_socket_id)
+{
+	int32_t ret;
+	int fd;
+
+	if (!linux_socket_is_ready(desc, sock_id)) {
+		ret = linux_socket_poll(desc);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+		if (!linux_socket_is_ready(desc, sock_id))
+			return -EAGAIN;
+	}
+
+	do {
+		fd = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+	} while (fd < 0 && (errno == EINTR || errno == ECONNABORTED));
+
+	if (fd < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			linux_socket_set_ready(desc, sock_id, false);
+		return linux_socket_error();
+	}
+
+	/* Don't rely on the options inherited from the listening socket */
+	ret = linux_socket_tune(fd, desc->buff_size);
+	if (IS_ERR_VALUE(ret))
+		goto error;
+
+	ret = linux_socket_watch(desc, fd);
+	if (IS_ERR_VALUE(ret))
+		goto error;
+
+	*client_socket_id = fd;
+
+	return SUCCESS;
+error:
+	close(fd);
+
+	return ret;
+}
+
+/**
+ * @brief Initialize the Linux network interface.
+ * @param desc - Address where to store the descriptor.
+ * @param param - Initialization parameters.
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - Negative error code : Otherwise
+ */
+int32_t linux_socket_init(struct linux_socket_desc **desc,
+			  struct linux_socket_init_param *param)
+{
+	struct linux_socket_desc *ldesc;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	ldesc = (struct linux_socket_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	ldesc->bind_addr.s_addr = htonl(INADDR_ANY);
+	if (param->bind_addr &&
+	    inet_pton(AF_INET, param->bind_addr, &ldesc->bind_addr) != 1) {
+		free(ldesc);
+		return -EINVAL;
+	}
+	ldesc->timeout_ms = param->timeout_ms;
+	ldesc->buff_size = param->buff_size ? param->buff_size :
+			   LINUX_SOCKET_DEFAULT_BUFF_SIZE;
+
+	ldesc->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (ldesc->epoll_fd < 0) {
+		free(ldesc);
+		return linux_socket_error();
+	}
+
+	ldesc->interface.net = ldesc;
+	ldesc->interface.socket_open =
+		(int32_t (*)(void *, uint32_t *, enum socket_protocol,
+			     uint32_t))
+		linux_socket_open;
+	ldesc->interface.socket_close =
+		(int32_t (*)(void *, uint32_t))
+		linux_socket_close;
+	ldesc->interface.socket_connect =
+		(int32_t (*)(void *, uint32_t, struct socket_address *))
+		linux_socket_connect;
+	ldesc->interface.socket_disconnect =
+		(int32_t (*)(void *, uint32_t))
+		linux_socket_disconnect;
+	ldesc->interface.socket_send =
+		(int32_t (*)(void *, uint32_t, const void *, uint32_t))
+		linux_socket_send;
+	ldesc->interface.socket_recv =
+		(int32_t (*)(void *, uint32_t, void *, uint32_t))
+		linux_socket_recv;
+	ldesc->interface.socket_sendto =
+		(int32_t (*)(void *, uint32_t, const void *, uint32_t,
+			     const struct socket_address *))
+		linux_socket_sendto;
+	ldesc->interface.socket_recvfrom =
+		(int32_t (*)(void *, uint32_t, void *, uint32_t,
+			     struct socket_address *))
+		linux_socket_recvfrom;
+	ldesc->interface.socket_bind =
+		(int32_t (*)(void *, uint32_t, uint16_t))
+		linux_socket_bind;
+	ldesc->interface.socket_listen =
+		(int32_t (*)(void *, uint32_t, uint32_t))
+		linux_socket_listen;
+	ldesc->interface.socket_accept =
+		(int32_t (*)(void *, uint32_t, uint32_t *))
+		linux_socket_accept;
+
+	*desc = ldesc;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by linux_socket_init().
+ *        The sockets are owned and closed by their tcp_socket descriptors.
+ * @param desc - Linux network interface descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_socket_remove(struct linux_socket_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	close(desc->epoll_fd);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the network interface to be used by tcp_socket.
+ * @param desc - Linux network interface descriptor.
+ * @param net - Address where to store the network interface.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_socket_get_network_interface(struct linux_socket_desc *desc,
+		struct network_interface **net)
+{
+	if (!desc || !net)
+		return -EINVAL;
+
+	*net = &desc->interface;
+
+	return SUCCESS;
+}
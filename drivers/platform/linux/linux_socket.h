@@ -0,0 +1,94 @@
+/***************************************************************************//**
+ *   @file   linux_socket.h
+ *   @brief  Header file of the Linux network interface over BSD sockets.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_SOCKET_H_
+#define LINUX_SOCKET_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "network_interface.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_socket_desc
+ * @brief Linux network interface descriptor
+ */
+struct linux_socket_desc;
+
+/**
+ * @struct linux_socket_init_param
+ * @brief Linux network interface parameters
+ */
+struct linux_socket_init_param {
+	/** Local IPv4 address servers are bound to, NULL for all interfaces */
+	const char *bind_addr;
+	/**
+	 * Time socket_recv waits for data before returning -EAGAIN.
+	 * 0 makes it return immediately.
+	 */
+	uint32_t timeout_ms;
+	/**
+	 * SO_SNDBUF/SO_RCVBUF of the TCP sockets, 0 for 4 MiB. Sockets opened
+	 * with a larger buff_size use that instead. The kernel caps it to
+	 * net.core.wmem_max/rmem_max.
+	 */
+	uint32_t buff_size;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Initialize the Linux network interface. */
+int32_t linux_socket_init(struct linux_socket_desc **desc,
+			  struct linux_socket_init_param *param);
+
+/* Free the resources allocated by linux_socket_init(). */
+int32_t linux_socket_remove(struct linux_socket_desc *desc);
+
+/* Get the network interface to be used by tcp_socket. */
+int32_t linux_socket_get_network_interface(struct linux_socket_desc *desc,
+		struct network_interface **net);
+
+#endif // LINUX_SOCKET_H_
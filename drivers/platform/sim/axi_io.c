@@ -0,0 +1,222 @@
+/***************************************************************************//**
+ *   @file   sim/axi_io.c
+ *   @brief  Implementation of the host simulation platform AXI IO driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "error.h"
+#include "axi_io.h"
+#include "sim_axi_io.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_axi_io_region
+ * @brief Simulated AXI address range
+ */
+struct sim_axi_io_region {
+	/** First address */
+	uint32_t base;
+	/** Size in bytes */
+	uint32_t size;
+	/** Register model, one 32-bit register every 4 bytes */
+	struct sim_regmap *map;
+	/** Memory backing the range, when map is NULL */
+	uint8_t *mem;
+};
+
+static struct sim_axi_io_region sim_axi_io_regions[SIM_AXI_IO_MAX_REGIONS];
+static uint32_t sim_axi_io_num_regions;
+static struct sim_axi_io_stats sim_axi_io_stats;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Add an address range.
+ * @param base - First address.
+ * @param size - Size in bytes.
+ * @param map - Register model.
+ * @param mem - Memory buffer.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_axi_io_add(uint32_t base, uint32_t size,
+			      struct sim_regmap *map, void *mem)
+{
+	struct sim_axi_io_region *region;
+
+	/* A region holds at least one 32-bit register */
+	if (size < 4 || sim_axi_io_num_regions >= SIM_AXI_IO_MAX_REGIONS)
+		return FAILURE;
+
+	region = &sim_axi_io_regions[sim_axi_io_num_regions++];
+	region->base = base;
+	region->size = size;
+	region->map = map;
+	region->mem = mem;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Back an AXI core address range with a 32-bit register map model.
+ * @param base - First address, as used by the driver.
+ * @param size - Size in bytes.
+ * @param map - Register model with at least size / 4 registers.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_axi_io_register_regmap(uint32_t base, uint32_t size,
+				   struct sim_regmap *map)
+{
+	if (!map || map->num_regs < size / 4)
+		return FAILURE;
+
+	return sim_axi_io_add(base, size, map, NULL);
+}
+
+/**
+ * @brief Back an AXI address range (e.g. DMA memory) with a host buffer.
+ * @param base - First address, as used by the driver.
+ * @param size - Size in bytes.
+ * @param mem - Host buffer of at least size bytes.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_axi_io_register_mem(uint32_t base, uint32_t size, void *mem)
+{
+	if (!mem)
+		return FAILURE;
+
+	return sim_axi_io_add(base, size, NULL, mem);
+}
+
+/**
+ * @brief Remove all the registered regions and clear the statistics.
+ */
+void sim_axi_io_reset(void)
+{
+	sim_axi_io_num_regions = 0;
+	memset(&sim_axi_io_stats, 0, sizeof(sim_axi_io_stats));
+}
+
+/**
+ * @brief Get the AXI IO traffic.
+ * @param stats - Traffic counters.
+ */
+void sim_axi_io_get_stats(struct sim_axi_io_stats *stats)
+{
+	*stats = sim_axi_io_stats;
+}
+
+/**
+ * @brief Find the region of an address.
+ * @param addr - Address.
+ * @return The region, NULL if addr is not mapped.
+ */
+static struct sim_axi_io_region *sim_axi_io_find(uint32_t addr)
+{
+	uint32_t i;
+
+	for (i = 0; i < sim_axi_io_num_regions; i++)
+		if (addr >= sim_axi_io_regions[i].base &&
+		    (uint64_t)(addr - sim_axi_io_regions[i].base) + 4 <=
+		    sim_axi_io_regions[i].size)
+			return &sim_axi_io_regions[i];
+
+	sim_axi_io_stats.unmapped++;
+
+	return NULL;
+}
+
+/**
+ * @brief AXI IO read function.
+ * @param base - Base address.
+ * @param offset - Address offset.
+ * @param data - Location where read data will be stored.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	struct sim_axi_io_region *region;
+	uint32_t addr = base + offset;
+
+	sim_axi_io_stats.reads++;
+
+	region = sim_axi_io_find(addr);
+	if (!region)
+		return FAILURE;
+
+	if (region->map)
+		return sim_regmap_read(region->map, (addr - region->base) / 4,
+				       data);
+
+	memcpy(data, region->mem + (addr - region->base), sizeof(*data));
+
+	return SUCCESS;
+}
+
+/**
+ * @brief AXI IO write function.
+ * @param base - Base address.
+ * @param offset - Address offset.
+ * @param data - Data to be written.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	struct sim_axi_io_region *region;
+	uint32_t addr = base + offset;
+
+	sim_axi_io_stats.writes++;
+
+	region = sim_axi_io_find(addr);
+	if (!region)
+		return FAILURE;
+
+	if (region->map)
+		return sim_regmap_write(region->map, (addr - region->base) / 4,
+					data);
+
+	memcpy(region->mem + (addr - region->base), &data, sizeof(data));
+
+	return SUCCESS;
+}
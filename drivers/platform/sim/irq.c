@@ -0,0 +1,302 @@
+/***************************************************************************//**
+ *   @file   sim/irq.c
+ *   @brief  Implementation of the host simulation platform IRQ driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "error.h"
+#include "irq.h"
+#include "irq_extra.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_irq_desc
+ * @brief Host simulation platform specific IRQ descriptor
+ */
+struct sim_irq_desc {
+	/** Global interrupt enable */
+	bool global_enable;
+	/** Per line enable */
+	bool enable[SIM_IRQ_MAX];
+	/** Per line trigger level, informative */
+	enum irq_trig_level trig[SIM_IRQ_MAX];
+	/** Registered callbacks */
+	struct callback_desc callbacks[SIM_IRQ_MAX];
+	/** Number of delivered interrupts per line */
+	uint32_t count[SIM_IRQ_MAX];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the IRQ interrupts.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ parameters.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
+		      const struct irq_init_param *param)
+{
+	struct irq_ctrl_desc *descriptor;
+
+	if (!param)
+		return FAILURE;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->extra = calloc(1, sizeof(struct sim_irq_desc));
+	if (!descriptor->extra) {
+		free(descriptor);
+		return FAILURE;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by irq_ctrl_init().
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_ctrl_remove(struct irq_ctrl_desc *desc)
+{
+	if (!desc)
+		return FAILURE;
+
+	free(desc->extra);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Register a callback to handle the irq events.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param callback_desc - Callback descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_register_callback(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			      struct callback_desc *callback_desc)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || !callback_desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->callbacks[irq_id] = *callback_desc;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Unregister the callback of an interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_unregister(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->callbacks[irq_id].callback = NULL;
+	sim_desc->enable[irq_id] = false;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Global interrupt enable.
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_global_enable(struct irq_ctrl_desc *desc)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->global_enable = true;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Global interrupt disable.
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_global_disable(struct irq_ctrl_desc *desc)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->global_enable = false;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set interrupt trigger level.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param trig - Trigger level.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_trigger_level_set(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			      enum irq_trig_level trig)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->trig[irq_id] = trig;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Enable a specific interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_enable(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->enable[irq_id] = true;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Disable a specific interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t irq_disable(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	sim_desc->enable[irq_id] = false;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Raise an interrupt line. The callback runs synchronously if the
+ * line and the controller are enabled.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param event - Event passed to the callback.
+ * @return SUCCESS if the callback was called, FAILURE otherwise.
+ */
+int32_t sim_irq_trigger(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			uint32_t event)
+{
+	struct sim_irq_desc *sim_desc;
+	struct callback_desc *cb;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return FAILURE;
+
+	sim_desc = desc->extra;
+	cb = &sim_desc->callbacks[irq_id];
+	if (!sim_desc->global_enable || !sim_desc->enable[irq_id] ||
+	    !cb->callback)
+		return FAILURE;
+
+	sim_desc->count[irq_id]++;
+	cb->callback(cb->ctx, event, cb->config);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the number of times an interrupt was delivered to its callback.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return Number of delivered interrupts.
+ */
+uint32_t sim_irq_get_count(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct sim_irq_desc *sim_desc;
+
+	if (!desc || irq_id >= SIM_IRQ_MAX)
+		return 0;
+
+	sim_desc = desc->extra;
+
+	return sim_desc->count[irq_id];
+}
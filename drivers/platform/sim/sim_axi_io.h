@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ *   @file   sim/sim_axi_io.h
+ *   @brief  Header file of the host simulation platform AXI IO driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_AXI_IO_H_
+#define SIM_AXI_IO_H_
+
+#include <stdint.h>
+#include "sim_regmap.h"
+
+/** Number of AXI regions that can be registered */
+#define SIM_AXI_IO_MAX_REGIONS	16
+
+/**
+ * @struct sim_axi_io_stats
+ * @brief AXI IO traffic.
+ */
+struct sim_axi_io_stats {
+	/** Number of axi_io_read() calls */
+	uint32_t reads;
+	/** Number of axi_io_write() calls */
+	uint32_t writes;
+	/** Accesses outside any registered region */
+	uint32_t unmapped;
+};
+
+/* Back an AXI core address range with a 32-bit register map model. */
+int32_t sim_axi_io_register_regmap(uint32_t base, uint32_t size,
+				   struct sim_regmap *map);
+
+/* Back an AXI address range (e.g. DMA memory) with a host buffer. */
+int32_t sim_axi_io_register_mem(uint32_t base, uint32_t size, void *mem);
+
+/* Remove all the registered regions and clear the statistics. */
+void sim_axi_io_reset(void);
+
+/* Get the AXI IO traffic. */
+void sim_axi_io_get_stats(struct sim_axi_io_stats *stats);
+
+#endif // SIM_AXI_IO_H_
@@ -0,0 +1,287 @@
+/***************************************************************************//**
+ *   @file   sim/sim_gpio.c
+ *   @brief  Implementation of the host simulation platform GPIO driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "gpio.h"
+#include "sim_gpio.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_gpio_line
+ * @brief State of a simulated GPIO line
+ */
+struct sim_gpio_line {
+	/** GPIO_IN or GPIO_OUT */
+	uint8_t direction;
+	/** Level driven by the driver */
+	uint8_t output;
+	/** Level driven by the simulated device */
+	uint8_t input;
+	/** Number of output level changes */
+	uint32_t toggles;
+};
+
+static struct sim_gpio_line sim_gpio_lines[SIM_GPIO_MAX];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Get the state of a GPIO line.
+ * @param number - The GPIO number.
+ * @return The line, NULL if number is out of range.
+ */
+static struct sim_gpio_line *sim_gpio_line(int32_t number)
+{
+	if (number < 0 || number >= SIM_GPIO_MAX)
+		return NULL;
+
+	return &sim_gpio_lines[number];
+}
+
+/**
+ * @brief Obtain the GPIO decriptor.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_get(struct gpio_desc **desc,
+			    const struct gpio_init_param *param)
+{
+	struct gpio_desc *descriptor;
+
+	if (!param || !sim_gpio_line(param->number))
+		return FAILURE;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->number = param->number;
+	descriptor->extra = sim_gpio_line(param->number);
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the value of an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters, may be NULL.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_get_optional(struct gpio_desc **desc,
+				     const struct gpio_init_param *param)
+{
+	if (!param) {
+		*desc = NULL;
+		return SUCCESS;
+	}
+
+	return sim_gpio_get(desc, param);
+}
+
+/**
+ * @brief Free the resources allocated by sim_gpio_get().
+ * @param desc - The GPIO descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_remove(struct gpio_desc *desc)
+{
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_direction_input(struct gpio_desc *desc)
+{
+	struct sim_gpio_line *line = desc->extra;
+
+	line->direction = GPIO_IN;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_direction_output(struct gpio_desc *desc,
+		uint8_t value)
+{
+	struct sim_gpio_line *line = desc->extra;
+
+	line->direction = GPIO_OUT;
+	if (line->output != value)
+		line->toggles++;
+	line->output = value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_get_direction(struct gpio_desc *desc,
+				      uint8_t *direction)
+{
+	struct sim_gpio_line *line = desc->extra;
+
+	*direction = line->direction;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_set_value(struct gpio_desc *desc, uint8_t value)
+{
+	struct sim_gpio_line *line;
+
+	/* Optional GPIOs that were not requested are ignored */
+	if (!desc)
+		return SUCCESS;
+
+	line = desc->extra;
+	if (line->output != value)
+		line->toggles++;
+	line->output = value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_gpio_get_value(struct gpio_desc *desc, uint8_t *value)
+{
+	struct sim_gpio_line *line = desc->extra;
+
+	*value = (line->direction == GPIO_OUT) ? line->output : line->input;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Drive the level seen by the driver on an input GPIO.
+ * @param number - The GPIO number.
+ * @param value - The level.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_gpio_set_input(int32_t number, uint8_t value)
+{
+	struct sim_gpio_line *line = sim_gpio_line(number);
+
+	if (!line)
+		return FAILURE;
+
+	line->input = value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the level driven by the driver on an output GPIO.
+ * @param number - The GPIO number.
+ * @param value - The level.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_gpio_get_output(int32_t number, uint8_t *value)
+{
+	struct sim_gpio_line *line = sim_gpio_line(number);
+
+	if (!line)
+		return FAILURE;
+
+	*value = line->output;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the number of level changes driven on a GPIO.
+ * @param number - The GPIO number.
+ * @return Number of level changes.
+ */
+uint32_t sim_gpio_get_toggles(int32_t number)
+{
+	struct sim_gpio_line *line = sim_gpio_line(number);
+
+	return line ? line->toggles : 0;
+}
+
+/**
+ * @brief Host simulation platform GPIO platform ops structure
+ */
+const struct gpio_platform_ops sim_gpio_platform_ops = {
+	.gpio_ops_get = &sim_gpio_get,
+	.gpio_ops_get_optional = &sim_gpio_get_optional,
+	.gpio_ops_remove = &sim_gpio_remove,
+	.gpio_ops_direction_input = &sim_gpio_direction_input,
+	.gpio_ops_direction_output = &sim_gpio_direction_output,
+	.gpio_ops_get_direction = &sim_gpio_get_direction,
+	.gpio_ops_set_value = &sim_gpio_set_value,
+	.gpio_ops_get_value = &sim_gpio_get_value
+};
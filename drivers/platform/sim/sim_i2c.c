@@ -0,0 +1,191 @@
+/***************************************************************************//**
+ *   @file   sim/sim_i2c.c
+ *   @brief  Implementation of the host simulation platform I2C driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "i2c.h"
+#include "sim_i2c.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the I2C communication peripheral.
+ * @param desc - The I2C descriptor.
+ * @param param - The structure that contains the I2C parameters. The extra
+ *                field must point to a struct sim_i2c_model.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_i2c_init(struct i2c_desc **desc,
+			    const struct i2c_init_param *param)
+{
+	struct i2c_desc *descriptor;
+	struct sim_i2c_model *model;
+
+	if (!param || !param->extra)
+		return FAILURE;
+
+	model = param->extra;
+	if ((!model->write || !model->read) && !model->map)
+		return FAILURE;
+
+	if (!model->reg_addr_bytes)
+		model->reg_addr_bytes = 1;
+	if (!model->reg_bytes)
+		model->reg_bytes = 1;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->slave_address = param->slave_address;
+	descriptor->extra = model;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by sim_i2c_init().
+ * @param desc - The I2C descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_i2c_remove(struct i2c_desc *desc)
+{
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write data to the device model.
+ * @param desc - The I2C descriptor.
+ * @param data - The buffer with the transmitted data.
+ * @param bytes_number - Number of bytes to write.
+ * @param stop_bit - Stop condition control.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_i2c_write(struct i2c_desc *desc,
+			     uint8_t *data,
+			     uint8_t bytes_number,
+			     uint8_t stop_bit)
+{
+	struct sim_i2c_model *model = desc->extra;
+	uint32_t val;
+	uint8_t i, j;
+	int32_t ret;
+
+	model->transfers++;
+	model->bytes += bytes_number;
+
+	if (model->write)
+		return model->write(model, data, bytes_number, stop_bit);
+
+	if (bytes_number < model->reg_addr_bytes)
+		return FAILURE;
+
+	model->reg_ptr = 0;
+	for (i = 0; i < model->reg_addr_bytes; i++)
+		model->reg_ptr = (model->reg_ptr << 8) | data[i];
+
+	while (i + model->reg_bytes <= bytes_number) {
+		val = 0;
+		for (j = 0; j < model->reg_bytes; j++)
+			val = (val << 8) | data[i++];
+
+		ret = sim_regmap_write(model->map, model->reg_ptr++, val);
+		if (ret != SUCCESS)
+			return ret;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read data from the device model.
+ * @param desc - The I2C descriptor.
+ * @param data - The buffer with the received data.
+ * @param bytes_number - Number of bytes to read.
+ * @param stop_bit - Stop condition control.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_i2c_read(struct i2c_desc *desc,
+			    uint8_t *data,
+			    uint8_t bytes_number,
+			    uint8_t stop_bit)
+{
+	struct sim_i2c_model *model = desc->extra;
+	uint32_t val = 0;
+	uint8_t i, j;
+	int32_t ret;
+
+	model->transfers++;
+	model->bytes += bytes_number;
+
+	if (model->read)
+		return model->read(model, data, bytes_number, stop_bit);
+
+	for (i = 0; i < bytes_number; i += model->reg_bytes) {
+		ret = sim_regmap_read(model->map, model->reg_ptr++, &val);
+		if (ret != SUCCESS)
+			return ret;
+
+		for (j = model->reg_bytes; j > 0; j--)
+			if (i + j - 1 < bytes_number)
+				data[i + j - 1] = val >> (8 * (model->reg_bytes - j));
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Host simulation platform I2C platform ops structure
+ */
+const struct i2c_platform_ops sim_i2c_platform_ops = {
+	.i2c_ops_init = &sim_i2c_init,
+	.i2c_ops_write = &sim_i2c_write,
+	.i2c_ops_read = &sim_i2c_read,
+	.i2c_ops_remove = &sim_i2c_remove
+};
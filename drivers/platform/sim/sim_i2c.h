@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ *   @file   sim/sim_i2c.h
+ *   @brief  Header file of the host simulation platform I2C driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_I2C_H_
+#define SIM_I2C_H_
+
+#include <stdint.h>
+#include "sim_regmap.h"
+
+/**
+ * @struct sim_i2c_model
+ * @brief I2C device model, passed as i2c_init_param.extra.
+ *
+ * The generic model implements the usual register pointer protocol: a write
+ * starts with reg_addr_bytes of register address followed by data bytes,
+ * a read returns data starting at the last written register address. Each
+ * register is reg_bytes wide, MSB first, and the address auto-increments.
+ */
+struct sim_i2c_model {
+	/** Register map of the device */
+	struct sim_regmap *map;
+	/** Number of register address bytes (1 or 2) */
+	uint8_t reg_addr_bytes;
+	/** Number of bytes of each register (1 to 4) */
+	uint8_t reg_bytes;
+	/** Custom write handler, replaces the generic protocol when set */
+	int32_t (*write)(struct sim_i2c_model *model, uint8_t *data,
+			 uint8_t bytes_number, uint8_t stop_bit);
+	/** Custom read handler, replaces the generic protocol when set */
+	int32_t (*read)(struct sim_i2c_model *model, uint8_t *data,
+			uint8_t bytes_number, uint8_t stop_bit);
+	/** Model private data */
+	void *priv;
+	/** Register pointer (runtime state) */
+	uint32_t reg_ptr;
+	/** Number of transfers */
+	uint32_t transfers;
+	/** Number of bytes transferred */
+	uint64_t bytes;
+};
+
+/**
+ * @brief Host simulation platform I2C platform ops structure
+ */
+extern const struct i2c_platform_ops sim_i2c_platform_ops;
+
+#endif // SIM_I2C_H_
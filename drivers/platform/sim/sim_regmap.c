@@ -0,0 +1,218 @@
+/***************************************************************************//**
+ *   @file   sim/sim_regmap.c
+ *   @brief  Register map models used by the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "sim_regmap.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Allocate a register map model.
+ * @param map - The register map.
+ * @param param - The register map parameters.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_regmap_init(struct sim_regmap **map,
+			const struct sim_regmap_init_param *param)
+{
+	struct sim_regmap *m;
+
+	if (!map || !param || !param->num_regs)
+		return FAILURE;
+
+	m = calloc(1, sizeof(*m));
+	if (!m)
+		return FAILURE;
+
+	m->regs = calloc(param->num_regs, sizeof(*m->regs));
+	if (!m->regs) {
+		free(m);
+		return FAILURE;
+	}
+
+	m->num_regs = param->num_regs;
+	m->rules = param->rules;
+	m->num_rules = param->num_rules;
+	m->read_hook = param->read_hook;
+	m->write_hook = param->write_hook;
+	m->priv = param->priv;
+	sim_regmap_reset(m, param->defaults);
+
+	*map = m;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by sim_regmap_init().
+ * @param map - The register map.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_regmap_remove(struct sim_regmap *map)
+{
+	if (!map)
+		return FAILURE;
+
+	free(map->regs);
+	free(map);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Restore the reset values and clear the access counters.
+ * @param map - The register map.
+ * @param defaults - Reset values, NULL for all 0.
+ */
+void sim_regmap_reset(struct sim_regmap *map, const uint32_t *defaults)
+{
+	uint32_t i;
+
+	if (defaults)
+		memcpy(map->regs, defaults, map->num_regs * sizeof(*map->regs));
+	else
+		memset(map->regs, 0, map->num_regs * sizeof(*map->regs));
+
+	for (i = 0; i < map->num_rules; i++)
+		map->rules[i].pending = map->rules[i].delay_reads;
+
+	map->reads = 0;
+	map->writes = 0;
+}
+
+/**
+ * @brief Read a register as seen by the driver.
+ * @param map - The register map.
+ * @param addr - Register address.
+ * @param val - Register value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_regmap_read(struct sim_regmap *map, uint32_t addr, uint32_t *val)
+{
+	struct sim_regmap_rule *rule;
+	uint32_t value;
+	uint32_t i;
+
+	if (!map || addr >= map->num_regs)
+		return FAILURE;
+
+	map->reads++;
+	value = map->regs[addr];
+
+	for (i = 0; i < map->num_rules; i++) {
+		rule = &map->rules[i];
+		if (rule->addr != addr)
+			continue;
+
+		switch (rule->type) {
+		case SIM_REGMAP_FORCE:
+			value = (value & ~rule->mask) | (rule->value & rule->mask);
+			break;
+		case SIM_REGMAP_SELF_CLEAR:
+			if (rule->pending) {
+				rule->pending--;
+				break;
+			}
+			map->regs[addr] &= ~rule->mask;
+			value &= ~rule->mask;
+			break;
+		case SIM_REGMAP_SET_AFTER:
+			if (rule->pending) {
+				rule->pending--;
+				break;
+			}
+			value = (value & ~rule->mask) | (rule->value & rule->mask);
+			break;
+		case SIM_REGMAP_CLEAR_ON_READ:
+			map->regs[addr] &= ~rule->mask;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (map->read_hook)
+		if (map->read_hook(map, addr, &value) != SUCCESS)
+			return FAILURE;
+
+	*val = value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write a register as done by the driver.
+ * @param map - The register map.
+ * @param addr - Register address.
+ * @param val - Register value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_regmap_write(struct sim_regmap *map, uint32_t addr, uint32_t val)
+{
+	struct sim_regmap_rule *rule;
+	uint32_t i;
+
+	if (!map || addr >= map->num_regs)
+		return FAILURE;
+
+	map->writes++;
+
+	if (map->write_hook)
+		if (map->write_hook(map, addr, &val) != SUCCESS)
+			return FAILURE;
+
+	/* A new write restarts the busy/ready countdowns of the register */
+	for (i = 0; i < map->num_rules; i++) {
+		rule = &map->rules[i];
+		if (rule->addr == addr && (rule->type == SIM_REGMAP_SELF_CLEAR ||
+					   rule->type == SIM_REGMAP_SET_AFTER))
+			rule->pending = rule->delay_reads;
+	}
+
+	map->regs[addr] = val;
+
+	return SUCCESS;
+}
@@ -0,0 +1,158 @@
+/***************************************************************************//**
+ *   @file   sim/sim_regmap.h
+ *   @brief  Register map models used by the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_REGMAP_H_
+#define SIM_REGMAP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum sim_regmap_rule_type
+ * @brief Scripted behaviour applied to register bits.
+ */
+enum sim_regmap_rule_type {
+	/** Bits in mask always read as value (IDs, lock and ready flags) */
+	SIM_REGMAP_FORCE,
+	/** Bits in mask written to 1 clear after delay_reads reads (start/busy) */
+	SIM_REGMAP_SELF_CLEAR,
+	/** Bits in mask read as value after delay_reads reads of the register */
+	SIM_REGMAP_SET_AFTER,
+	/** Bits in mask clear after each read (latched status) */
+	SIM_REGMAP_CLEAR_ON_READ,
+};
+
+/**
+ * @struct sim_regmap_rule
+ * @brief Scripted response of a register.
+ */
+struct sim_regmap_rule {
+	/** Register address */
+	uint32_t addr;
+	/** Behaviour */
+	enum sim_regmap_rule_type type;
+	/** Affected bits */
+	uint32_t mask;
+	/** Value of the affected bits, where applicable */
+	uint32_t value;
+	/** Number of reads before the rule takes effect */
+	uint32_t delay_reads;
+	/** Reads left before the rule takes effect (runtime state) */
+	uint32_t pending;
+};
+
+struct sim_regmap;
+
+/**
+ * @struct sim_regmap_init_param
+ * @brief Register map model parameters.
+ */
+struct sim_regmap_init_param {
+	/** Number of registers, addresses go from 0 to num_regs - 1 */
+	uint32_t num_regs;
+	/** Reset values, may be NULL for all 0 */
+	const uint32_t *defaults;
+	/** Scripted responses, may be NULL */
+	struct sim_regmap_rule *rules;
+	/** Number of scripted responses */
+	uint32_t num_rules;
+	/** Custom read behaviour, called after the rules are applied */
+	int32_t (*read_hook)(struct sim_regmap *map, uint32_t addr,
+			     uint32_t *val);
+	/** Custom write behaviour, called before the value is stored */
+	int32_t (*write_hook)(struct sim_regmap *map, uint32_t addr,
+			      uint32_t *val);
+	/** Model private data */
+	void *priv;
+};
+
+/**
+ * @struct sim_regmap
+ * @brief Register map model.
+ */
+struct sim_regmap {
+	/** Number of registers */
+	uint32_t num_regs;
+	/** Register values */
+	uint32_t *regs;
+	/** Scripted responses */
+	struct sim_regmap_rule *rules;
+	/** Number of scripted responses */
+	uint32_t num_rules;
+	/** Custom read behaviour */
+	int32_t (*read_hook)(struct sim_regmap *map, uint32_t addr,
+			     uint32_t *val);
+	/** Custom write behaviour */
+	int32_t (*write_hook)(struct sim_regmap *map, uint32_t addr,
+			      uint32_t *val);
+	/** Model private data */
+	void *priv;
+	/** Number of register reads */
+	uint32_t reads;
+	/** Number of register writes */
+	uint32_t writes;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Allocate a register map model. */
+int32_t sim_regmap_init(struct sim_regmap **map,
+			const struct sim_regmap_init_param *param);
+
+/* Free the resources allocated by sim_regmap_init(). */
+int32_t sim_regmap_remove(struct sim_regmap *map);
+
+/* Read a register as seen by the driver. */
+int32_t sim_regmap_read(struct sim_regmap *map, uint32_t addr, uint32_t *val);
+
+/* Write a register as done by the driver. */
+int32_t sim_regmap_write(struct sim_regmap *map, uint32_t addr, uint32_t val);
+
+/* Restore the reset values and clear the access counters. */
+void sim_regmap_reset(struct sim_regmap *map, const uint32_t *defaults);
+
+#endif // SIM_REGMAP_H_
@@ -0,0 +1,195 @@
+/***************************************************************************//**
+ *   @file   sim/sim_spi.c
+ *   @brief  Implementation of the host simulation platform SPI driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "spi.h"
+#include "sim_spi.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Transfer handler decoding model->protocol.
+ * @param model - The SPI device model.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sim_spi_protocol_xfer(struct sim_spi_model *model, uint8_t *data,
+			      uint16_t bytes_number)
+{
+	struct sim_spi_protocol *proto = &model->protocol;
+	uint32_t instr = 0;
+	uint32_t addr;
+	uint32_t mask;
+	uint32_t val;
+	uint16_t i;
+	uint8_t read;
+	int32_t ret;
+
+	if (bytes_number < proto->instr_bytes)
+		return FAILURE;
+
+	for (i = 0; i < proto->instr_bytes; i++)
+		instr = (instr << 8) | data[i];
+
+	read = ((instr & proto->rw_mask) == proto->read_value);
+	addr = instr & proto->addr_mask;
+	for (mask = proto->addr_mask; mask && !(mask & 1); mask >>= 1)
+		addr >>= 1;
+
+	if (proto->addr_step == 0) {
+		/* One register spread over the payload, MSB first */
+		if (read) {
+			ret = sim_regmap_read(model->map, addr, &val);
+			if (ret != SUCCESS)
+				return ret;
+			for (i = bytes_number; i > proto->instr_bytes; i--) {
+				data[i - 1] = val & 0xFF;
+				val >>= 8;
+			}
+		} else {
+			val = 0;
+			for (i = proto->instr_bytes; i < bytes_number; i++)
+				val = (val << 8) | data[i];
+			ret = sim_regmap_write(model->map, addr, val);
+			if (ret != SUCCESS)
+				return ret;
+		}
+
+		return SUCCESS;
+	}
+
+	for (i = proto->instr_bytes; i < bytes_number; i++) {
+		if (read) {
+			ret = sim_regmap_read(model->map, addr, &val);
+			data[i] = val;
+		} else {
+			ret = sim_regmap_write(model->map, addr, data[i]);
+		}
+		if (ret != SUCCESS)
+			return ret;
+		addr += proto->addr_step;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Initialize the SPI communication peripheral.
+ * @param desc - The SPI descriptor.
+ * @param param - The structure that contains the SPI parameters. The extra
+ *                field must point to a struct sim_spi_model.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_spi_init(struct spi_desc **desc,
+			    const struct spi_init_param *param)
+{
+	struct spi_desc *descriptor;
+	struct sim_spi_model *model;
+
+	if (!param || !param->extra)
+		return FAILURE;
+
+	model = param->extra;
+	if (!model->xfer && !model->map)
+		return FAILURE;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->chip_select = param->chip_select;
+	descriptor->mode = param->mode;
+	descriptor->bit_order = param->bit_order;
+	descriptor->extra = model;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write and read data to/from the device model.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_spi_write_and_read(struct spi_desc *desc,
+				      uint8_t *data,
+				      uint16_t bytes_number)
+{
+	struct sim_spi_model *model = desc->extra;
+
+	model->transfers++;
+	model->bytes += bytes_number;
+
+	if (model->xfer)
+		return model->xfer(model, data, bytes_number);
+
+	return sim_spi_protocol_xfer(model, data, bytes_number);
+}
+
+/**
+ * @brief Free the resources allocated by sim_spi_init().
+ * @param desc - The SPI descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t sim_spi_remove(struct spi_desc *desc)
+{
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Host simulation platform SPI platform ops structure
+ */
+const struct spi_platform_ops sim_spi_platform_ops = {
+	.spi_ops_init = &sim_spi_init,
+	.spi_ops_write_and_read = &sim_spi_write_and_read,
+	.spi_ops_remove = &sim_spi_remove
+};
@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ *   @file   sim/sim_spi.h
+ *   @brief  Header file of the host simulation platform SPI driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_SPI_H_
+#define SIM_SPI_H_
+
+#include <stdint.h>
+#include "sim_regmap.h"
+
+/**
+ * @struct sim_spi_protocol
+ * @brief Register access protocol decoded by the generic SPI device model.
+ *
+ * The instruction word is made of the first instr_bytes bytes, MSB first.
+ * The transfer is a read when (instruction & rw_mask) == read_value.
+ */
+struct sim_spi_protocol {
+	/** Number of instruction bytes (1 or 2) */
+	uint8_t instr_bytes;
+	/** Read/write bit(s) of the instruction */
+	uint32_t rw_mask;
+	/** Value of the rw_mask bits for a read */
+	uint32_t read_value;
+	/** Address bits of the instruction */
+	uint32_t addr_mask;
+	/**
+	 * Address increment between data bytes of a multi-byte transfer
+	 * (1 or -1). 0 means the whole payload is a single register, MSB first.
+	 */
+	int8_t addr_step;
+};
+
+/**
+ * @struct sim_spi_model
+ * @brief SPI device model, passed as spi_init_param.extra.
+ */
+struct sim_spi_model {
+	/** Register map of the device */
+	struct sim_regmap *map;
+	/** Protocol used to access map */
+	struct sim_spi_protocol protocol;
+	/**
+	 * Custom transfer handler, replaces the protocol decoding when set.
+	 * data holds the transmitted bytes and receives the answer.
+	 */
+	int32_t (*xfer)(struct sim_spi_model *model, uint8_t *data,
+			uint16_t bytes_number);
+	/** Model private data */
+	void *priv;
+	/** Number of transfers */
+	uint32_t transfers;
+	/** Number of bytes transferred */
+	uint64_t bytes;
+};
+
+/* Transfer handler decoding model->protocol. */
+int32_t sim_spi_protocol_xfer(struct sim_spi_model *model, uint8_t *data,
+			      uint16_t bytes_number);
+
+/**
+ * @brief Host simulation platform SPI platform ops structure
+ */
+extern const struct spi_platform_ops sim_spi_platform_ops;
+
+#endif // SIM_SPI_H_
@@ -0,0 +1,198 @@
+/***************************************************************************//**
+ *   @file   sim/sim_uart.c
+ *   @brief  Implementation of the host simulation platform UART driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include "error.h"
+#include "uart.h"
+#include "sim_uart.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the UART communication peripheral.
+ * @param desc - The UART descriptor.
+ * @param param - The structure that contains the UART parameters. The extra
+ *                field must point to a struct sim_uart_init_param.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
+{
+	struct sim_uart_init_param *sim_init;
+	struct sim_uart_desc *sim_desc;
+	struct uart_desc *descriptor;
+
+	if (!param || !param->extra)
+		return -EINVAL;
+
+	sim_init = param->extra;
+	if (!sim_init->peer_tx || !sim_init->peer_rx)
+		return -EINVAL;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	sim_desc = calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		free(descriptor);
+		return -ENOMEM;
+	}
+
+	sim_desc->peer = *sim_init;
+	descriptor->device_id = param->device_id;
+	descriptor->baud_rate = param->baud_rate;
+	descriptor->extra = sim_desc;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by uart_init().
+ * @param desc - The UART descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t uart_remove(struct uart_desc *desc)
+{
+	if (!desc)
+		return FAILURE;
+
+	free(desc->extra);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write data to the simulated peer.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
+		   uint32_t bytes_number)
+{
+	struct sim_uart_desc *sim_desc = desc->extra;
+
+	if (sim_desc->peer.peer_rx(sim_desc->peer.ctx, data, bytes_number) < 0)
+		return FAILURE;
+
+	sim_desc->tx_bytes += bytes_number;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read data from the simulated peer. Blocks until bytes_number bytes
+ * are provided or the peer ends the session.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t uart_read(struct uart_desc *desc, uint8_t *data,
+		  uint32_t bytes_number)
+{
+	struct sim_uart_desc *sim_desc = desc->extra;
+	uint32_t count = 0;
+	int32_t ret;
+
+	while (count < bytes_number) {
+		ret = sim_desc->peer.peer_tx(sim_desc->peer.ctx, &data[count],
+					     bytes_number - count);
+		if (ret < 0)
+			return FAILURE;
+		count += ret;
+	}
+
+	sim_desc->rx_bytes += bytes_number;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read the data already provided by the simulated peer.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read, negative error code otherwise.
+ */
+int32_t uart_read_nonblocking(struct uart_desc *desc, uint8_t *data,
+			      uint32_t bytes_number)
+{
+	struct sim_uart_desc *sim_desc = desc->extra;
+	int32_t ret;
+
+	ret = sim_desc->peer.peer_tx(sim_desc->peer.ctx, data, bytes_number);
+	if (ret > 0)
+		sim_desc->rx_bytes += ret;
+
+	return ret;
+}
+
+/**
+ * @brief Write data to the simulated peer.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t uart_write_nonblocking(struct uart_desc *desc, const uint8_t *data,
+			       uint32_t bytes_number)
+{
+	return uart_write(desc, data, bytes_number);
+}
+
+/**
+ * @brief Check if UART errors occurred.
+ * @param desc - Instance of UART.
+ * @return Number of errors, always 0.
+ */
+uint32_t uart_get_errors(struct uart_desc *desc)
+{
+	return 0;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ *   @file   sim/sim_uart.h
+ *   @brief  Header file of the host simulation platform UART driver.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_UART_H_
+#define SIM_UART_H_
+
+#include <stdint.h>
+
+/**
+ * @struct sim_uart_init_param
+ * @brief Simulated UART peer, passed as uart_init_param.extra.
+ */
+struct sim_uart_init_param {
+	/**
+	 * Provide up to len bytes sent by the peer. Returns the number of
+	 * bytes provided, 0 if none are available, negative to end the session.
+	 */
+	int32_t (*peer_tx)(void *ctx, uint8_t *data, uint32_t len);
+	/** Consume len bytes received by the peer. Returns negative on error. */
+	int32_t (*peer_rx)(void *ctx, const uint8_t *data, uint32_t len);
+	/** Peer context */
+	void *ctx;
+};
+
+/**
+ * @struct sim_uart_desc
+ * @brief Host simulation platform specific UART descriptor.
+ */
+struct sim_uart_desc {
+	/** Simulated peer */
+	struct sim_uart_init_param peer;
+	/** Bytes received from the peer */
+	uint64_t rx_bytes;
+	/** Bytes sent to the peer */
+	uint64_t tx_bytes;
+};
+
+#endif // SIM_UART_H_
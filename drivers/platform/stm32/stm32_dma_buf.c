@@ -0,0 +1,85 @@
+/***************************************************************************//**
+ *   @file   stm32_dma_buf.c
+ *   @brief  Implementation of stm32 DMA buffer cache maintenance.
+********************************************************************************
+ *   @copyright
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "dma_buf.h"
+#include "stm32_dma_buf.h"
+
+/**
+ * @brief Write back the dirty cache lines of a range.
+ * Parts without a data cache have nothing to do.
+ * @param region - The region descriptor.
+ * @param addr - Cache line aligned start address.
+ * @param size - Size of the range, multiple of the cache line size.
+ * @return 0.
+ */
+static int32_t stm32_dma_buf_flush(struct dma_buf_region *region,
+				   uintptr_t addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	SCB_CleanDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Discard the cache lines of a range.
+ * Parts without a data cache have nothing to do.
+ * @param region - The region descriptor.
+ * @param addr - Cache line aligned start address.
+ * @param size - Size of the range, multiple of the cache line size.
+ * @return 0.
+ */
+static int32_t stm32_dma_buf_invalidate(struct dma_buf_region *region,
+					uintptr_t addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	SCB_InvalidateDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief stm32 specific DMA buffer platform ops structure
+ */
+const struct dma_buf_platform_ops stm32_dma_buf_platform_ops = {
+	.dma_buf_ops_flush = &stm32_dma_buf_flush,
+	.dma_buf_ops_invalidate = &stm32_dma_buf_invalidate,
+};
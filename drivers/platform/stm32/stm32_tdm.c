@@ -50,7 +50,9 @@
 const struct tdm_platform_ops stm32_tdm_platform_ops = {
 	.tdm_ops_init = &stm32_tdm_init,
 	.tdm_ops_read = &stm32_tdm_read,
-	.tdm_ops_remove = &stm32_tdm_remove
+	.tdm_ops_remove = &stm32_tdm_remove,
+	.tdm_ops_stream_start = &stm32_tdm_stream_start,
+	.tdm_ops_stream_stop = &stm32_tdm_stream_stop
 };
 
 /**
@@ -158,6 +160,9 @@ int32_t stm32_tdm_init(struct tdm_desc **desc,
 		goto error;
 	}
 
+	if (tinit->hdma_rx)
+		__HAL_LINKDMA(&tdesc->hsai, hdmarx, *tinit->hdma_rx);
+
 	*desc = tdm_desc;
 
 	return SUCCESS;
@@ -180,6 +185,8 @@ int32_t stm32_tdm_remove(struct tdm_desc *desc)
 		return -EINVAL;
 
 	tdesc = desc->extra;
+	if (tdesc->callback)
+		HAL_SAI_DMAStop(&tdesc->hsai);
 	HAL_SAI_DeInit(&tdesc->hsai);
 	free(desc->extra);
 	free(desc);
@@ -219,3 +226,140 @@ int32_t stm32_tdm_read(struct tdm_desc *desc,
 
 	return ret;
 }
+
+/**
+ * @brief Pass a filled half of the stream buffer to the stream callback.
+ * @param hsai - The SAI handle.
+ * @param half - 0 for the first half of the buffer, 1 for the second one.
+ */
+static void stm32_tdm_stream_block(SAI_HandleTypeDef *hsai, uint32_t half)
+{
+	/* hsai is the first member of the descriptor */
+	struct stm32_tdm_desc *tdesc = (struct stm32_tdm_desc *)hsai;
+
+	if (!tdesc->callback)
+		return;
+
+	tdesc->callback(tdesc->ctx, tdesc->stream_buf +
+			half * tdesc->stream_half * tdesc->sample_bytes,
+			tdesc->stream_half);
+}
+
+#if defined(USE_HAL_SAI_REGISTER_CALLBACKS) && (USE_HAL_SAI_REGISTER_CALLBACKS == 1)
+/**
+ * @brief SAI DMA half transfer complete callback.
+ * @param hsai - The SAI handle.
+ */
+static void stm32_tdm_rx_half_cplt(SAI_HandleTypeDef *hsai)
+{
+	stm32_tdm_stream_block(hsai, 0);
+}
+
+/**
+ * @brief SAI DMA transfer complete callback.
+ * @param hsai - The SAI handle.
+ */
+static void stm32_tdm_rx_cplt(SAI_HandleTypeDef *hsai)
+{
+	stm32_tdm_stream_block(hsai, 1);
+}
+#else
+/**
+ * @brief SAI DMA half transfer complete callback, overrides the HAL weak one.
+ * Only SAI blocks streamed by this driver are expected to use DMA.
+ * @param hsai - The SAI handle.
+ */
+void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	stm32_tdm_stream_block(hsai, 0);
+}
+
+/**
+ * @brief SAI DMA transfer complete callback, overrides the HAL weak one.
+ * Only SAI blocks streamed by this driver are expected to use DMA.
+ * @param hsai - The SAI handle.
+ */
+void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef *hsai)
+{
+	stm32_tdm_stream_block(hsai, 1);
+}
+#endif
+
+/**
+ * @brief Start continuous capture using SAI TDM mode and circular DMA. Half
+ * and full transfer complete interrupts pass each filled half of the buffer to
+ * the callback while the DMA keeps receiving in the other half.
+ * @param desc - The TDM descriptor.
+ * @param buf - The stream buffer.
+ * @param nb_samples - Number of samples in the stream buffer, even and up to
+ *                     UINT16_MAX.
+ * @param callback - Called from interrupt context with each filled half.
+ * @param ctx - Context passed to the callback.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t stm32_tdm_stream_start(struct tdm_desc *desc, void *buf,
+			       uint32_t nb_samples,
+			       tdm_stream_callback callback, void *ctx)
+{
+	struct stm32_tdm_desc *tdesc;
+
+	if (!desc || !desc->extra || !buf || !callback)
+		return -EINVAL;
+
+	if (!nb_samples || (nb_samples % 2) || nb_samples > UINT16_MAX)
+		return -EINVAL;
+
+	tdesc = desc->extra;
+
+	if (!tdesc->hsai.hdmarx || tdesc->hsai.hdmarx->Init.Mode != DMA_CIRCULAR)
+		return -ENOTSUP;
+
+	if (tdesc->callback)
+		return -EBUSY;
+
+	tdesc->stream_buf = buf;
+	tdesc->stream_half = nb_samples / 2;
+	tdesc->sample_bytes = desc->sample_bytes;
+	tdesc->ctx = ctx;
+	tdesc->callback = callback;
+
+#if defined(USE_HAL_SAI_REGISTER_CALLBACKS) && (USE_HAL_SAI_REGISTER_CALLBACKS == 1)
+	HAL_SAI_RegisterCallback(&tdesc->hsai, HAL_SAI_RX_HALFCOMPLETE_CB_ID,
+				 stm32_tdm_rx_half_cplt);
+	HAL_SAI_RegisterCallback(&tdesc->hsai, HAL_SAI_RX_COMPLETE_CB_ID,
+				 stm32_tdm_rx_cplt);
+#endif
+
+	if (HAL_SAI_Receive_DMA(&tdesc->hsai, buf, nb_samples) != HAL_OK) {
+		tdesc->callback = NULL;
+		return -EIO;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Stop continuous capture.
+ * @param desc - The TDM descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t stm32_tdm_stream_stop(struct tdm_desc *desc)
+{
+	struct stm32_tdm_desc *tdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	tdesc = desc->extra;
+
+	if (!tdesc->callback)
+		return SUCCESS;
+
+	if (HAL_SAI_DMAStop(&tdesc->hsai) != HAL_OK)
+		return -EIO;
+
+	tdesc->callback = NULL;
+	tdesc->ctx = NULL;
+
+	return SUCCESS;
+}
@@ -51,6 +51,9 @@
 typedef struct stm32_tdm_init_param {
 	/** Device ID */
 	SAI_Block_TypeDef *base;
+	/** DMA channel used by tdm_stream_start(), configured in circular mode.
+	 *  May be NULL if HAL_SAI_MspInit() links it. */
+	DMA_HandleTypeDef *hdma_rx;
 } stm32_tdm_init_param;
 
 /**
@@ -60,6 +63,16 @@ typedef struct stm32_tdm_init_param {
 typedef struct stm32_tdm_desc {
 	/** TDM instance */
 	SAI_HandleTypeDef hsai;
+	/** Stream buffer */
+	uint8_t *stream_buf;
+	/** Number of samples in half of the stream buffer */
+	uint32_t stream_half;
+	/** Size of a sample in the stream buffer, in bytes */
+	uint8_t sample_bytes;
+	/** Stream callback */
+	tdm_stream_callback callback;
+	/** Stream callback context */
+	void *ctx;
 } stm32_tdm_desc;
 
 /**
@@ -79,4 +92,12 @@ int32_t stm32_tdm_remove(struct tdm_desc *desc);
 int32_t stm32_tdm_read(struct tdm_desc *desc, void *data,
 		       uint16_t bytes_number);
 
+/* Start continuous DMA capture. */
+int32_t stm32_tdm_stream_start(struct tdm_desc *desc, void *buf,
+			       uint32_t nb_samples,
+			       tdm_stream_callback callback, void *ctx);
+
+/* Stop continuous DMA capture. */
+int32_t stm32_tdm_stream_stop(struct tdm_desc *desc);
+
 #endif // STM32_TDM_H_
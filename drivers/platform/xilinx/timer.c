@@ -141,6 +141,12 @@ int32_t timer_init(struct timer_desc **desc,
 		XTmrCtr_SetResetValue(xdesc->instance, xdesc->active_tmr,
 				      dev->load_value);
 		break;
+#endif
+		goto error_xdesc;
+	case TIMER_GLOBAL:
+#ifdef XTIME_H
+		dev->freq_hz = COUNTS_PER_SECOND;
+		break;
 #endif
 		goto error_xdesc;
 	default:
@@ -187,6 +193,8 @@ int32_t timer_remove(struct timer_desc *desc)
 		break;
 #endif
 		return FAILURE;
+	case TIMER_GLOBAL:
+		break;
 	default:
 		return FAILURE;
 	}
@@ -224,6 +232,11 @@ int32_t timer_start(struct timer_desc *desc)
 		break;
 #endif
 		return FAILURE;
+	case TIMER_GLOBAL:
+		/* Always running */
+		break;
+	default:
+		return FAILURE;
 	}
 
 	return SUCCESS;
@@ -289,6 +302,15 @@ int32_t timer_counter_get(struct timer_desc *desc, uint32_t *counter)
 #ifdef XTMRCTR_H
 		*counter = XTmrCtr_GetValue(xdesc->instance, xdesc->active_tmr);
 		break;
+#endif
+		return FAILURE;
+	case TIMER_GLOBAL:
+#ifdef XTIME_H
+		;
+		XTime time;
+		XTime_GetTime(&time);
+		*counter = (uint32_t)time;
+		break;
 #endif
 		return FAILURE;
 	default:
@@ -364,6 +386,12 @@ int32_t timer_count_clk_get(struct timer_desc *desc, uint32_t *freq_hz)
 #ifdef XTMRCTR_H
 		*freq_hz = ((XTmrCtr_Config *)xdesc->config)->SysClockFreqHz;
 		break;
+#endif
+		return FAILURE;
+	case TIMER_GLOBAL:
+#ifdef XTIME_H
+		*freq_hz = COUNTS_PER_SECOND;
+		break;
 #endif
 		return FAILURE;
 	default:
@@ -51,6 +51,9 @@
 #ifdef XPAR_XTMRCTR_NUM_INSTANCES
 #include <xtmrctr.h>
 #endif
+#ifdef _XPARAMETERS_PS_H_
+#include <xtime_l.h>
+#endif
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -64,7 +67,10 @@ enum xil_timer_type {
 	/** Programmable Logic */
 	TIMER_PL,
 	/** Processing System */
-	TIMER_PS
+	TIMER_PS,
+	/** Free running, up counting ARM global timer of the processing
+	 *  system, shared with usleep(): it cannot be stopped or set */
+	TIMER_GLOBAL
 };
 
 /**
@@ -56,6 +56,10 @@
 #define diff_abs(x, y) ((x) > (y) ? (x - y) : (y - x))
 
 #define NO_GAIN_TABLE		((uint32_t)-1)
+/* SPI bytes of one gain table row: data burst, write strobe, 2 dummy writes */
+#define GT_ROW_SPI_BYTES	(2 + 4 + 3 + 3 + 3)
+/* SPI bytes of a gain table load besides the rows */
+#define GT_LOAD_SPI_BYTES	(6 + 3 + 3 + 3 + 3 + 3 + 3 + 3 + 3 + 6 + 3)
 
 /* Used for static code size optimization: please see app_config.h */
 const bool has_split_gt = HAVE_SPLIT_GAIN_TABLE;
@@ -1399,8 +1403,103 @@ static int find_table_index(struct ad9361_rf_phy *phy, int gain)
 	return -EINVAL;
 }
 
+/**
+ * Number of gain table rows to write to go from the loaded table to a band.
+ * Rows that already hold the same words are skipped, the gain table RAM keeps
+ * its content between loads.
+ * @param phy The AD9361 state structure.
+ * @param band The gain table index.
+ * @param dest The destination [GT_RX1, GT_RX2].
+ * @param lna The external LNA control bit ORed in the first word.
+ * @param map If not NULL, set to the rows to write.
+ * @return The number of rows to write.
+ */
+static uint32_t ad9361_gt_rows_to_load(struct ad9361_rf_phy *phy,
+				       uint32_t band, uint32_t dest,
+				       uint8_t lna, uint8_t *map)
+{
+	uint8_t (*tab)[3] = phy->gt_info[band].tab;
+	uint8_t (*cur)[3] = NULL;
+	uint32_t i, cur_max = 0, rows = 0;
+	bool load;
+
+	if ((phy->current_table != NO_GAIN_TABLE) && (phy->gt_dest == dest)) {
+		cur = phy->gt_info[phy->current_table].tab;
+		cur_max = phy->gt_info[phy->current_table].max_index;
+	}
+
+	for (i = 0; i < phy->gt_info[band].max_index; i++) {
+		load = (i >= cur_max) ||
+		       ((cur[i][0] | phy->gt_lna) != (tab[i][0] | lna)) ||
+		       (cur[i][1] != tab[i][1]) || (cur[i][2] != tab[i][2]);
+		if (map)
+			map[i] = load;
+		rows += load;
+	}
+
+	return rows;
+}
+
+/**
+ * SPI bus time of a gain table load.
+ * @param phy The AD9361 state structure.
+ * @param rows The number of rows written.
+ * @return The time [us], 0 if the SPI clock is unknown.
+ */
+static uint32_t ad9361_gt_load_us(struct ad9361_rf_phy *phy, uint32_t rows)
+{
+	uint64_t bits = (uint64_t)(GT_LOAD_SPI_BYTES +
+				   rows * GT_ROW_SPI_BYTES) * 8;
+
+	if (!phy->spi->max_speed_hz)
+		return 0;
+
+	return (uint32_t)((bits * 1000000 + phy->spi->max_speed_hz - 1) /
+			  phy->spi->max_speed_hz);
+}
+
+/**
+ * Predict the cost of the gain table switch a LO change to a frequency
+ * would trigger, so scans can be scheduled around band crossings.
+ * @param phy The AD9361 state structure.
+ * @param freq The RX LO frequency value [Hz].
+ * @param rows If not NULL, set to the number of gain table rows to write,
+ *             0 when the frequency is in the band of the loaded table.
+ * @param time_us If not NULL, set to the SPI bus time of the switch [us].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_gt_switch_cost(struct ad9361_rf_phy *phy, uint64_t freq,
+			      uint32_t *rows, uint32_t *time_us)
+{
+	uint32_t band, n = 0, us = 0;
+	uint8_t lna;
+
+	if (!phy->gt_info)
+		return -EINVAL;
+
+	band = ad9361_gt_tableindex(phy, freq);
+	if (phy->current_table != band) {
+		lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
+		      EXT_LNA_CTRL : 0;
+		n = ad9361_gt_rows_to_load(phy, band, GT_RX1 + GT_RX2, lna,
+					   NULL);
+		us = ad9361_gt_load_us(phy, n);
+	}
+
+	if (rows)
+		*rows = n;
+	if (time_us)
+		*time_us = us;
+
+	return 0;
+}
+
 /**
  * Load the gain table for the selected frequency range and receiver.
+ * Each row is written with a single burst of the address and data registers
+ * and only the rows that differ from the loaded table are written. The
+ * number of rows and their SPI bus time are kept in phy->gt_load_rows and
+ * phy->gt_load_us.
  * @param phy The AD9361 state structure.
  * @param freq The frequency value [Hz].
  * @param dest The destination [GT_RX1, GT_RX2].
@@ -1411,7 +1510,9 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 {
 	struct spi_desc *spi = phy->spi;
 	uint8_t (*tab)[3];
-	uint32_t band, index_max, i, lna, lpf_tia_mask, set_gain;
+	uint8_t map[UINT8_MAX];
+	uint8_t buf[4];
+	uint32_t band, index_max, i, lna, lpf_tia_mask, set_gain, rows;
 	int32_t ret, rx1_gain, rx2_gain;
 
 	dev_dbg(&phy->spi->dev, "%s: frequency %"PRIu64, __func__, freq);
@@ -1461,6 +1562,8 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
 	      EXT_LNA_CTRL : 0;
 
+	rows = ad9361_gt_rows_to_load(phy, band, dest, lna, map);
+
 	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
 			 RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
 
@@ -1473,13 +1576,18 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	phy->tx_quad_lpf_tia_match = -EINVAL;
 
 	for (i = 0; i < index_max; i++) {
-		ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA1,
-				 tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA2,
-				 tab[i][1]); /* TIA & LPF Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA3,
-				 tab[i][2]); /* DC Cal bit & Dig Gain Word */
+		if ((tab[i][1] & lpf_tia_mask) == 0x20)
+			phy->tx_quad_lpf_tia_match = i;
+
+		if (!map[i])
+			continue;
+
+		/* Write Data 3 down to the Gain Table Index in one transfer */
+		buf[0] = tab[i][2]; /* DC Cal bit & Dig Gain Word */
+		buf[1] = tab[i][1]; /* TIA & LPF Word */
+		buf[2] = tab[i][0] | lna; /* Ext LNA, Int LNA, & Mixer Gain Word */
+		buf[3] = i; /* Gain Table Index */
+		ad9361_spi_writem(spi, REG_GAIN_TABLE_WRITE_DATA3, buf, 4);
 		ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG,
 				 START_GAIN_TABLE_CLOCK |
 				 WRITE_GAIN_TABLE |
@@ -1488,10 +1596,6 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 				 0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
 		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
 				 0); /* Dummy Write to delay ~1u */
-
-		if ((tab[i][1] & lpf_tia_mask) == 0x20)
-			phy->tx_quad_lpf_tia_match = i;
-
 	}
 
 	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
@@ -1503,6 +1607,13 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, 0); /* Stop Gain Table Clock */
 
 	phy->current_table = band;
+	phy->gt_dest = dest;
+	phy->gt_lna = lna;
+	phy->gt_load_rows = rows;
+	phy->gt_load_us = ad9361_gt_load_us(phy, rows);
+
+	dev_dbg(&phy->spi->dev, "%s: %"PRIu32" rows, %"PRIu32" us", __func__,
+		rows, phy->gt_load_us);
 
 	ret = find_table_index(phy, rx1_gain);
 	if (ret < 0)
@@ -3317,6 +3317,31 @@ enum dig_tune_flags {
 	DO_ODELAY = 8,
 	SKIP_STORE_RESULT = 16,
 	RESTORE_DEFAULT = 32,
+	EDGE_SEARCH = 64,
+};
+
+#define AD9361_DIG_TUNE_CACHE_MAGIC	0x54443631 /* "16DT" */
+#define AD9361_DIG_TUNE_NUM_RATES	3
+
+/*
+ * Digital interface tuning result. Stored by the application as is (e.g. in
+ * flash or on SD) and handed back through AD9361_InitParam::dig_tune_cache,
+ * the next tuning then only validates the stored delays with a PN check and
+ * sweeps again if they fail.
+ */
+struct ad9361_dig_tune_cache {
+	uint32_t	magic;
+	/* Interface configuration the tuning was made for */
+	uint32_t	sampl_clk;
+	uint32_t	max_freq;
+	uint8_t		intf_mode;
+	/* BIT(0) RX, BIT(1) TX tuned */
+	uint8_t		tuned;
+	/* REG_RX_CLOCK_DATA_DELAY and REG_TX_CLOCK_DATA_DELAY */
+	uint8_t		clk_data_delay[2];
+	/* Failing taps per rate, RX/TX, data delay sweep/clock delay sweep */
+	uint16_t	window[AD9361_DIG_TUNE_NUM_RATES][2][2];
+	uint16_t	checksum;
 };
 
 enum ad9361_bist_mode {
@@ -3348,6 +3373,7 @@ struct ad9361_rf_phy {
 #ifndef AXI_ADC_NOT_PRESENT
 	struct axi_adc		*rx_adc;
 	struct axi_dac		*tx_dac;
+	struct ad9361_dig_tune_cache	*dig_tune_cache;
 #endif
 	struct clk 		*clk_refin;
 	struct clk 		*clks[NUM_AD9361_CLKS];
@@ -3366,6 +3392,12 @@ struct ad9361_rf_phy {
 	int32_t			tx_quad_lpf_tia_match;
 	uint32_t		current_table;
 	struct gain_table_info  *gt_info;
+	/* receivers and external LNA bit of the loaded gain table */
+	uint32_t		gt_dest;
+	uint8_t			gt_lna;
+	/* rows written by the last gain table load and their SPI bus time */
+	uint32_t		gt_load_rows;
+	uint32_t		gt_load_us;
 	bool 			ensm_pin_ctl_en;
 
 	bool			auto_cal_en;
@@ -3450,6 +3482,8 @@ int32_t ad9361_reset(struct ad9361_rf_phy *phy);
 int32_t ad9361_register_clocks(struct ad9361_rf_phy *phy);
 int32_t ad9361_unregister_clocks(struct ad9361_rf_phy *phy);
 uint32_t ad9361_gt(struct ad9361_rf_phy *phy);
+int32_t ad9361_gt_switch_cost(struct ad9361_rf_phy *phy, uint64_t freq,
+			      uint32_t *rows, uint32_t *time_us);
 int32_t ad9361_init_gain_tables(struct ad9361_rf_phy *phy);
 int32_t ad9361_setup(struct ad9361_rf_phy *phy);
 int32_t ad9361_post_setup(struct ad9361_rf_phy *phy);
@@ -3550,6 +3584,7 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 		char *buf, int32_t buflen);
 int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 			enum dig_tune_flags flags);
+bool ad9361_dig_tune_cache_valid(const struct ad9361_dig_tune_cache *cache);
 int32_t ad9361_en_dis_tx(struct ad9361_rf_phy *phy, uint32_t tx_if,
 			 uint32_t enable);
 int32_t ad9361_en_dis_rx(struct ad9361_rf_phy *phy, uint32_t rx_if,
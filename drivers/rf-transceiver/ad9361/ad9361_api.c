@@ -554,6 +554,7 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 #ifndef AXI_ADC_NOT_PRESENT
 	axi_adc_init(&phy->rx_adc, init_param->rx_adc_init);
 	axi_adc_read(phy->rx_adc, ADI_REG_VERSION, &phy->adc_state->pcore_version);
+	phy->dig_tune_cache = init_param->dig_tune_cache;
 	/* platform specific wrapper to call ad9361_post_setup() */
 	ret = ad9361_post_setup(phy);
 	if (ret < 0)
@@ -296,6 +296,9 @@ typedef struct {
 #ifndef AXI_ADC_NOT_PRESENT
 	struct axi_adc_init	*rx_adc_init;
 	struct axi_dac_init	*tx_dac_init;
+	/* Digital interface tuning result of a previous boot, NULL to always
+	 * sweep. Updated whenever a new tuning is made. */
+	struct ad9361_dig_tune_cache	*dig_tune_cache;
 #endif
 } AD9361_InitParam;
 
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <inttypes.h>
+#include <stddef.h>
 #include <string.h>
 #include "ad9361.h"
 #include "delay.h"
@@ -60,6 +61,11 @@
 #define PCORE_VERSION_MINOR(version)	((version >> 8) & 0xff)
 #define PCORE_VERSION_LETTER(version)	(version & 0xff)
 
+/* Edge search: taps between two samples of a delay sweep */
+#define AD9361_DIG_TUNE_EDGE_STEP	4
+/* Length of the PN check validating the cached delays */
+#define AD9361_DIG_TUNE_VERIFY_MS	10
+
 /**
  * Get the number of PHY channels.
  * @return The number of PHY channels.
@@ -347,23 +353,176 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 	return len;
 }
 
+/**
+ * Checksum of the digital tune cache, over all the fields but the checksum.
+ * @param cache The tuning result.
+ * @return The Fletcher-16 checksum.
+ */
+static uint16_t ad9361_dig_tune_cache_checksum(
+	const struct ad9361_dig_tune_cache *cache)
+{
+	const uint8_t *data = (const uint8_t *)cache;
+	uint32_t len = offsetof(struct ad9361_dig_tune_cache, checksum);
+	uint16_t sum1 = 0, sum2 = 0;
+
+	while (len--) {
+		sum1 = (sum1 + *data++) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+
+	return (sum2 << 8) | sum1;
+}
+
+/**
+ * Check if a digital tune cache holds a tuning result.
+ * @param cache The tuning result, as read back from storage.
+ * @return true if the magic number and the checksum are correct.
+ */
+bool ad9361_dig_tune_cache_valid(const struct ad9361_dig_tune_cache *cache)
+{
+	return cache && cache->magic == AD9361_DIG_TUNE_CACHE_MAGIC &&
+	       cache->checksum == ad9361_dig_tune_cache_checksum(cache);
+}
+
+/**
+ * Interface mode the digital tuning depends on, besides the clock rate.
+ * @param phy The AD9361 state structure.
+ * @return The interface mode.
+ */
+static uint8_t ad9361_dig_tune_intf_mode(struct ad9361_rf_phy *phy)
+{
+	return ((phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) ? BIT(0) : 0) |
+	       (phy->pdata->rx2tx2 ? BIT(1) : 0);
+}
+
+/**
+ * Get the cached tuning result, if it was made for the current interface
+ * configuration.
+ * @param phy The AD9361 state structure.
+ * @param max_freq Maximum frequency.
+ * @return The cached result, NULL if there is none to reuse.
+ */
+static const struct ad9361_dig_tune_cache *ad9361_dig_tune_cache_get(
+	struct ad9361_rf_phy *phy, uint32_t max_freq)
+{
+	struct ad9361_dig_tune_cache *cache = phy->dig_tune_cache;
+
+	if (!ad9361_dig_tune_cache_valid(cache) ||
+	    cache->max_freq != max_freq ||
+	    cache->intf_mode != ad9361_dig_tune_intf_mode(phy) ||
+	    cache->sampl_clk !=
+	    clk_get_rate(phy, phy->ref_clk_scale[RX_SAMPL_CLK]))
+		return NULL;
+
+	return cache;
+}
+
+/**
+ * Check one clock/data delay setting of a digital tune sweep.
+ * @param phy The AD9361 state structure.
+ * @param tx Set if TX.
+ * @param row 0: clock delay 0, data delay j; 1: clock delay 15, data
+ *            delay 15 - j.
+ * @param j Position in the row.
+ * @param first Set for the first setting checked in the row.
+ * @return 0 if the PN check passed, 1 otherwise.
+ */
+static uint8_t ad9361_dig_tune_point(struct ad9361_rf_phy *phy, bool tx,
+				     uint32_t row, uint32_t j, bool first)
+{
+	ad9361_set_intf_delay(phy, tx, row ? 15 : 0, row ? 15 - j : j, first);
+
+	return ad9361_check_pn(phy, tx, 4);
+}
+
+/**
+ * Sweep one row of the clock/data delay settings.
+ * In edge search mode only every AD9361_DIG_TUNE_EDGE_STEP setting is
+ * checked, the pass/fail edges between them are found with a binary search
+ * and the settings in between take the result of their neighbours.
+ * @param phy The AD9361 state structure.
+ * @param tx Set if TX.
+ * @param row Row of the sweep, see ad9361_dig_tune_point().
+ * @param field Failing settings, OR'ed with the ones of this sweep.
+ * @param edge Set for edge search mode.
+ * @return None.
+ */
+static void ad9361_dig_tune_row(struct ad9361_rf_phy *phy, bool tx,
+				uint32_t row, uint8_t *field, bool edge)
+{
+	uint32_t a, b, lo, hi, mid, j;
+	uint8_t res[16];
+
+	if (!edge) {
+		for (j = 0; j < 16; j++)
+			res[j] = ad9361_dig_tune_point(phy, tx, row, j, j == 0);
+	} else {
+		res[0] = ad9361_dig_tune_point(phy, tx, row, 0, true);
+		for (a = 0; a < 15; a = b) {
+			b = min(a + AD9361_DIG_TUNE_EDGE_STEP, 15U);
+			res[b] = ad9361_dig_tune_point(phy, tx, row, b, false);
+
+			lo = a;
+			hi = b;
+			while (res[a] != res[b] && hi - lo > 1) {
+				mid = (lo + hi) / 2;
+				if (ad9361_dig_tune_point(phy, tx, row, mid,
+							  false) == res[a])
+					lo = mid;
+				else
+					hi = mid;
+			}
+			if (res[a] == res[b])
+				lo = b;
+			for (j = a + 1; j < b; j++)
+				res[j] = j <= lo ? res[a] : res[b];
+		}
+	}
+
+	for (j = 0; j < 16; j++)
+		field[j] |= res[j];
+}
+
 /**
  * Digital tune delay.
  * @param phy The AD9361 state structure.
  * @param max_freq Maximum frequency.
- * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY,
+ *              EDGE_SEARCH.
  * @param tx Set if TX.
+ * @param cache Result of a previous tuning to validate, NULL to sweep.
+ * @param res Result of this tuning.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
-		uint32_t max_freq, enum dig_tune_flags flags, bool tx)
+		uint32_t max_freq, enum dig_tune_flags flags, bool tx,
+		const struct ad9361_dig_tune_cache *cache,
+		struct ad9361_dig_tune_cache *res)
 {
-	static const uint32_t rates[3] = {25000000U, 40000000U, 61440000U};
+	static const uint32_t rates[AD9361_DIG_TUNE_NUM_RATES] = {
+		25000000U, 40000000U, 61440000U
+	};
 	uint32_t s0, s1, c0, c1;
 	uint32_t i, j, r;
 	bool half_data_rate;
 	uint8_t field[2][16];
 
+	if (cache && (cache->tuned & BIT(tx))) {
+		ad9361_set_intf_delay(phy, tx, cache->clk_data_delay[tx] >> 4,
+				      cache->clk_data_delay[tx] & 0xF, true);
+		if (!ad9361_check_pn(phy, tx, AD9361_DIG_TUNE_VERIFY_MS)) {
+			for (r = 0; r < AD9361_DIG_TUNE_NUM_RATES; r++)
+				for (i = 0; i < 2; i++)
+					res->window[r][tx][i] =
+						cache->window[r][tx][i];
+			res->tuned |= BIT(tx);
+			return 0;
+		}
+
+		dev_dbg(&phy->spi->dev, "%s: cached %s delay 0x%X failed\n",
+			__func__, tx ? "TX" : "RX", cache->clk_data_delay[tx]);
+	}
+
 	if (((phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) ||
 	    !phy->pdata->rx2tx2))
 	    half_data_rate = false;
@@ -377,14 +536,19 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 				half_data_rate ? rates[r] / 2 : rates[r]);
 
 		for (i = 0; i < 2; i++) {
+			uint8_t row[16] = {0};
+
+			/*
+			 * i == 0: clock delay = 0, data delay from 0 to 15
+			 * i == 1: clock delay = 15, data delay from 15 to 0
+			 */
+			ad9361_dig_tune_row(phy, tx, i, row,
+					    flags & EDGE_SEARCH);
+
 			for (j = 0; j < 16; j++) {
-				/*
-				 * i == 0: clock delay = 0, data delay from 0 to 15
-				 * i == 1: clock delay = 15, data delay from 15 to 0
-				 */
-				ad9361_set_intf_delay(phy, tx, i ? 15 : 0,
-						      i ? 15 - j : j, j == 0);
-				field[i][j] |= ad9361_check_pn(phy, tx, 4);
+				field[i][j] |= row[j];
+				if (row[j])
+					res->window[r][tx][i] |= BIT(j);
 			}
 		}
 
@@ -396,6 +560,14 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 	c0 = ad9361_find_opt(&field[0][0], 16, &s0);
 	c1 = ad9361_find_opt(&field[1][0], 16, &s1);
 
+	/* A window narrower than the edge search step can be missed */
+	if (!c0 && !c1 && (flags & EDGE_SEARCH)) {
+		for (r = 0; r < AD9361_DIG_TUNE_NUM_RATES; r++)
+			res->window[r][tx][0] = res->window[r][tx][1] = 0;
+		return ad9361_dig_tune_delay(phy, max_freq, flags & ~EDGE_SEARCH,
+					     tx, NULL, res);
+	}
+
 	if (!c0 && !c1) {
 		ad9361_dig_tune_verbose_print(phy, field, tx, -1, -1);
 		dev_err(&phy->spi->dev, "%s: Tuning %s FAILED!", __func__,
@@ -412,6 +584,7 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 		ad9361_set_intf_delay(phy, tx, s1 + c1 / 2, 0, true);
 	else
 		ad9361_set_intf_delay(phy, tx, 0, s0 + c0 / 2, true);
+	res->tuned |= BIT(tx);
 
 	return 0;
 }
@@ -420,11 +593,16 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
  * Digital tune RX.
  * @param phy The AD9361 state structure.
  * @param max_freq Maximum frequency.
- * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY,
+ *              EDGE_SEARCH.
+ * @param cache Result of a previous tuning to validate, NULL to sweep.
+ * @param res Result of this tuning.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_dig_tune_rx(struct ad9361_rf_phy *phy, uint32_t max_freq,
-			      enum dig_tune_flags flags)
+			      enum dig_tune_flags flags,
+			      const struct ad9361_dig_tune_cache *cache,
+			      struct ad9361_dig_tune_cache *res)
 {
 	struct axi_adc *rx_adc = phy->rx_adc;
 	int32_t ret;
@@ -432,7 +610,7 @@ static int32_t ad9361_dig_tune_rx(struct ad9361_rf_phy *phy, uint32_t max_freq,
 	ad9361_bist_loopback(phy, 0);
 	ad9361_bist_prbs(phy, BIST_INJ_RX);
 
-	ret = ad9361_dig_tune_delay(phy, max_freq, flags, false);
+	ret = ad9361_dig_tune_delay(phy, max_freq, flags, false, cache, res);
 	if (flags & DO_IDELAY)
 		ad9361_dig_tune_iodelay(phy, false);
 
@@ -446,11 +624,16 @@ static int32_t ad9361_dig_tune_rx(struct ad9361_rf_phy *phy, uint32_t max_freq,
  * Digital tune TX.
  * @param phy The AD9361 state structure.
  * @param max_freq Maximum frequency.
- * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY,
+ *              EDGE_SEARCH.
+ * @param cache Result of a previous tuning to validate, NULL to sweep.
+ * @param res Result of this tuning.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_dig_tune_tx(struct ad9361_rf_phy *phy, uint32_t max_freq,
-			      enum dig_tune_flags flags)
+			      enum dig_tune_flags flags,
+			      const struct ad9361_dig_tune_cache *cache,
+			      struct ad9361_dig_tune_cache *res)
 {
 	struct axiadc_converter *conv = phy->adc_conv;
 	struct axi_adc *rx_adc = phy->rx_adc;
@@ -491,7 +674,7 @@ static int32_t ad9361_dig_tune_tx(struct ad9361_rf_phy *phy, uint32_t max_freq,
 		axi_adc_write(rx_adc, 0x4048, tmp);
 	}
 
-	ret = ad9361_dig_tune_delay(phy, max_freq, flags, true);
+	ret = ad9361_dig_tune_delay(phy, max_freq, flags, true, cache, res);
 	if (flags & DO_ODELAY)
 		ad9361_dig_tune_iodelay(phy, true);
 
@@ -516,9 +699,13 @@ static int32_t ad9361_dig_tune_tx(struct ad9361_rf_phy *phy, uint32_t max_freq,
 
 /**
  * Digital tune.
+ * When the phy has a tuning cache made for the current interface
+ * configuration, its delays are validated with a PN check instead of being
+ * swept. The cache is updated with the result of every stored tuning.
  * @param phy The AD9361 state structure.
  * @param max_freq Maximum frequency.
- * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY,
+ *              SKIP_STORE_RESULT, RESTORE_DEFAULT, EDGE_SEARCH.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
@@ -526,6 +713,8 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 {
 	struct axiadc_converter *conv = phy->adc_conv;
 	struct axi_adc *rx_adc = phy->rx_adc;
+	const struct ad9361_dig_tune_cache *cache;
+	struct ad9361_dig_tune_cache res;
 	uint32_t loopback, bist, ensm_state;
 	bool restore = false;
 	int32_t ret = 0;
@@ -533,6 +722,12 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 	if (!conv)
 		return -ENODEV;
 
+	cache = ad9361_dig_tune_cache_get(phy, max_freq);
+	memset(&res, 0, sizeof(res));
+	res.sampl_clk = clk_get_rate(phy, phy->ref_clk_scale[RX_SAMPL_CLK]);
+	res.max_freq = max_freq;
+	res.intf_mode = ad9361_dig_tune_intf_mode(phy);
+
 	dev_dbg(&phy->spi->dev, "%s: freq %"PRIu32" flags 0x%X\n", __func__,
 		max_freq, flags);
 
@@ -558,9 +753,10 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 		if (flags & DO_ODELAY)
 			ad9361_midscale_iodelay(phy, true);
 
-		ret = ad9361_dig_tune_rx(phy, max_freq, flags);
+		ret = ad9361_dig_tune_rx(phy, max_freq, flags, cache, &res);
 		if (ret == 0 && !phy->pdata->dig_interface_tune_skipmode)
-			ret = ad9361_dig_tune_tx(phy, max_freq, flags);
+			ret = ad9361_dig_tune_tx(phy, max_freq, flags, cache,
+						 &res);
 
 		ad9361_bist_loopback(phy, loopback);
 		ad9361_spi_write(phy->spi, REG_BIST_CONFIG, bist);
@@ -582,6 +778,16 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 			ad9361_spi_read(phy->spi, REG_RX_CLOCK_DATA_DELAY);
 		phy->pdata->port_ctrl.tx_clk_data_delay =
 			ad9361_spi_read(phy->spi, REG_TX_CLOCK_DATA_DELAY);
+
+		if (phy->dig_tune_cache && res.tuned) {
+			res.magic = AD9361_DIG_TUNE_CACHE_MAGIC;
+			res.clk_data_delay[0] =
+				phy->pdata->port_ctrl.rx_clk_data_delay;
+			res.clk_data_delay[1] =
+				phy->pdata->port_ctrl.tx_clk_data_delay;
+			res.checksum = ad9361_dig_tune_cache_checksum(&res);
+			*phy->dig_tune_cache = res;
+		}
 	}
 
 	if (!phy->pdata->fdd)
@@ -688,6 +894,16 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 	return 0;
 }
 
+/**
+ * Check if a digital tune cache holds a tuning result.
+ * @param cache The tuning result, as read back from storage.
+ * @return Always false, there is no digital interface to tune.
+ */
+bool ad9361_dig_tune_cache_valid(const struct ad9361_dig_tune_cache *cache)
+{
+	return false;
+}
+
 /**
 * Setup the AD9361 device.
 * @param phy The AD9361 state structure.
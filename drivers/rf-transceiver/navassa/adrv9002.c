@@ -36,6 +36,7 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
+#include <inttypes.h>
 #include <stdint.h>
 #include "error.h"
 #include "util.h"
@@ -53,6 +54,7 @@
 #include "adi_common_types.h"
 #include "adi_adrv9001_gpio.h"
 #include "adi_adrv9001_gpio_types.h"
+#include "adi_adrv9001_hal.h"
 #include "adi_adrv9001_powermanagement.h"
 #include "adi_adrv9001_powermanagement_types.h"
 #include "adi_adrv9001_profile_types.h"
@@ -543,6 +545,96 @@ tx:
 	return 0;
 }
 
+#ifndef ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES
+#define ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES (288*1024)
+#endif
+/* Must divide both the ARM and the stream image sizes */
+#define ADRV9002_IMAGE_CHUNK_SIZE	8192
+
+static uint32_t adrv9002_ticks_get(const struct adrv9002_rf_phy *phy)
+{
+	uint32_t cnt = 0;
+
+	if (phy->timer)
+		timer_counter_get(phy->timer, &cnt);
+
+	return cnt;
+}
+
+static uint32_t adrv9002_ticks_to_us(const struct adrv9002_rf_phy *phy,
+				     uint32_t ticks)
+{
+	if (!phy->timer || !phy->timer->freq_hz)
+		return 0;
+
+	return (uint32_t)(((uint64_t)ticks * 1000000) / phy->timer->freq_hz);
+}
+
+/*
+ * Load the ARM or the stream image in ADRV9002_IMAGE_CHUNK_SIZE pages instead
+ * of the 1KB pages (each with its own DMA setup) used by the utilities API.
+ * The checksum is folded in right after a page is fetched, while it is still
+ * in the cache, so the image is walked only once on its way to the bus. It is
+ * then compared against the expected sum set in @phy, if any.
+ */
+static int adrv9002_image_load(struct adrv9002_rf_phy *phy, const char *path,
+			       const uint32_t size, const bool arm)
+{
+	static uint8_t chunk[ADRV9002_IMAGE_CHUNK_SIZE];
+	void *hal = phy->adrv9001->common.devHalInfo;
+	const adi_adrv9001_ArmSingleSpiWriteMode_e mode =
+		ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STANDARD_BYTES_252;
+	const uint32_t expected = arm ? phy->fw_checksum_expected :
+				  phy->stream_checksum_expected;
+	uint32_t off, i, sum = 0, start, elapsed_us;
+	int ret;
+
+	start = adrv9002_ticks_get(phy);
+
+	for (off = 0; off < size; off += sizeof(chunk)) {
+		if (arm)
+			ret = adi_hal_ArmImagePageGet(hal, path, off / sizeof(chunk),
+						      sizeof(chunk), chunk);
+		else
+			ret = adi_hal_StreamImagePageGet(hal, path, off / sizeof(chunk),
+							 sizeof(chunk), chunk);
+		if (ret) {
+			printf("Failed to read %s at offset %"PRIu32"\n", path, off);
+			return -EIO;
+		}
+
+		for (i = 0; i < sizeof(chunk); i += 4)
+			sum += chunk[i] | (chunk[i + 1] << 8) | (chunk[i + 2] << 16) |
+			       ((uint32_t)chunk[i + 3] << 24);
+
+		if (arm)
+			ret = adi_adrv9001_arm_Image_Write(phy->adrv9001, off, chunk,
+							   sizeof(chunk), mode);
+		else
+			ret = adi_adrv9001_Stream_Image_Write(phy->adrv9001, off, chunk,
+							      sizeof(chunk), mode);
+		if (ret)
+			return adrv9002_dev_err(phy);
+	}
+
+	elapsed_us = adrv9002_ticks_to_us(phy, adrv9002_ticks_get(phy) - start);
+	if (arm) {
+		phy->fw_checksum = sum;
+		phy->fw_load_us = elapsed_us;
+	}
+
+	printf("%s: %"PRIu32" bytes, checksum 0x%08"PRIX32", %"PRIu32" us\n",
+	       path, size, sum, elapsed_us);
+
+	if (expected && sum != expected) {
+		printf("%s: checksum mismatch, expected 0x%08"PRIX32"\n", path,
+		       expected);
+		return -EIO;
+	}
+
+	return 0;
+}
+
 static int adrv9002_digital_init(struct adrv9002_rf_phy *phy)
 {
 	int ret;
@@ -566,18 +658,17 @@ static int adrv9002_digital_init(struct adrv9002_rf_phy *phy)
 						      phy->stream_size,
 						      ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STANDARD_BYTES_252);
 	else
-		ret = adi_adrv9001_Utilities_StreamImage_Load(phy->adrv9001,
-				"Navassa_Stream.bin",
-				ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STANDARD_BYTES_252);
+		ret = adrv9002_image_load(phy, "Navassa_Stream.bin",
+					  ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES,
+					  false);
 	if (ret)
-		return adrv9002_dev_err(phy);
+		return ret > 0 ? adrv9002_dev_err(phy) : ret;
 
 	/* program arm firmware */
-	ret = adi_adrv9001_Utilities_ArmImage_Load(phy->adrv9001,
-			"Navassa_EvaluationFw.bin",
-			ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STANDARD_BYTES_252);
+	ret = adrv9002_image_load(phy, "Navassa_EvaluationFw.bin",
+				  ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES, true);
 	if (ret)
-		return adrv9002_dev_err(phy);
+		return ret;
 
 	ret = adi_adrv9001_arm_Profile_Write(phy->adrv9001, phy->curr_profile);
 	if (ret)
@@ -41,6 +41,7 @@
 
 #include "gpio.h"
 #include "delay.h"
+#include "timer.h"
 
 #include "adi_common_log.h"
 #include "adi_adrv9001_user.h"
@@ -208,6 +209,16 @@ struct adrv9002_rf_phy {
 	struct axi_dmac			*tx1_dmac;
 	struct axi_dmac			*rx2_dmac;
 	struct axi_dmac			*tx2_dmac;
+	/* free running, up counting timer used to time the firmware load, may be NULL */
+	struct timer_desc		*timer;
+	/* 32-bit word sum of the last loaded ARM image */
+	uint32_t			fw_checksum;
+	/* time spent loading the ARM image, 0 without a timer */
+	uint32_t			fw_load_us;
+	/* expected 32-bit word sum of the ARM image, 0 to skip the check */
+	uint32_t			fw_checksum_expected;
+	/* expected 32-bit word sum of the stream image, 0 to skip the check */
+	uint32_t			stream_checksum_expected;
 };
 
 int adrv9002_post_setup(struct adrv9002_rf_phy *phy);
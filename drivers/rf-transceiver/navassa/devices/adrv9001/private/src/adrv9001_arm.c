@@ -1966,8 +1966,9 @@ int32_t adrv9001_DmaMemWrite(adi_adrv9001_Device_t *device, uint32_t address, co
     uint32_t addrIndex = 0;
     uint32_t dataIndex = 0;
     uint32_t spiBufferSize = ((HAL_SPIWRITEARRAY_BUFFERSIZE / 3) - 1);
-    uint16_t addrArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)] = { 0 };
-    uint8_t  dataArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)] = { 0 };
+    /* Not on the stack: the platform may raise HAL_SPIWRITEARRAY_BUFFERSIZE to KBs */
+    static uint16_t addrArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)];
+    static uint8_t  dataArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)];
     uint32_t ADDR_ARM_DMA_DATA[4] = { ADRV9001_ADDR_ARM_DMA_DATA3, ADRV9001_ADDR_ARM_DMA_DATA2, ADRV9001_ADDR_ARM_DMA_DATA1, ADRV9001_ADDR_ARM_DMA_DATA0 };
     uint32_t index = 0;
     uint32_t armMemAddress = address;
@@ -2266,8 +2267,8 @@ int32_t adrv9001_FlexStreamProcessorMemWrite(adi_adrv9001_Device_t *device,
     uint32_t addrIndex = 0;
     uint32_t dataIndex = 0;
     uint32_t spiBufferSize = ((HAL_SPIWRITEARRAY_BUFFERSIZE / 3) - 1);
-    uint16_t addrArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)] = { 0 };
-    uint8_t  dataArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)] = { 0 };
+    static uint16_t addrArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)];
+    static uint8_t  dataArray[(HAL_SPIWRITEARRAY_BUFFERSIZE / 3)];
     uint32_t ADDR_FLEX_SP_ARM_DMA_DATA[4] = { ADRV9001_ADDR_FLEX_SP_ARM_DMA_DATA3, ADRV9001_ADDR_FLEX_SP_ARM_DMA_DATA2, ADRV9001_ADDR_FLEX_SP_ARM_DMA_DATA1, ADRV9001_ADDR_FLEX_SP_ARM_DMA_DATA0 };
     uint32_t index = 0;
     uint32_t flexSpAddress = address;
@@ -16,7 +16,9 @@
 
 #include "adi_adrv9001_types.h"
 
-#define HAL_SPIWRITEARRAY_BUFFERSIZE 256
+#ifndef HAL_SPIWRITEARRAY_BUFFERSIZE
+#define HAL_SPIWRITEARRAY_BUFFERSIZE 256            /*Max bytes per SPI transaction, may be overridden by the platform*/
+#endif
 
 #define ADI_ADRV9001_RESET_ON_ERR  1                 /*API Reset on Severe Errors*/
 
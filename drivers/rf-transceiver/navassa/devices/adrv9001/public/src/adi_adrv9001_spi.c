@@ -201,7 +201,8 @@ int32_t adi_adrv9001_spi_Bytes_Write(adi_adrv9001_Device_t *device, const uint16
     int32_t halError = 0;
     uint32_t i = 0;
     uint16_t numWrBytes = 0;
-    uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE] = { 0 };
+    /* Not on the stack: the platform may raise HAL_SPIWRITEARRAY_BUFFERSIZE to KBs */
+    static uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE];
 
     ADI_NULL_DEVICE_PTR_RETURN(device);
 
@@ -281,8 +282,8 @@ int32_t adi_adrv9001_spi_Bytes_Read(adi_adrv9001_Device_t *device,
     uint32_t i = 0;
     uint32_t j = 0;
     int32_t halError = 0;
-    uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE] = { 0 };
-    uint8_t rdData[HAL_SPIWRITEARRAY_BUFFERSIZE] = { 0 };
+    static uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE];
+    static uint8_t rdData[HAL_SPIWRITEARRAY_BUFFERSIZE];
     uint16_t numWrBytes = 0;
     uint8_t regVal = 0;
     
@@ -444,7 +445,7 @@ int32_t adi_adrv9001_spi_Cache_Write(adi_adrv9001_Device_t *device,
     int32_t halError = 0;
     uint32_t i = 0;
     uint16_t numWrBytes = 0;
-    uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE] = { 0 };
+    static uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE];
 
     ADI_NULL_DEVICE_PTR_RETURN(device);
 
@@ -497,7 +498,7 @@ int32_t adi_adrv9001_spi_Cache_Read(adi_adrv9001_Device_t *device,
     uint32_t i = 0;
     uint32_t j = 0;
     int32_t halError = 0;
-    uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE] = { 0 };
+    static uint8_t wrData[HAL_SPIWRITEARRAY_BUFFERSIZE];
     uint16_t numWrBytes = 0;
 
     ADI_ENTRY_EXPECT(device);
@@ -370,7 +370,7 @@ static talRecoveryActions_t talInitializeDdc(taliseDevice_t *device,
 	return retVal;
 }
 
-uint32_t TALISE_initialize(taliseDevice_t *device, taliseInit_t *init)
+static uint32_t talInitialize(taliseDevice_t *device, taliseInit_t *init)
 {
 	talRecoveryActions_t retVal = TALACT_NO_ACTION;
 	talRecoveryActions_t retValWarn = TALACT_NO_ACTION;
@@ -810,7 +810,7 @@ uint32_t TALISE_initialize(taliseDevice_t *device, taliseInit_t *init)
 	retVal = (talRecoveryActions_t)TALISE_initDigitalClocks(device, &init->clocks);
 	IF_ERR_RETURN_U32(retVal);
 
-	halError = ADIHAL_wait_us(device->devHalInfo, CLKPLL_LOCK_US);
+	halError = talWait_us(device->devHalInfo, CLKPLL_LOCK_US);
 	retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
 				  TALACT_ERR_CHECK_TIMER);
 	IF_ERR_RETURN_U32(retVal);
@@ -1395,6 +1395,29 @@ uint32_t TALISE_initialize(taliseDevice_t *device, taliseInit_t *init)
 	return (uint32_t)retVal;
 }
 
+uint32_t TALISE_initialize(taliseDevice_t *device, taliseInit_t *init)
+{
+	talRecoveryActions_t retVal = TALACT_NO_ACTION;
+	adiHalErr_t halError = ADIHAL_OK;
+
+	/* Queue the init register writes, kept in issue order, so repeated
+	 * field writes to a register merge and, with SPI streaming enabled,
+	 * consecutive registers go out in one instruction. A profile change
+	 * re-runs this function, so it is covered as well. */
+	halError = talSpiTransactionBegin(device->devHalInfo);
+	if (halError != ADIHAL_OK)
+		return talInitialize(device, init);
+
+	retVal = (talRecoveryActions_t)talInitialize(device, init);
+
+	/* Commit even on error so writes issued so far reach the device */
+	halError = talSpiTransactionCommit(device->devHalInfo);
+	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+
+	return (uint32_t)retVal;
+}
+
 uint32_t TALISE_shutdown(taliseDevice_t *device)
 {
 	talRecoveryActions_t retVal = TALACT_NO_ACTION;
@@ -1451,8 +1474,8 @@ uint32_t TALISE_enableMultichipSync(taliseDevice_t *device, uint8_t enableMcs,
 
 	if (enableMcs > 0) {
 		/* If CLKPLL SDM not bypassed, reset CLKPLL SDM as well. */
-		halError = ADIHAL_spiReadField(device->devHalInfo,
-					       TALISE_ADDR_CLK_SYNTH_DIVIDER_INT_BYTE1, &clkPllSdmBypass, 0x40, 6);
+		halError = talSpiReadField(device->devHalInfo,
+					   TALISE_ADDR_CLK_SYNTH_DIVIDER_INT_BYTE1, &clkPllSdmBypass, 0x40, 6);
 		retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
 					  TALACT_ERR_RESET_SPI);
 		IF_ERR_RETURN_U32(retVal);
@@ -2998,8 +3021,8 @@ uint32_t TALISE_initDigitalClocks(taliseDevice_t *device,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
-	halError = ADIHAL_wait_us(device->devHalInfo,
-				  CLKPLL_POWERUP_US); /* Allow PLL time to power up */
+	halError = talWait_us(device->devHalInfo,
+			      CLKPLL_POWERUP_US); /* Allow PLL time to power up */
 	retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_WAIT, halError, retVal,
 				  TALACT_ERR_CHECK_TIMER);
 	IF_ERR_RETURN_U32(retVal);
@@ -438,7 +438,7 @@ uint32_t TALISE_loadArmFromBinary(taliseDevice_t *device, uint8_t *binary,
 
 		if (radioStatus == TALISE_ARM_RADIO_STATUS_POWERUP) {
 			/* Evaluate first since it's the most common case. Wait interval then check again */
-			halError = ADIHAL_wait_us(device->devHalInfo, waitInterval_us);
+			halError = talWait_us(device->devHalInfo, waitInterval_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 		} else if (radioStatus == TALISE_ARM_RADIO_STATUS_READY) {
@@ -1135,7 +1135,7 @@ uint32_t TALISE_waitArmCmdStatus(taliseDevice_t *device, uint8_t opCode,
 		/* if pending bit is set for opcode of interest and the number of events have not expired, perform wait */
 		if (((*cmdStatByte & 0x01) > 0) &&
 		    (eventCheck < numEventChecks)) {
-			halError = ADIHAL_wait_us(device->devHalInfo, waitInterval_us);
+			halError = talWait_us(device->devHalInfo, waitInterval_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 		} else {
@@ -1201,7 +1201,7 @@ uint32_t TALISE_sendArmCommand(taliseDevice_t *device, uint8_t opCode,
 		IF_ERR_RETURN_U32(retVal);
 
 		if (armCommandBusy > 0) {
-			halError = ADIHAL_wait_us(device->devHalInfo, waitInterval_us);
+			halError = talWait_us(device->devHalInfo, waitInterval_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 		} else {
@@ -1371,7 +1371,7 @@ uint32_t TALISE_verifyArmChecksum(taliseDevice_t *device)
 		if ((calculatedChecksum == 0) &&
 		    (eventCheck < numEventChecks)) {
 			/* wait */
-			halError = ADIHAL_wait_us(device->devHalInfo, timeout_us);
+			halError = talWait_us(device->devHalInfo, timeout_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 			IF_ERR_RETURN_U32(retVal);
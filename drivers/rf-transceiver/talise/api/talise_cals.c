@@ -1288,7 +1288,7 @@ uint32_t TALISE_waitForEvent(taliseDevice_t *device,
 		}
 		if ((((data >> spiBit) & 0x01) != doneBitLevel) &&
 		    (eventCheck < numEventChecks)) {
-			halError = ADIHAL_wait_us(device->devHalInfo, waitInterval_us);
+			halError = talWait_us(device->devHalInfo, waitInterval_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 			IF_ERR_RETURN_U32(retVal);
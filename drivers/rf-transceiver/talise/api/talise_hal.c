@@ -9,8 +9,52 @@
  */
 
 #include "talise_hal.h"
+#include "talise_reg_addr_macros.h"
 
-adiHalErr_t talSpiReadByte(void *devHalInfo, uint16_t addr, uint8_t *readdata)
+#define TAL_SPI_CONFIG_A_SOFT_RESET 0x81 /* SPI_INTERFACE_CONFIG_A soft reset bits */
+#define TAL_SPI_CONFIG_A_LSB_FIRST  0x42 /* SPI_INTERFACE_CONFIG_A LSB first bits */
+#define TAL_SPI_CONFIG_A_ADDR_ASC   0x24 /* SPI_INTERFACE_CONFIG_A address ascension bits */
+#define TAL_SPI_CONFIG_B_SINGLE_INS 0x80 /* SPI_INTERFACE_CONFIG_B single instruction bit */
+
+/**
+ * \brief Register write deferred by a SPI transaction
+ */
+typedef struct {
+	uint16_t addr;      /*!< 16-bit SPI address */
+	uint8_t value;      /*!< Register value once this write is done */
+	uint8_t knownMask;  /*!< Bits of value that are determined */
+	uint8_t dirtyMask;  /*!< Bits of value written by this entry */
+} talSpiShadowReg_t;
+
+/**
+ * \brief Address range excluded from the transaction shadow map
+ */
+typedef struct {
+	uint16_t startAddr; /*!< First address of the range */
+	uint16_t endAddr;   /*!< Last address of the range */
+} talSpiVolatileRange_t;
+
+/**
+ * \brief SPI transaction state, owned by one device at a time
+ */
+typedef struct {
+	void *devHalInfo;   /*!< Device owning the transaction, NULL if idle */
+	uint8_t depth;      /*!< Nesting level of talSpiTransactionBegin() calls */
+	uint16_t numRegs;   /*!< Number of valid entries in regs */
+	uint8_t numVolatile; /*!< Number of valid entries in volatileRanges */
+	uint8_t spiConfigA; /*!< Last SPI_INTERFACE_CONFIG_A value written */
+	uint8_t spiConfigB; /*!< Last SPI_INTERFACE_CONFIG_B value written */
+	uint8_t spiConfigKnown; /*!< Bit 0: spiConfigA valid, bit 1: spiConfigB valid */
+	talSpiShadowReg_t regs[TAL_SPI_TXN_MAX_REGS]; /*!< Pending writes in issue order */
+	talSpiVolatileRange_t volatileRanges[TAL_SPI_TXN_MAX_VOLATILE]; /*!< Read-through ranges */
+	uint16_t flushAddr[TAL_SPI_TXN_MAX_REGS]; /*!< Address list of a flush read back */
+	uint8_t flushData[TAL_SPI_TXN_MAX_REGS]; /*!< Data of a flush read back or stream */
+} talSpiTransaction_t;
+
+static talSpiTransaction_t talSpiTxn;
+
+static adiHalErr_t talSpiReadByteHw(void *devHalInfo, uint16_t addr,
+				    uint8_t *readdata)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -24,7 +68,8 @@ adiHalErr_t talSpiReadByte(void *devHalInfo, uint16_t addr, uint8_t *readdata)
 	return halError;
 }
 
-adiHalErr_t talSpiWriteByte(void *devHalInfo, uint16_t addr, uint8_t data)
+static adiHalErr_t talSpiWriteByteHw(void *devHalInfo, uint16_t addr,
+				     uint8_t data)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -38,8 +83,8 @@ adiHalErr_t talSpiWriteByte(void *devHalInfo, uint16_t addr, uint8_t data)
 	return halError;
 }
 
-adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
-			     uint32_t count)
+static adiHalErr_t talSpiWriteBytesHw(void *devHalInfo, uint16_t *addr,
+				      uint8_t *data, uint32_t count)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -53,8 +98,23 @@ adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
 	return halError;
 }
 
-adiHalErr_t talSpiReadBytes(void *devHalInfo, uint16_t *addr, uint8_t *readdata,
-			    uint32_t count)
+static adiHalErr_t talSpiWriteStreamHw(void *devHalInfo, uint16_t addr,
+				       uint8_t *data, uint32_t count)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	halError = ADIHAL_spiWriteStream(devHalInfo, addr, data, count);
+	if (halError == ADIHAL_WAIT_TIMEOUT) {
+		ADIHAL_setTimeout(devHalInfo, HAL_TIMEOUT_DEFAULT * HAL_TIMEOUT_MULT);
+		halError = ADIHAL_spiWriteStream(devHalInfo, addr, data, count);
+	}
+
+	ADIHAL_setTimeout(devHalInfo, HAL_TIMEOUT_DEFAULT);
+	return halError;
+}
+
+static adiHalErr_t talSpiReadBytesHw(void *devHalInfo, uint16_t *addr,
+				     uint8_t *readdata, uint32_t count)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -68,8 +128,9 @@ adiHalErr_t talSpiReadBytes(void *devHalInfo, uint16_t *addr, uint8_t *readdata,
 	return halError;
 }
 
-adiHalErr_t talSpiReadField(void *devHalInfo, uint16_t addr, uint8_t *fieldVal,
-			    uint8_t mask, uint8_t startBit)
+static adiHalErr_t talSpiReadFieldHw(void *devHalInfo, uint16_t addr,
+				     uint8_t *fieldVal, uint8_t mask,
+				     uint8_t startBit)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -83,8 +144,9 @@ adiHalErr_t talSpiReadField(void *devHalInfo, uint16_t addr, uint8_t *fieldVal,
 	return halError;
 }
 
-adiHalErr_t talSpiWriteField(void *devHalInfo, uint16_t addr, uint8_t fieldVal,
-			     uint8_t mask, uint8_t startBit)
+static adiHalErr_t talSpiWriteFieldHw(void *devHalInfo, uint16_t addr,
+				      uint8_t fieldVal, uint8_t mask,
+				      uint8_t startBit)
 {
 	adiHalErr_t halError = ADIHAL_OK;
 
@@ -98,6 +160,424 @@ adiHalErr_t talSpiWriteField(void *devHalInfo, uint16_t addr, uint8_t fieldVal,
 	return halError;
 }
 
+static uint8_t talSpiTxnActive(void *devHalInfo)
+{
+	return ((talSpiTxn.depth > 0) && (talSpiTxn.devHalInfo == devHalInfo));
+}
+
+static uint8_t talSpiTxnIsVolatile(uint16_t addr)
+{
+	uint8_t i = 0;
+
+	for (i = 0; i < talSpiTxn.numVolatile; i++) {
+		if ((addr >= talSpiTxn.volatileRanges[i].startAddr) &&
+		    (addr <= talSpiTxn.volatileRanges[i].endAddr)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static uint8_t talSpiTxnIsSpiConfig(uint16_t addr)
+{
+	return ((addr == TALISE_ADDR_SPI_INTERFACE_CONFIG_A) ||
+		(addr == TALISE_ADDR_SPI_INTERFACE_CONFIG_B));
+}
+
+/* Follows the SPI mode programmed by the transaction, to know if it may stream */
+static void talSpiTxnTrackSpiConfig(uint16_t addr, uint8_t value)
+{
+	if (addr == TALISE_ADDR_SPI_INTERFACE_CONFIG_A) {
+		if (value & TAL_SPI_CONFIG_A_SOFT_RESET) {
+			/* Back to the reset defaults: single instruction mode */
+			talSpiTxn.spiConfigKnown = 0;
+			return;
+		}
+
+		talSpiTxn.spiConfigA = value;
+		talSpiTxn.spiConfigKnown |= 0x01;
+	} else if (addr == TALISE_ADDR_SPI_INTERFACE_CONFIG_B) {
+		talSpiTxn.spiConfigB = value;
+		talSpiTxn.spiConfigKnown |= 0x02;
+	}
+}
+
+/* Streaming needs MSB first, ascending addresses and streaming enabled */
+static uint8_t talSpiTxnCanStream(void)
+{
+	return ((talSpiTxn.spiConfigKnown == 0x03) &&
+		((talSpiTxn.spiConfigA & TAL_SPI_CONFIG_A_LSB_FIRST) == 0) &&
+		((talSpiTxn.spiConfigA & TAL_SPI_CONFIG_A_ADDR_ASC) == TAL_SPI_CONFIG_A_ADDR_ASC) &&
+		((talSpiTxn.spiConfigB & TAL_SPI_CONFIG_B_SINGLE_INS) == 0));
+}
+
+/* Returns 1 and the index of the latest pending write to addr, if any */
+static uint8_t talSpiTxnFind(uint16_t addr, uint16_t *idx)
+{
+	uint16_t i = 0;
+
+	for (i = talSpiTxn.numRegs; i > 0; i--) {
+		if (talSpiTxn.regs[i - 1].addr == addr) {
+			*idx = i - 1;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static adiHalErr_t talSpiTxnFlush(void *devHalInfo);
+
+/* Queues a write to addr after the pending ones, carrying over the bits they set */
+static adiHalErr_t talSpiTxnAppend(void *devHalInfo, uint16_t addr,
+				   talSpiShadowReg_t **reg)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+	talSpiShadowReg_t *entry = NULL;
+	uint16_t idx = 0;
+
+	if (talSpiTxn.numRegs >= TAL_SPI_TXN_MAX_REGS) {
+		/* Queue full: push everything pending to the device and start over */
+		halError = talSpiTxnFlush(devHalInfo);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+	}
+
+	entry = &talSpiTxn.regs[talSpiTxn.numRegs];
+	entry->addr = addr;
+	entry->value = 0;
+	entry->knownMask = 0;
+	entry->dirtyMask = 0;
+
+	if (talSpiTxnFind(addr, &idx)) {
+		entry->value = talSpiTxn.regs[idx].value;
+		entry->knownMask = talSpiTxn.regs[idx].knownMask;
+	}
+
+	talSpiTxn.numRegs++;
+	*reg = entry;
+
+	return ADIHAL_OK;
+}
+
+/* Writes the pending registers to the device in issue order and empties the queue */
+static adiHalErr_t talSpiTxnFlush(void *devHalInfo)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+	talSpiShadowReg_t *reg = NULL;
+	uint16_t *addr = talSpiTxn.flushAddr;
+	uint8_t *data = talSpiTxn.flushData;
+	uint32_t count = 0;
+	uint16_t numRegs = talSpiTxn.numRegs;
+	uint16_t i = 0;
+
+	talSpiTxn.numRegs = 0;
+
+	/*
+	 * Fetch, in a single burst, the bits of partially written registers.
+	 * The transaction never wrote those bits, so reading them ahead of the
+	 * writes returns the same content.
+	 */
+	for (i = 0; i < numRegs; i++) {
+		reg = &talSpiTxn.regs[i];
+		if (reg->knownMask != 0xFF) {
+			addr[count++] = reg->addr;
+		}
+	}
+
+	if (count > 0) {
+		halError = talSpiReadBytesHw(devHalInfo, addr, data, count);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+
+		count = 0;
+		for (i = 0; i < numRegs; i++) {
+			reg = &talSpiTxn.regs[i];
+			if (reg->knownMask != 0xFF) {
+				reg->value = (data[count++] & ~reg->knownMask) |
+					     (reg->value & reg->knownMask);
+				reg->knownMask = 0xFF;
+			}
+		}
+	}
+
+	/*
+	 * Every queued write reaches the device, in the order it was issued.
+	 * Runs of consecutive addresses go out as a single streaming instruction
+	 * when the device SPI mode allows it.
+	 */
+	i = 0;
+	while (i < numRegs) {
+		reg = &talSpiTxn.regs[i];
+		data[0] = reg->value;
+		count = 1;
+
+		if (talSpiTxnCanStream() && !talSpiTxnIsSpiConfig(reg->addr)) {
+			while (((i + count) < numRegs) &&
+			       (talSpiTxn.regs[i + count].addr == (reg->addr + count)) &&
+			       !talSpiTxnIsSpiConfig(talSpiTxn.regs[i + count].addr)) {
+				data[count] = talSpiTxn.regs[i + count].value;
+				count++;
+			}
+		}
+
+		if (count > 1) {
+			halError = talSpiWriteStreamHw(devHalInfo, reg->addr, data, count);
+		} else {
+			halError = talSpiWriteByteHw(devHalInfo, reg->addr, reg->value);
+			talSpiTxnTrackSpiConfig(reg->addr, reg->value);
+		}
+
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+
+		i += count;
+	}
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t talSpiReadByte(void *devHalInfo, uint16_t addr, uint8_t *readdata)
+{
+	if (!talSpiTxnActive(devHalInfo)) {
+		return talSpiReadByteHw(devHalInfo, addr, readdata);
+	}
+
+	return talSpiReadField(devHalInfo, addr, readdata, 0xFF, 0);
+}
+
+adiHalErr_t talSpiWriteByte(void *devHalInfo, uint16_t addr, uint8_t data)
+{
+	if (!talSpiTxnActive(devHalInfo)) {
+		return talSpiWriteByteHw(devHalInfo, addr, data);
+	}
+
+	return talSpiWriteField(devHalInfo, addr, data, 0xFF, 0);
+}
+
+adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
+			     uint32_t count)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	if (talSpiTxnActive(devHalInfo)) {
+		/* Bulk accesses (ARM memory, tables) keep their ordering against pending writes */
+		halError = talSpiTxnFlush(devHalInfo);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+	}
+
+	return talSpiWriteBytesHw(devHalInfo, addr, data, count);
+}
+
+adiHalErr_t talSpiReadBytes(void *devHalInfo, uint16_t *addr, uint8_t *readdata,
+			    uint32_t count)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	if (talSpiTxnActive(devHalInfo)) {
+		halError = talSpiTxnFlush(devHalInfo);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+	}
+
+	return talSpiReadBytesHw(devHalInfo, addr, readdata, count);
+}
+
+adiHalErr_t talSpiReadField(void *devHalInfo, uint16_t addr, uint8_t *fieldVal,
+			    uint8_t mask, uint8_t startBit)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+	talSpiShadowReg_t *reg = NULL;
+	uint16_t idx = 0;
+
+	if (!talSpiTxnActive(devHalInfo)) {
+		return talSpiReadFieldHw(devHalInfo, addr, fieldVal, mask, startBit);
+	}
+
+	/* Only bits written by the transaction itself are served from the queue */
+	if (!talSpiTxnIsVolatile(addr)) {
+		if (talSpiTxnFind(addr, &idx)) {
+			reg = &talSpiTxn.regs[idx];
+			if ((reg->knownMask & mask) == mask) {
+				*fieldVal = ((reg->value & mask) >> startBit);
+				return ADIHAL_OK;
+			}
+		}
+	}
+
+	/* Anything else, status polls included, must reflect everything written so far */
+	halError = talSpiTxnFlush(devHalInfo);
+	if (halError != ADIHAL_OK) {
+		return halError;
+	}
+
+	return talSpiReadFieldHw(devHalInfo, addr, fieldVal, mask, startBit);
+}
+
+adiHalErr_t talSpiWriteField(void *devHalInfo, uint16_t addr, uint8_t fieldVal,
+			     uint8_t mask, uint8_t startBit)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+	talSpiShadowReg_t *reg = NULL;
+
+	if (!talSpiTxnActive(devHalInfo)) {
+		return talSpiWriteFieldHw(devHalInfo, addr, fieldVal, mask, startBit);
+	}
+
+	if (talSpiTxnIsVolatile(addr)) {
+		/* Self clearing/trigger bits are written in program order */
+		halError = talSpiTxnFlush(devHalInfo);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+
+		if (talSpiTxnIsSpiConfig(addr)) {
+			talSpiTxn.spiConfigKnown = 0;
+		}
+
+		return talSpiWriteFieldHw(devHalInfo, addr, fieldVal, mask, startBit);
+	}
+
+	/*
+	 * Merge only into the last queued write, so no write moves ahead of
+	 * another one. Overwriting one of its pending bits queues a second
+	 * write instead, so pulses and toggles are not merged.
+	 */
+	reg = NULL;
+	if ((talSpiTxn.numRegs > 0) &&
+	    (talSpiTxn.regs[talSpiTxn.numRegs - 1].addr == addr)) {
+		reg = &talSpiTxn.regs[talSpiTxn.numRegs - 1];
+		if (((reg->value ^ (fieldVal << startBit)) & mask & reg->dirtyMask) != 0) {
+			reg = NULL;
+		}
+	}
+
+	if (reg == NULL) {
+		halError = talSpiTxnAppend(devHalInfo, addr, &reg);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+	}
+
+	reg->value = (reg->value & ~mask) | ((fieldVal << startBit) & mask);
+	reg->knownMask |= mask;
+	reg->dirtyMask |= mask;
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t talSpiTransactionBegin(void *devHalInfo)
+{
+	if (devHalInfo == NULL) {
+		return ADIHAL_GEN_SW;
+	}
+
+	if (talSpiTxn.depth > 0) {
+		if (talSpiTxn.devHalInfo != devHalInfo) {
+			/* Only one device may defer writes at a time */
+			return ADIHAL_GEN_SW;
+		}
+
+		talSpiTxn.depth++;
+		return ADIHAL_OK;
+	}
+
+	talSpiTxn.devHalInfo = devHalInfo;
+	talSpiTxn.depth = 1;
+	talSpiTxn.numRegs = 0;
+	talSpiTxn.numVolatile = 0;
+	/* Unknown device SPI mode: no streaming until the transaction sets it */
+	talSpiTxn.spiConfigKnown = 0;
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t talSpiTransactionAddVolatile(void *devHalInfo, uint16_t startAddr,
+		uint16_t endAddr)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+	uint16_t i = 0;
+
+	if (!talSpiTxnActive(devHalInfo) || (startAddr > endAddr)) {
+		return ADIHAL_GEN_SW;
+	}
+
+	if (talSpiTxn.numVolatile >= TAL_SPI_TXN_MAX_VOLATILE) {
+		return ADIHAL_GEN_SW;
+	}
+
+	/* Drop cached copies so later accesses in the range go to the device */
+	for (i = 0; i < talSpiTxn.numRegs; i++) {
+		if ((talSpiTxn.regs[i].addr >= startAddr) &&
+		    (talSpiTxn.regs[i].addr <= endAddr)) {
+			halError = talSpiTxnFlush(devHalInfo);
+			break;
+		}
+	}
+
+	talSpiTxn.volatileRanges[talSpiTxn.numVolatile].startAddr = startAddr;
+	talSpiTxn.volatileRanges[talSpiTxn.numVolatile].endAddr = endAddr;
+	talSpiTxn.numVolatile++;
+
+	return halError;
+}
+
+adiHalErr_t talSpiTransactionCommit(void *devHalInfo)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	if (!talSpiTxnActive(devHalInfo)) {
+		return ADIHAL_GEN_SW;
+	}
+
+	if (--talSpiTxn.depth > 0) {
+		return ADIHAL_OK;
+	}
+
+	halError = talSpiTxnFlush(devHalInfo);
+
+	talSpiTxn.numVolatile = 0;
+	talSpiTxn.devHalInfo = NULL;
+
+	return halError;
+}
+
+adiHalErr_t talSpiTransactionAbort(void *devHalInfo)
+{
+	if (!talSpiTxnActive(devHalInfo)) {
+		return ADIHAL_GEN_SW;
+	}
+
+	talSpiTxn.depth = 0;
+	talSpiTxn.numRegs = 0;
+	talSpiTxn.numVolatile = 0;
+	talSpiTxn.devHalInfo = NULL;
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t talWait_us(void *devHalInfo, uint32_t time_us)
+{
+	adiHalErr_t halError = ADIHAL_OK;
+
+	if (talSpiTxnActive(devHalInfo)) {
+		/* The delay is meant to follow the writes issued before it */
+		halError = talSpiTxnFlush(devHalInfo);
+		if (halError != ADIHAL_OK) {
+			return halError;
+		}
+	}
+
+	return ADIHAL_wait_us(devHalInfo, time_us);
+}
+
 adiHalErr_t talWriteToLog(void *devHalInfo, adiLogLevel_t logLevel,
 			  uint32_t errorCode, const char *comment)
 {
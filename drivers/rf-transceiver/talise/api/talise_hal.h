@@ -23,6 +23,13 @@ extern "C" {
 #define HAL_TIMEOUT_INFINITE 0xFFFFFFFF /* Blocking */
 #define HAL_TIMEOUT_MULT 2              /* HAL timeout worse-case factor */
 
+#ifndef TAL_SPI_TXN_MAX_REGS
+#define TAL_SPI_TXN_MAX_REGS 256        /* Register writes held by a transaction */
+#endif
+#ifndef TAL_SPI_TXN_MAX_VOLATILE
+#define TAL_SPI_TXN_MAX_VOLATILE 8      /* Read-through address ranges per transaction */
+#endif
+
 /**
  * \brief Private wrapper function for ADIHAL_spiReadField with error handling
  *
@@ -65,6 +72,23 @@ adiHalErr_t talSpiReadField(void *devHalInfo, uint16_t addr, uint8_t *fieldVal,
 adiHalErr_t talSpiWriteField(void *devHalInfo, uint16_t addr, uint8_t fieldVal,
 			     uint8_t mask, uint8_t startBit);
 
+/**
+ * \brief Private wrapper function for ADIHAL_wait_us
+ *
+ * Commits the writes deferred by an open SPI transaction before waiting, so
+ * the delay starts after them.
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ * \param time_us Time to wait in microseconds
+ *
+ * \retval Returns adiHalErr_t enumerated type
+ */
+adiHalErr_t talWait_us(void *devHalInfo, uint32_t time_us);
+
 /**
  * \brief Private Wrapper function for ADIHAL_writeToLog with error handling
  *
@@ -161,6 +185,84 @@ adiHalErr_t talSpiWriteBytes(void *devHalInfo, uint16_t *addr, uint8_t *data,
 adiHalErr_t talSpiReadBytes(void *devHalInfo, uint16_t *addr, uint8_t *readdata,
 			    uint32_t count);
 
+/**
+ * \brief Starts deferring register writes for the device
+ *
+ * Until the matching talSpiTransactionCommit(), talSpiWriteField() and
+ * talSpiWriteByte() only queue the register writes, in issue order.
+ * Consecutive writes to the same register are merged into one, unless a
+ * pending bit is overwritten, so pulses are kept.
+ * talSpiReadField()/talSpiReadByte() are served from the queue only for the
+ * bits written during the transaction; any other read, talSpiWriteBytes(),
+ * talSpiReadBytes() and talWait_us() commit the pending writes before
+ * accessing the device, so status polls and delays see every earlier write.
+ * Calls may be nested; only the outermost commit reaches the device. A single
+ * device can hold a transaction at a time.
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ *
+ * \retval ADIHAL_OK Transaction started
+ * \retval ADIHAL_GEN_SW Another device already holds a transaction
+ */
+adiHalErr_t talSpiTransactionBegin(void *devHalInfo);
+
+/**
+ * \brief Marks an address range as volatile for the current transaction
+ *
+ * Reads and writes to volatile registers (status, self clearing and trigger
+ * bits) go straight to the device, after all pending writes are committed,
+ * so their program order against the deferred writes is preserved.
+ * The ranges are dropped when the outermost transaction ends.
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ * \param startAddr First 16-bit SPI address of the range
+ * \param endAddr Last 16-bit SPI address of the range
+ *
+ * \retval Returns adiHalErr_t enumerated type
+ */
+adiHalErr_t talSpiTransactionAddVolatile(void *devHalInfo, uint16_t startAddr,
+		uint16_t endAddr);
+
+/**
+ * \brief Ends a transaction and writes the changed registers to the device
+ *
+ * Registers with partially written fields are read back first, then every
+ * queued write is sent in issue order. When the transaction has set the
+ * device to MSB first, ascending address SPI streaming, runs of writes to
+ * consecutive addresses are sent as one ADIHAL_spiWriteStream() instruction;
+ * otherwise each register is a single write.
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ *
+ * \retval Returns adiHalErr_t enumerated type
+ */
+adiHalErr_t talSpiTransactionCommit(void *devHalInfo);
+
+/**
+ * \brief Ends a transaction dropping all the pending register writes
+ *
+ * \dep_begin
+ * \dep{devHalInfo}
+ * \dep_end
+ *
+ * \param devHalInfo Pointer to device HAL information container
+ *
+ * \retval Returns adiHalErr_t enumerated type
+ */
+adiHalErr_t talSpiTransactionAbort(void *devHalInfo);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1654,28 +1654,28 @@ uint32_t TALISE_readFramerStatus(taliseDevice_t *device,
 						  TAL_ERR_FRAMERSTATUS_NULL_FRAMERSTATUS_PARAM, retVal, TALACT_ERR_CHECK_PARAM);
 	}
 
-	halError = ADIHAL_spiReadField(device->devHalInfo, sysrefStatusAddr,
-				       &sysrefStatus, 0x03, 0);
+	halError = talSpiReadField(device->devHalInfo, sysrefStatusAddr,
+				   &sysrefStatus, 0x03, 0);
 	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
-	halError = ADIHAL_spiReadField(device->devHalInfo, syncStatusAddr, &syncStatus,
-				       0x30, 4);
+	halError = talSpiReadField(device->devHalInfo, syncStatusAddr, &syncStatus,
+				   0x30, 4);
 	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
-	halError = ADIHAL_spiReadField(device->devHalInfo, configStatus3Addr,
-				       &configStatus3, 0x01, 0);
+	halError = talSpiReadField(device->devHalInfo, configStatus3Addr,
+				   &configStatus3, 0x01, 0);
 	retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
 	/*Read Invalid Framer Config status only if Silicon Revision is C0 or higher, else report 0 as invalid config*/
 	if(device->devStateInfo.deviceSiRev >= INVALIDCFG_STS_MIN_SUPPORTED_SIREV) {
-		halError = ADIHAL_spiReadField(device->devHalInfo, configStatus4Addr,
-					       &configStatus4, 0x01, 0);
+		halError = talSpiReadField(device->devHalInfo, configStatus4Addr,
+					   &configStatus4, 0x01, 0);
 		retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
 					  TALACT_ERR_RESET_SPI);
 		IF_ERR_RETURN_U32(retVal);
@@ -1727,8 +1727,8 @@ uint32_t TALISE_readDeframerStatus(taliseDevice_t *device,
 	IF_ERR_RETURN_U32(retVal);
 
 	if(device->devStateInfo.deviceSiRev >= INVALIDCFG_STS_MIN_SUPPORTED_SIREV) {
-		halError = ADIHAL_spiReadField(device->devHalInfo,
-					       (configStatus3Addr + deframerOffset), &configStatus3, 0x01, 0);
+		halError = talSpiReadField(device->devHalInfo,
+					   (configStatus3Addr + deframerOffset), &configStatus3, 0x01, 0);
 		retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_SPI, halError, retVal,
 					  TALACT_ERR_RESET_SPI);
 		IF_ERR_RETURN_U32(retVal);
@@ -1540,7 +1540,7 @@ uint32_t TALISE_setOrxLoSource(taliseDevice_t *device,
 		IF_ERR_RETURN_U32(retVal);
 
 		if (armCommandBusy > 0) {
-			halError = ADIHAL_wait_us(device->devHalInfo, waitInterval_us);
+			halError = talWait_us(device->devHalInfo, waitInterval_us);
 			retVal = talApiErrHandler(device, TAL_ERRHDL_HAL_WAIT, halError, retVal,
 						  TALACT_ERR_CHECK_TIMER);
 		} else {
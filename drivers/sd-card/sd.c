@@ -46,6 +46,7 @@
 #include "sd.h"
 #include "delay.h"
 #include "error.h"
+#include "crc16.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -59,6 +60,8 @@
 
 #define CMD0_RETRY_NUMBER		(5u)
 #define WAIT_RESP_TIMEOUT		(1000u) //1000ms
+#define FAST_POLL_NUMBER		(64u)	//Polls before waiting 1ms between them
+#define POLL_CHUNK_LEN			(16u)
 
 #define R1_READY_STATE			(0x00u)
 #define R1_IDLE_STATE			(0x01u)
@@ -74,8 +77,12 @@
 
 #define STUFF_ARG			(0x00000000u)
 #define CMD8_ARG			(0x000001AAu)
+#define CMD59_CRC_ON_ARG		(0x00000001u)
+#define ACMD23_MAX_ARG			(0x007FFFFFu)
 #define ACMD41_ARG			(0x40000000u)
 
+#define CRC16_POLYNOMIAL		(0x1021u)
+
 #define DATA_BLOCK_BITS			(9u)
 #define MASK_ADDR_IN_BLOCK		(DATA_BLOCK_LEN - 1u)
 #define MASK_BLOCK_NUMBER		(~(uint64_t)MASK_ADDR_IN_BLOCK)
@@ -86,11 +93,49 @@
 #define MASK_RESPONSE_TOKEN		(0x0Eu)
 #define MASK_ERROR_TOKEN		(0xF0u)
 
+/* Offset of the CRC and of the data response in sd_desc->xfer */
+#define XFER_CRC_IDX			(1u + DATA_BLOCK_LEN)
+#define XFER_RESP_IDX			(XFER_CRC_IDX + CRC_LEN)
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/* CRC16-CCITT of the data blocks, populated by the first sd_init() with CRC */
+DECLARE_CRC16_TABLE(sd_crc16_table);
+static bool sd_crc16_table_ready;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * Compute the CRC7 of a command, as placed in its last byte
+ * @param data	- Command index and argument
+ * @param len	- Length of data
+ * @return CRC7 shifted left, with the end bit set
+ */
+static uint8_t sd_crc7(const uint8_t *data, uint32_t len)
+{
+	uint8_t		crc;
+	uint8_t		byte;
+	uint32_t	i;
+	uint32_t	bit;
+
+	crc = 0;
+	for (i = 0; i < len; i++) {
+		byte = data[i];
+		for (bit = 0; bit < 8; bit++) {
+			crc <<= 1;
+			if ((byte ^ crc) & 0x80)
+				crc ^= 0x09;
+			byte <<= 1;
+		}
+	}
+
+	return (crc << 1) | 1;
+}
+
 /**
  * Read SD card bytes until one is different from 0xFF
  * @param sd_desc	- Instance of the SD card
@@ -100,11 +145,14 @@
 static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
 {
 	uint32_t	not_timeout;
+	uint32_t	fast_polls;
 	int32_t		ret;
 
 	ret = FAILURE;
 	not_timeout = WAIT_RESP_TIMEOUT;
+	fast_polls = FAST_POLL_NUMBER;
 	do {
+		*data_out = 0xFF;
 		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc,
 						  data_out, 1))
 			break;
@@ -112,39 +160,88 @@ static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
 			ret = SUCCESS;
 			break;
 		}
-		mdelay(1);
-	} while (not_timeout--);
+		if (fast_polls)
+			fast_polls--;
+		else
+			mdelay(1);
+	} while (fast_polls || not_timeout--);
 
 	return ret;
 }
 
 /**
- * Read SD card bytes until one is different from 0x00
+ * Read SD card bytes, a chunk at a time, until the busy signal (0x00) ends
  * @param sd_desc - Instance of the SD card
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
 static int32_t wait_until_not_busy(struct sd_desc *sd_desc)
 {
 	uint32_t	not_timeout;
+	uint32_t	fast_polls;
 	int32_t		ret;
-	uint8_t		data;
 
 	ret = FAILURE;
 	not_timeout = WAIT_RESP_TIMEOUT;
+	fast_polls = FAST_POLL_NUMBER;
 	do {
-		data = 0xFF;
-		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, &data, 1))
+		memset(sd_desc->buff, 0xFF, POLL_CHUNK_LEN);
+		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff,
+						  POLL_CHUNK_LEN))
 			break;
-		if (data != 0x00) {
+		if (sd_desc->buff[POLL_CHUNK_LEN - 1] != 0x00) {
 			ret = SUCCESS;
 			break;
 		}
-		mdelay(1);
-	} while (not_timeout--);
+		if (fast_polls)
+			fast_polls--;
+		else
+			mdelay(1);
+	} while (fast_polls || not_timeout--);
 
 	return ret;
 }
 
+/**
+ * Read SD card bytes, a chunk at a time, until a start block or error token.
+ * The bytes following the token in the chunk are moved at the beginning of
+ * sd_desc->xfer.
+ * @param sd_desc	- Instance of the SD card
+ * @param token		- The token is wrote here
+ * @param left		- Number of bytes following the token
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t wait_for_token(struct sd_desc *sd_desc, uint8_t *token,
+			      uint32_t *left)
+{
+	uint32_t	not_timeout;
+	uint32_t	fast_polls;
+	uint32_t	i;
+
+	not_timeout = WAIT_RESP_TIMEOUT;
+	fast_polls = FAST_POLL_NUMBER;
+	do {
+		memset(sd_desc->xfer, 0xFF, POLL_CHUNK_LEN);
+		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->xfer,
+						  POLL_CHUNK_LEN))
+			return FAILURE;
+		for (i = 0; i < POLL_CHUNK_LEN; i++) {
+			if (sd_desc->xfer[i] == 0xFF)
+				continue;
+			*token = sd_desc->xfer[i];
+			*left = POLL_CHUNK_LEN - i - 1;
+			memmove(sd_desc->xfer, sd_desc->xfer + i + 1, *left);
+
+			return SUCCESS;
+		}
+		if (fast_polls)
+			fast_polls--;
+		else
+			mdelay(1);
+	} while (fast_polls || not_timeout--);
+
+	return FAILURE;
+}
+
 /**
  * Calculate the number of blocks to be read/written from the address
  * and the length
@@ -175,7 +272,8 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 		cmd_desc_local.response_len = R1_LEN;
 		if (SUCCESS != send_command(sd_desc, &cmd_desc_local))
 			return FAILURE;
-		if (cmd_desc_local.response[0] != R1_IDLE_STATE) {
+		/* Idle during the initialization, ready afterwards */
+		if (cmd_desc_local.response[0] & ~R1_IDLE_STATE) {
 			DEBUG_MSG("Not the expected response for CMD55\n");
 			return FAILURE;
 		}
@@ -188,10 +286,7 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 	sd_desc->buff[3] = (cmd_desc->arg >> 16) & 0xff;
 	sd_desc->buff[4] = (cmd_desc->arg >> 8) & 0xff;
 	sd_desc->buff[5] = cmd_desc->arg & 0xff;
-	if (cmd_desc->cmd == CMD(0))					/* Set crc if needed */
-		sd_desc->buff[6] = 0x95;
-	else if (cmd_desc->cmd == CMD(8))
-		sd_desc->buff[6] = 0x87;
+	sd_desc->buff[6] = sd_crc7(sd_desc->buff + 1, 5);		/* Set crc */
 
 	/* Send command */
 	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CMD_LEN))
@@ -211,33 +306,75 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 }
 
 /**
- * Send one block of data to the SD card
+ * Send a command with an R1 response and check that the card is ready
+ * @param sd_desc	- Instance of the SD card
+ * @param cmd		- Command code
+ * @param arg		- Argument for the command
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t send_command_r1(struct sd_desc *sd_desc, uint8_t cmd,
+			       uint32_t arg)
+{
+	struct cmd_desc	cmd_desc;
+
+	cmd_desc.cmd = cmd;
+	cmd_desc.arg = arg;
+	cmd_desc.response_len = R1_LEN;
+	if (SUCCESS != send_command(sd_desc, &cmd_desc))
+		return FAILURE;
+	if (cmd_desc.response[0] != R1_READY_STATE) {
+		DEBUG_MSG("Command not accepted\n");
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Send one block of data to the SD card.
+ * The start token, the data, the CRC and the poll of the data response are
+ * a single transfer of sd_desc->xfer.
  * @param sd_desc	- Instance of the SD card
  * @param data		- Data to be written
  * @param nb_of_blocks	- Number of blocks written in the executing command
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
+static int32_t write_block(struct sd_desc *sd_desc, const uint8_t *data,
 			   uint32_t nb_of_blocks)
 {
-	/* Send start block token */
-	sd_desc->buff[0] = START_N_BLOCK_TOKEN;
-	if (nb_of_blocks == 1)
-		sd_desc->buff[0] = START_1_BLOCK_TOKEN;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, 1))
-		return FAILURE;
+	uint8_t		*xfer = sd_desc->xfer;
+	uint16_t	crc;
+	uint8_t		response;
+	bool		busy;
+	uint32_t	i;
 
-	/* Send data with CRC */
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
-		return FAILURE;
-	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
+	/* Start block token, data and CRC */
+	xfer[0] = START_N_BLOCK_TOKEN;
+	if (nb_of_blocks == 1)
+		xfer[0] = START_1_BLOCK_TOKEN;
+	memcpy(xfer + 1, data, DATA_BLOCK_LEN);
+	crc = 0xFFFF;
+	if (sd_desc->crc_enable)
+		crc = crc16(sd_crc16_table, data, DATA_BLOCK_LEN, 0);
+	xfer[XFER_CRC_IDX] = crc >> 8;
+	xfer[XFER_CRC_IDX + 1] = crc & 0xFF;
+	memset(xfer + XFER_RESP_IDX, 0xFF, SD_RESP_POLL_LEN);
+	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, xfer, SD_XFER_LEN))
 		return FAILURE;
 
 	/* Read response and check if write was ok */
-	uint8_t		response;
-	if (SUCCESS != wait_for_response(sd_desc, &response))
-		return FAILURE;
+	for (i = XFER_RESP_IDX; i < SD_XFER_LEN; i++)
+		if (xfer[i] != 0xFF)
+			break;
+	if (i < SD_XFER_LEN) {
+		response = xfer[i];
+		/* Still busy unless the card released the line in the poll */
+		busy = i == SD_XFER_LEN - 1 || xfer[SD_XFER_LEN - 1] == 0x00;
+	} else {
+		if (SUCCESS != wait_for_response(sd_desc, &response))
+			return FAILURE;
+		busy = true;
+	}
 	switch (response & MASK_RESPONSE_TOKEN) {
 	case 0x4:
 		break;
@@ -251,23 +388,25 @@ static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
 		DEBUG_MSG("Other problem\n");
 		return FAILURE;
 	}
-	if (SUCCESS != wait_until_not_busy(sd_desc))
+	if (busy && SUCCESS != wait_until_not_busy(sd_desc))
 		return FAILURE;
 
 	return SUCCESS;
 }
 
 /**
- * Read one block of data to the SD card
+ * Read one block of data from the SD card in sd_desc->xfer
  * @param sd_desc	- Instance of the SD card
- * @param data		- Buffer were data will be read
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
+static int32_t read_block(struct sd_desc *sd_desc)
 {
+	uint8_t		response;
+	uint32_t	left;
+	uint16_t	crc;
+
 	/* Reading Start block token */
-	uint8_t	response;
-	if (SUCCESS != wait_for_response(sd_desc, &response))
+	if (SUCCESS != wait_for_token(sd_desc, &response, &left))
 		return FAILURE;
 	if ((response & MASK_ERROR_TOKEN) == 0) {
 		DEBUG_MSG("Received data error token on read\n");
@@ -295,114 +434,286 @@ static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
 		return FAILURE;
 	}
 
-	/* Read data block */
-	memset(data, 0xff, DATA_BLOCK_LEN);
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
+	/* Read the rest of the data block and the crc in one transfer */
+	memset(sd_desc->xfer + left, 0xFF, DATA_BLOCK_LEN + CRC_LEN - left);
+	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->xfer + left,
+					  DATA_BLOCK_LEN + CRC_LEN - left))
 		return FAILURE;
 
-	/* Read crc*/
-	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
-		return FAILURE;
+	if (sd_desc->crc_enable) {
+		crc = (sd_desc->xfer[DATA_BLOCK_LEN] << 8) |
+		      sd_desc->xfer[DATA_BLOCK_LEN + 1];
+		if (crc != crc16(sd_crc16_table, sd_desc->xfer, DATA_BLOCK_LEN, 0)) {
+			DEBUG_MSG("Data CRC error\n");
+			return FAILURE;
+		}
+	}
 
 	return SUCCESS;
 }
 
 /**
- * Prepare and write data block by block
+ * Read blocks and copy the requested bytes of each one
  * @param sd_desc	- Instance of the SD card
- * @param data		- Data to be written
- * @param addr		- Address in memory where data will be written
- * @param len		- Length of data to be written
- * @param nb_of_blocks	- Number of block to be written
- * @param first_block	- First block where data will be written with unmodified
- * 						  data
- * @param last_block	- Last block where data will be written with unmodified
- * 						  data
+ * @param data		- Where data will be read
+ * @param addr		- Address in memory from where data will be read
+ * @param len		- Length of data to be read
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t write_multiple_blocks(struct sd_desc *sd_desc,
-				     uint8_t *data, uint64_t addr, uint64_t len,
-				     uint8_t *first_block, uint8_t *last_block)
+static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
+				    uint8_t *data, uint64_t addr, uint64_t len)
 {
+	uint32_t	nb_of_blocks = get_nb_of_blocks(addr, len);
 	uint16_t	buff_first_idx;
 	uint16_t	buff_copy_len;
 	uint32_t	i;
 	uint64_t	data_idx;
-	uint32_t	nb_of_blocks = get_nb_of_blocks(addr, len);
 
+	/* Send read command */
+	if (SUCCESS != send_command_r1(sd_desc,
+				       nb_of_blocks == 1 ? CMD(17) : CMD(18),
+				       addr >> DATA_BLOCK_BITS))
+		return FAILURE;
+
+	/* Read blocks */
 	data_idx = 0;
-	i = 0;
-	while (i < nb_of_blocks) {
+	for (i = 0; i < nb_of_blocks; i++) {
 		buff_first_idx = 0x0000u;
 		if (i == 0)
 			buff_first_idx = addr & MASK_ADDR_IN_BLOCK;
 		buff_copy_len = DATA_BLOCK_LEN - buff_first_idx;
 		if (i == nb_of_blocks - 1)
 			buff_copy_len = ((addr + len - 1) & MASK_ADDR_IN_BLOCK) - buff_first_idx + 1;
-		if (buff_first_idx == 0x0000u && buff_copy_len == DATA_BLOCK_LEN) {
-			/* Write every block beside the first and last if the write is not the entire block */
-			if (SUCCESS != write_block(sd_desc, data + data_idx, nb_of_blocks))
-				return FAILURE;
-		} else {			/* If we are not writing a full block */
-			if (i == 0) {		/* If is the first block */
-				memcpy(first_block + buff_first_idx, data + data_idx, buff_copy_len);
-				if (SUCCESS != write_block(sd_desc, first_block, nb_of_blocks))
-					return FAILURE;
-			} else {		/* Is the last block */
-				memcpy(last_block, data + data_idx, buff_copy_len);
-				if (SUCCESS != write_block(sd_desc, last_block, nb_of_blocks))
-					return FAILURE;
-			}
-		}
+		if (SUCCESS != read_block(sd_desc))
+			return FAILURE;
+		memcpy(data + data_idx, sd_desc->xfer + buff_first_idx, buff_copy_len);
 		data_idx += buff_copy_len;
-		i++;
+	}
+
+	/* Send stop transmission command */
+	if (nb_of_blocks != 1 &&
+	    SUCCESS != send_command_r1(sd_desc, CMD(12), STUFF_ARG)) {
+		DEBUG_MSG("Failed to send stop transmission command\n");
+		return FAILURE;
 	}
 
 	return SUCCESS;
 }
 
 /**
- * Prepare and read data block by block
+ * Write whole blocks, streamed in a single command
  * @param sd_desc	- Instance of the SD card
- * @param data		- Data to be read
- * @param addr		- Address in memory from where data will be read
- * @param len		- Length of data to be read
- * @param nb_of_blocks	- Number of block to be read
+ * @param block		- First block
+ * @param nb_of_blocks	- Number of blocks
+ * @param get_block	- Gives the data of each block
+ * @param ctx		- Context of get_block
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
-				    uint8_t *data, uint64_t addr, uint64_t len)
+static int32_t write_multiple_blocks(struct sd_desc *sd_desc, uint64_t block,
+				     uint32_t nb_of_blocks,
+				     const uint8_t *(*get_block)(const void *ctx, uint32_t i),
+				     const void *ctx)
 {
-	uint8_t		buff[DATA_BLOCK_LEN] __attribute__ ((aligned));
 	uint32_t	i;
-	uint64_t	data_idx;
 
-	data_idx = 0;
-	i = 0;
-	while (i < get_nb_of_blocks(addr, len)) {
-		uint16_t		buff_first_idx;
-		uint16_t		buff_copy_len;
+	if (nb_of_blocks == 1) {
+		if (SUCCESS != send_command_r1(sd_desc, CMD(24), block))
+			return FAILURE;
 
-		buff_first_idx = 0x0000u;
-		if (i == 0)
-			buff_first_idx = addr & MASK_ADDR_IN_BLOCK;
-		buff_copy_len = DATA_BLOCK_LEN - buff_first_idx;
-		if (i == get_nb_of_blocks(addr, len) - 1)
-			buff_copy_len = ((addr + len - 1) & MASK_ADDR_IN_BLOCK) - buff_first_idx + 1;
-		if (buff_first_idx == 0x0000u && buff_copy_len == DATA_BLOCK_LEN) {
-			if (SUCCESS != read_block(sd_desc, data + data_idx))
-				return FAILURE;
-		} else {
-			if (SUCCESS != read_block(sd_desc, buff))
-				return FAILURE;
-			memcpy(data + data_idx, buff + buff_first_idx, buff_copy_len);
+		return write_block(sd_desc, get_block(ctx, 0), 1);
+	}
+
+	/* Let the card pre-erase the blocks about to be written */
+	if (SUCCESS != send_command_r1(sd_desc, ACMD(23),
+				       nb_of_blocks & ACMD23_MAX_ARG))
+		return FAILURE;
+	if (SUCCESS != send_command_r1(sd_desc, CMD(25), block))
+		return FAILURE;
+
+	for (i = 0; i < nb_of_blocks; i++)
+		if (SUCCESS != write_block(sd_desc, get_block(ctx, i), nb_of_blocks))
+			return FAILURE;
+
+	/* Send stop transmission token */
+	sd_desc->buff[0] = STOP_TRANSMISSION_TOKEN;
+	sd_desc->buff[1] = 0xFF;
+	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, 2))
+		return FAILURE;
+
+	return wait_until_not_busy(sd_desc);
+}
+
+/**
+ * write_multiple_blocks() callback for contiguous data
+ */
+static const uint8_t *get_buffer_block(const void *ctx, uint32_t i)
+{
+	return (const uint8_t *)ctx + i * DATA_BLOCK_LEN;
+}
+
+
+/**
+ * Find a block in the write-behind cache
+ * @param sd_desc	- Instance of the SD card
+ * @param block		- Block number
+ * @return The cache entry, NULL if the block is not cached
+ */
+static struct sd_cache_block *cache_find(struct sd_desc *sd_desc,
+		uint64_t block)
+{
+	uint32_t	i;
+
+	for (i = 0; i < sd_desc->cache_blocks; i++)
+		if (sd_desc->cache[i].valid && sd_desc->cache[i].block == block)
+			return &sd_desc->cache[i];
+
+	return NULL;
+}
+
+/**
+ * @struct cache_run
+ * @brief Run of consecutive dirty blocks of the cache
+ */
+struct cache_run {
+	struct sd_desc	*sd_desc;
+	uint64_t	block;
+};
+
+/**
+ * write_multiple_blocks() callback for a run of dirty blocks
+ */
+static const uint8_t *get_cache_block(const void *ctx, uint32_t i)
+{
+	const struct cache_run	*run = ctx;
+
+	return cache_find(run->sd_desc, run->block + i)->data;
+}
+
+/**
+ * Get the cache entry of a block, evicting the least recently used clean
+ * block if the cache is full. When all the blocks are dirty, they are flushed
+ * at once, so that consecutive blocks are coalesced in multi-block writes.
+ * @param sd_desc	- Instance of the SD card
+ * @param block		- Block number
+ * @param load		- Read the block from the card if not cached
+ * @return The cache entry, NULL in case of failure
+ */
+static struct sd_cache_block *cache_get(struct sd_desc *sd_desc,
+					uint64_t block, bool load)
+{
+	struct sd_cache_block	*entry;
+	uint32_t		i;
+
+	sd_desc->cache_clock++;
+
+	entry = cache_find(sd_desc, block);
+	if (entry) {
+		entry->last_use = sd_desc->cache_clock;
+		return entry;
+	}
+
+	/* Free entry, else least recently used clean entry */
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		if (!sd_desc->cache[i].valid) {
+			entry = &sd_desc->cache[i];
+			break;
 		}
-		data_idx += buff_copy_len;
-		i++;
+		if (sd_desc->cache[i].dirty)
+			continue;
+		if (!entry || sd_desc->cache_clock - sd_desc->cache[i].last_use >
+		    sd_desc->cache_clock - entry->last_use)
+			entry = &sd_desc->cache[i];
+	}
+	/* All dirty: write them back in as few commands as possible */
+	if (!entry) {
+		if (SUCCESS != sd_flush(sd_desc))
+			return NULL;
+		entry = &sd_desc->cache[0];
+		for (i = 1; i < sd_desc->cache_blocks; i++)
+			if (sd_desc->cache_clock - sd_desc->cache[i].last_use >
+			    sd_desc->cache_clock - entry->last_use)
+				entry = &sd_desc->cache[i];
 	}
 
-	return SUCCESS;
+	entry->valid = false;
+	if (load) {
+		if (SUCCESS != read_multiple_blocks(sd_desc, entry->data,
+						    block << DATA_BLOCK_BITS,
+						    DATA_BLOCK_LEN))
+			return NULL;
+	}
+	entry->block = block;
+	entry->valid = true;
+	entry->dirty = false;
+	entry->last_use = sd_desc->cache_clock;
+
+	return entry;
+}
+
+/**
+ * Drop the cached copies of blocks about to be overwritten on the card
+ * @param sd_desc	- Instance of the SD card
+ * @param block		- First block
+ * @param nb_of_blocks	- Number of blocks
+ */
+static void cache_drop(struct sd_desc *sd_desc, uint64_t block,
+		       uint32_t nb_of_blocks)
+{
+	uint32_t	i;
+
+	for (i = 0; i < sd_desc->cache_blocks; i++)
+		if (sd_desc->cache[i].valid &&
+		    sd_desc->cache[i].block >= block &&
+		    sd_desc->cache[i].block < block + nb_of_blocks)
+			sd_desc->cache[i].valid = false;
+}
+
+/**
+ * Write dirty cached blocks to the card, consecutive blocks in a single
+ * multi-block write
+ * @param sd_desc	- Instance of the SD card
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_flush(struct sd_desc *sd_desc)
+{
+	struct sd_cache_block	*first;
+	struct cache_run	run;
+	struct sd_cache_block	*entry;
+	uint32_t		nb_of_blocks;
+	uint32_t		i;
+
+	if (!sd_desc)
+		return FAILURE;
+
+	run.sd_desc = sd_desc;
+	while (true) {
+		/* Lowest dirty block starts the next run */
+		first = NULL;
+		for (i = 0; i < sd_desc->cache_blocks; i++) {
+			entry = &sd_desc->cache[i];
+			if (entry->valid && entry->dirty &&
+			    (!first || entry->block < first->block))
+				first = entry;
+		}
+		if (!first)
+			return SUCCESS;
+
+		run.block = first->block;
+		nb_of_blocks = 1;
+		while (true) {
+			entry = cache_find(sd_desc, run.block + nb_of_blocks);
+			if (!entry || !entry->dirty)
+				break;
+			nb_of_blocks++;
+		}
+
+		if (SUCCESS != write_multiple_blocks(sd_desc, run.block, nb_of_blocks,
+						     get_cache_block, &run))
+			return FAILURE;
+
+		for (i = 0; i < nb_of_blocks; i++)
+			cache_find(sd_desc, run.block + i)->dirty = false;
+	}
 }
 
 /**
@@ -417,7 +728,10 @@ static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
 int32_t sd_read(struct sd_desc *sd_desc,
 		uint8_t *data, uint64_t address, uint64_t len)
 {
-	struct cmd_desc	cmd_desc;
+	struct sd_cache_block	*entry;
+	uint64_t		start;
+	uint64_t		end;
+	uint32_t		i;
 
 	/* Initial checks */
 	if (data == NULL || address > sd_desc->memory_size ||
@@ -425,95 +739,121 @@ int32_t sd_read(struct sd_desc *sd_desc,
 	    address + len > sd_desc->memory_size)
 		return FAILURE;
 
-	/* Send read command */
-	cmd_desc.cmd = (get_nb_of_blocks(address, len) == 1) ? CMD(17): CMD(18);
-	cmd_desc.arg = address >> DATA_BLOCK_BITS;;
-	cmd_desc.response_len = R1_LEN;
-	if (SUCCESS != send_command(sd_desc, &cmd_desc))
-		return FAILURE;
-	if (cmd_desc.response[0] != R1_READY_STATE) {
-		DEBUG_MSG("Failed to write Data command\n");
+	if (SUCCESS != read_multiple_blocks(sd_desc, data, address, len))
 		return FAILURE;
+
+	/* The cached blocks are newer than the card */
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		entry = &sd_desc->cache[i];
+		if (!entry->valid)
+			continue;
+		start = entry->block << DATA_BLOCK_BITS;
+		end = start + DATA_BLOCK_LEN;
+		if (start < address)
+			start = address;
+		if (end > address + len)
+			end = address + len;
+		if (start >= end)
+			continue;
+		memcpy(data + (start - address),
+		       entry->data + (start & MASK_ADDR_IN_BLOCK), end - start);
 	}
 
-	/* Read blocks */
-	if (SUCCESS != read_multiple_blocks(sd_desc, data, address, len))
-		return FAILURE;
+	return SUCCESS;
+}
 
-	/* Send stop transmission command */
-	if (get_nb_of_blocks(address, len) != 1) {
-		cmd_desc.cmd = CMD(12);
-		cmd_desc.arg = STUFF_ARG;
-		cmd_desc.response_len = R1_LEN;
-		if (SUCCESS != send_command(sd_desc, &cmd_desc))
-			return FAILURE;
-		if(cmd_desc.response[0] != R1_READY_STATE) {
-			DEBUG_MSG("Failed to send stop transmission command\n");
+/**
+ * Write a part of a block, through the cache if enabled or with a
+ * read-modify-write otherwise
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data to write
+ * @param address	- Address in memory where data will be written
+ * @param len		- Length of data, within the block
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t write_partial_block(struct sd_desc *sd_desc, const uint8_t *data,
+				   uint64_t address, uint32_t len)
+{
+	uint8_t			block[DATA_BLOCK_LEN] __attribute__ ((aligned));
+	struct sd_cache_block	*entry;
+	uint64_t		block_addr = address & MASK_BLOCK_NUMBER;
+
+	if (sd_desc->cache) {
+		entry = cache_get(sd_desc, address >> DATA_BLOCK_BITS,
+				  len != DATA_BLOCK_LEN);
+		if (!entry)
 			return FAILURE;
-		}
+		memcpy(entry->data + (address & MASK_ADDR_IN_BLOCK), data, len);
+		entry->dirty = true;
+
+		return SUCCESS;
 	}
 
-	return SUCCESS;
+	if (SUCCESS != read_multiple_blocks(sd_desc, block, block_addr,
+					    DATA_BLOCK_LEN))
+		return FAILURE;
+	memcpy(block + (address & MASK_ADDR_IN_BLOCK), data, len);
+
+	return write_multiple_blocks(sd_desc, block_addr >> DATA_BLOCK_BITS, 1,
+				     get_buffer_block, block);
 }
 
 /**
- * Write data of size len to the specified address
- * This operation returns only when the write is complete
+ * Write data of size len to the specified address.
+ * Whole blocks are streamed to the card in a single multi-block write, the
+ * card pre-erasing them. With the write-behind cache, parts of blocks, as
+ * well as runs of whole blocks shorter than the cache, are held in the
+ * cache and written to the card on eviction or by sd_flush(). Otherwise
+ * the operation returns only when the write is complete.
  * @param sd_desc	- Instance of the SD card
  * @param data		- Data to write
  * @param address	- Address in memory where data will be written
  * @param len		- Length of data in bytes
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-int32_t sd_write(struct sd_desc *sd_desc, uint8_t *data, uint64_t address,
-		 uint64_t len)
+int32_t sd_write(struct sd_desc *sd_desc, const uint8_t *data,
+		 uint64_t address, uint64_t len)
 {
-	struct cmd_desc	cmd_desc;
-	uint8_t		first_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
-	uint8_t		last_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
+	uint32_t	nb_of_blocks;
+	uint32_t	copy_len;
+	uint32_t	i;
 
 	/* Initial checks */
 	if (data == NULL || address > sd_desc->memory_size ||
 	    len > sd_desc->memory_size || address + len > sd_desc->memory_size)
 		return FAILURE;
 
-	/* Read first and last block in memory if needed to be updated with user data and then written back                                                                        */
-	/* If not writing from the beginning of a block or */
-	if ((address & MASK_ADDR_IN_BLOCK) != 0 ||
-	    /* If writing from the beginning but not the full block */
-	    ((address & MASK_ADDR_IN_BLOCK) == 0 && len < DATA_BLOCK_LEN))
-		sd_read(sd_desc, first_block, address & MASK_BLOCK_NUMBER, DATA_BLOCK_LEN);
-	/* If the last block is different from the first and */
-	if (((address + len - 1) & MASK_BLOCK_NUMBER) != (address & MASK_BLOCK_NUMBER)
-	    /* If reading less than the full block */
-	    && ((address + len - 1) & MASK_ADDR_IN_BLOCK) != MASK_ADDR_IN_BLOCK)
-		sd_read(sd_desc, last_block, (address + len - 1) & MASK_BLOCK_NUMBER,
-			DATA_BLOCK_LEN);
-
-	/* Send write command to SD */
-	cmd_desc.cmd = (get_nb_of_blocks(address, len) == 1) ? CMD(24): CMD(25);
-	cmd_desc.arg = address >> DATA_BLOCK_BITS; //Address of first block
-	cmd_desc.response_len = R1_LEN;
-	if (SUCCESS != send_command(sd_desc, &cmd_desc))
-		return FAILURE;
-	if (cmd_desc.response[0] != R1_READY_STATE) {
-		DEBUG_MSG("Failed to write Data command\n");
-		return FAILURE;
-	}
-
-	/* Write blocks */
-	if (SUCCESS != write_multiple_blocks(sd_desc, data, address, len,
-					     first_block, last_block))
-		return FAILURE;
-
-	/* Send stop transmission token */
-	if (get_nb_of_blocks(address, len) != 1) {
-		sd_desc->buff[0] = STOP_TRANSMISSION_TOKEN;
-		sd_desc->buff[1] = 0xFF;
-		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, 2))
-			return FAILURE;
-		if (SUCCESS != wait_until_not_busy(sd_desc))
-			return FAILURE;
+	while (len) {
+		if ((address & MASK_ADDR_IN_BLOCK) == 0 && len >= DATA_BLOCK_LEN) {
+			nb_of_blocks = len >> DATA_BLOCK_BITS;
+			copy_len = nb_of_blocks << DATA_BLOCK_BITS;
+			if (nb_of_blocks >= sd_desc->cache_blocks) {
+				cache_drop(sd_desc, address >> DATA_BLOCK_BITS,
+					   nb_of_blocks);
+				if (SUCCESS != write_multiple_blocks(sd_desc,
+								     address >> DATA_BLOCK_BITS,
+								     nb_of_blocks,
+								     get_buffer_block, data))
+					return FAILURE;
+			} else {
+				for (i = 0; i < nb_of_blocks; i++)
+					if (SUCCESS != write_partial_block(sd_desc,
+									   data + (i << DATA_BLOCK_BITS),
+									   address + (i << DATA_BLOCK_BITS),
+									   DATA_BLOCK_LEN))
+						return FAILURE;
+			}
+		} else {
+			copy_len = DATA_BLOCK_LEN - (address & MASK_ADDR_IN_BLOCK);
+			if (copy_len > len)
+				copy_len = len;
+			if (SUCCESS != write_partial_block(sd_desc, data, address,
+							   copy_len))
+				return FAILURE;
+		}
+		data += copy_len;
+		address += copy_len;
+		len -= copy_len;
 	}
 
 	return SUCCESS;
@@ -539,6 +879,14 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 	if (!local_desc)
 		return FAILURE;
 	local_desc->spi_desc = param->spi_desc;
+	local_desc->crc_enable = param->crc_enable;
+	if (param->cache_blocks) {
+		local_desc->cache = calloc(param->cache_blocks,
+					   sizeof(*local_desc->cache));
+		if (!local_desc->cache)
+			goto failure;
+		local_desc->cache_blocks = param->cache_blocks;
+	}
 
 	/* Synchronize SD card frequency: Send 10 dummy bytes*/
 	memset(local_desc->buff, 0xFF, 10);
@@ -573,7 +921,22 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 		goto failure;
 	}
 
-	/* For enabling CRC send CMD 59 here (CRC not implemented)*/
+	/* Enable the CRC check of the commands and data blocks */
+	if (local_desc->crc_enable) {
+		cmd_desc.cmd = CMD(59);
+		cmd_desc.arg = CMD59_CRC_ON_ARG;
+		cmd_desc.response_len = R1_LEN;
+		if (SUCCESS != send_command(local_desc, &cmd_desc))
+			goto failure;
+		if (cmd_desc.response[0] != R1_IDLE_STATE) {
+			DEBUG_MSG("Failed to enable CRC\n");
+			goto failure;
+		}
+		if (!sd_crc16_table_ready) {
+			crc16_populate_msb(sd_crc16_table, CRC16_POLYNOMIAL);
+			sd_crc16_table_ready = true;
+		}
+	}
 
 	/* Change to ready state */
 	cmd_desc.cmd = ACMD(41);
@@ -627,20 +990,27 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 
 	return SUCCESS;
 failure:
+	free(local_desc->cache);
 	free(local_desc);
 	return FAILURE;
 }
 
 /**
- * Remove the initialize instance of SD card.
+ * Remove the initialize instance of SD card, after writing the dirty blocks
+ * of the cache.
  * @param desc	- Instance of the SD card
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
 int32_t sd_remove(struct sd_desc *desc)
 {
+	int32_t	ret;
+
 	if (desc == NULL)
 		return FAILURE;
 
+	ret = sd_flush(desc);
+	free(desc->cache);
 	free(desc);
-	return SUCCESS;
+
+	return ret;
 }
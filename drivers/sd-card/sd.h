@@ -66,6 +66,10 @@
 
 #define DATA_BLOCK_LEN			(512u)
 #define MAX_RESPONSE_LEN		(18u)
+/* Bytes polled after the CRC of a written block for the data response */
+#define SD_RESP_POLL_LEN		(8u)
+/* Start token, data block, CRC and data response poll in one transfer */
+#define SD_XFER_LEN			(1u + DATA_BLOCK_LEN + 2u + SD_RESP_POLL_LEN)
 
 #ifdef SD_DEBUG
 #include <stdio.h>
@@ -85,6 +89,27 @@
 struct sd_init_param {
 	/** Descriptor of an initialized SPI channel */
 	struct spi_desc *spi_desc;
+	/** Number of blocks of the write-behind cache, 0 to write through */
+	uint32_t	cache_blocks;
+	/** Protect the commands and the data blocks with CRCs (CMD59) */
+	bool		crc_enable;
+};
+
+/**
+ * @struct sd_cache_block
+ * @brief Block of the write-behind cache
+ */
+struct sd_cache_block {
+	/** Block number on the card */
+	uint64_t	block;
+	/** Value of the cache clock at the last access, for the eviction */
+	uint32_t	last_use;
+	/** The entry holds a block */
+	bool		valid;
+	/** The block was modified and not written to the card yet */
+	bool		dirty;
+	/** Block data */
+	uint8_t		data[DATA_BLOCK_LEN];
 };
 
 /**
@@ -100,6 +125,17 @@ struct sd_desc {
 	uint8_t		high_capacity;
 	/** Buffer used for the driver implementation */
 	uint8_t		buff[18];
+	/** CRC protection of the commands and the data blocks is enabled */
+	bool		crc_enable;
+	/** Write-behind cache, NULL if disabled */
+	struct sd_cache_block	*cache;
+	/** Number of blocks of the write-behind cache */
+	uint32_t	cache_blocks;
+	/** Cache clock, incremented at each cache access */
+	uint32_t	cache_clock;
+	/** Transfer buffer of a whole data block, the caller's buffers are
+	 *  never clobbered by the full duplex SPI transfers */
+	uint8_t		xfer[SD_XFER_LEN] __attribute__ ((aligned));
 };
 
 /**
@@ -129,9 +165,10 @@ int32_t sd_read(struct sd_desc *desc,
 		uint64_t address,
 		uint64_t len);
 int32_t sd_write(struct sd_desc *desc,
-		 uint8_t *data,
+		 const uint8_t *data,
 		 uint64_t address,
 		 uint64_t len);
+int32_t sd_flush(struct sd_desc *desc);
 
 #endif /* __SD_H__ */
 
@@ -0,0 +1,460 @@
+/***************************************************************************//**
+ *   @file   spi_profiler.c
+ *   @brief  SPI traffic profiler interposed between drivers and SPI platform ops.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "spi_profiler.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read the profiler time base.
+ * @param desc - The profiler descriptor.
+ * @return Timer counter value, 0 if no timer is used.
+ */
+static uint32_t spi_profiler_ticks(struct spi_profiler_desc *desc)
+{
+	uint32_t cnt = 0;
+
+	if (desc->timer)
+		timer_counter_get(desc->timer, &cnt);
+
+	return cnt;
+}
+
+/**
+ * @brief Convert a number of timer ticks to microseconds.
+ * @param desc - The profiler descriptor.
+ * @param ticks - Number of ticks.
+ * @return Number of microseconds.
+ */
+static uint32_t spi_profiler_ticks_to_us(struct spi_profiler_desc *desc,
+		uint32_t ticks)
+{
+	if (!desc->timer || !desc->timer->freq_hz)
+		return 0;
+
+	return (uint32_t)(((uint64_t)ticks * 1000000) / desc->timer->freq_hz);
+}
+
+/**
+ * @brief Extract the register address from the instruction of a transfer.
+ * @param decode - Instruction format.
+ * @param data - Transmitted data.
+ * @param bytes_number - Number of transmitted bytes.
+ * @param addr - Decoded register address.
+ * @param read - Set if the instruction is a read.
+ * @return SUCCESS if an address was decoded, FAILURE otherwise.
+ */
+static int32_t spi_profiler_decode_addr(enum spi_profiler_decode decode,
+					const uint8_t *data,
+					uint16_t bytes_number,
+					uint16_t *addr, uint8_t *read)
+{
+	switch (decode) {
+	case SPI_PROFILER_DECODE_ADI_8BIT:
+		if (bytes_number < 1)
+			return FAILURE;
+		*read = !!(data[0] & 0x80);
+		*addr = data[0] & 0x7F;
+		break;
+	case SPI_PROFILER_DECODE_ADI_8BIT_RW6:
+		if (bytes_number < 1)
+			return FAILURE;
+		*read = !!(data[0] & 0x40);
+		*addr = data[0] & 0x3F;
+		break;
+	case SPI_PROFILER_DECODE_ADI_16BIT:
+		if (bytes_number < 2)
+			return FAILURE;
+		*read = !!(data[0] & 0x80);
+		*addr = ((data[0] & 0x7F) << 8) | data[1];
+		break;
+	default:
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Find or allocate the statistics of a register address.
+ * @param stats - Descriptor statistics.
+ * @param addr - Register address.
+ * @return Register statistics, NULL if the table is full.
+ */
+static struct spi_profiler_reg_stats *spi_profiler_get_reg(
+	struct spi_profiler_stats *stats, uint16_t addr)
+{
+	uint16_t low = 0;
+	uint16_t high = stats->num_regs;
+	uint16_t mid;
+
+	/* Table kept sorted by address */
+	while (low < high) {
+		mid = low + (high - low) / 2;
+		if (stats->regs[mid].addr == addr)
+			return &stats->regs[mid];
+		if (stats->regs[mid].addr < addr)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if (stats->num_regs >= SPI_PROFILER_MAX_REGS)
+		return NULL;
+
+	memmove(&stats->regs[low + 1], &stats->regs[low],
+		(stats->num_regs - low) * sizeof(stats->regs[0]));
+	memset(&stats->regs[low], 0, sizeof(stats->regs[0]));
+	stats->regs[low].addr = addr;
+	stats->num_regs++;
+
+	return &stats->regs[low];
+}
+
+/**
+ * @brief Account one transfer.
+ * @param desc - The profiler descriptor.
+ * @param data - Transmitted data (instruction bytes).
+ * @param bytes_number - Number of bytes.
+ * @param us - Duration of the transfer.
+ * @param ret - Return code of the platform driver.
+ */
+static void spi_profiler_record(struct spi_profiler_desc *desc,
+				const uint8_t *data, uint16_t bytes_number,
+				uint32_t us, int32_t ret)
+{
+	struct spi_profiler_stats *stats = &desc->stats;
+	struct spi_profiler_reg_stats *reg;
+	uint32_t hist_us = us;
+	uint8_t bin = 0;
+	uint16_t addr;
+	uint8_t read;
+
+	stats->transfers++;
+	stats->bytes += bytes_number;
+	stats->time_us += us;
+	if (us > stats->max_us)
+		stats->max_us = us;
+	if (ret != SUCCESS)
+		stats->errors++;
+
+	while (hist_us && bin < SPI_PROFILER_HIST_BINS - 1) {
+		hist_us >>= 1;
+		bin++;
+	}
+	stats->hist[bin]++;
+
+	if (spi_profiler_decode_addr(desc->decode, data, bytes_number, &addr,
+				     &read) != SUCCESS)
+		return;
+
+	reg = spi_profiler_get_reg(stats, addr);
+	if (!reg) {
+		stats->regs_dropped++;
+		return;
+	}
+
+	if (read)
+		reg->reads++;
+	else
+		reg->writes++;
+	reg->time_us += us;
+}
+
+/**
+ * @brief Initialize the profiled SPI controller.
+ * @param desc - The SPI descriptor.
+ * @param param - The structure that contains the SPI parameters. The extra
+ *                field must point to a struct spi_profiler_init_param.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t spi_profiler_init(struct spi_desc **desc,
+				 const struct spi_init_param *param)
+{
+	struct spi_profiler_init_param *prof_init;
+	struct spi_profiler_desc *prof;
+	struct spi_init_param spi_param;
+	struct spi_desc *descriptor;
+	int32_t ret;
+
+	if (!param || !param->extra)
+		return FAILURE;
+
+	prof_init = param->extra;
+	if (!prof_init->platform_ops)
+		return FAILURE;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	prof = calloc(1, sizeof(*prof));
+	if (!prof)
+		goto free_desc;
+
+	spi_param = *param;
+	spi_param.platform_ops = prof_init->platform_ops;
+	spi_param.extra = prof_init->extra;
+	ret = spi_init(&prof->spi, &spi_param);
+	if (ret != SUCCESS)
+		goto free_prof;
+
+	prof->name = prof_init->name ? prof_init->name : "spi";
+	prof->decode = prof_init->decode;
+	prof->timer = prof_init->timer;
+
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->chip_select = param->chip_select;
+	descriptor->mode = param->mode;
+	descriptor->bit_order = param->bit_order;
+	descriptor->extra = prof;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+
+free_prof:
+	free(prof);
+free_desc:
+	free(descriptor);
+
+	return FAILURE;
+}
+
+/**
+ * @brief Write and read data to/from SPI, recording the transfer.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return Return code of the profiled SPI controller.
+ */
+static int32_t spi_profiler_write_and_read(struct spi_desc *desc,
+		uint8_t *data,
+		uint16_t bytes_number)
+{
+	struct spi_profiler_desc *prof = desc->extra;
+	uint8_t instr[2] = {0};
+	uint32_t start;
+	uint32_t us;
+	int32_t ret;
+
+	/* The buffer is overwritten with the received data, keep the instruction */
+	memcpy(instr, data, bytes_number < sizeof(instr) ? bytes_number :
+	       sizeof(instr));
+
+	start = spi_profiler_ticks(prof);
+	ret = spi_write_and_read(prof->spi, data, bytes_number);
+	us = spi_profiler_ticks_to_us(prof, spi_profiler_ticks(prof) - start);
+
+	spi_profiler_record(prof, instr, bytes_number, us, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by spi_profiler_init().
+ * @param desc - The SPI descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t spi_profiler_remove(struct spi_desc *desc)
+{
+	struct spi_profiler_desc *prof;
+	int32_t ret;
+
+	if (!desc)
+		return FAILURE;
+
+	prof = desc->extra;
+	ret = spi_remove(prof->spi);
+	free(prof);
+	free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Clear the traffic recorded for a profiled descriptor.
+ * @param desc - The SPI descriptor, initialized with spi_profiler_platform_ops.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t spi_profiler_reset(struct spi_desc *desc)
+{
+	struct spi_profiler_desc *prof;
+
+	if (!desc || desc->platform_ops != &spi_profiler_platform_ops)
+		return FAILURE;
+
+	prof = desc->extra;
+	memset(&prof->stats, 0, sizeof(prof->stats));
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the traffic recorded for a profiled descriptor.
+ * @param desc - The SPI descriptor, initialized with spi_profiler_platform_ops.
+ * @return Pointer to the statistics, NULL if desc is not profiled.
+ */
+struct spi_profiler_stats *spi_profiler_get_stats(struct spi_desc *desc)
+{
+	struct spi_profiler_desc *prof;
+
+	if (!desc || desc->platform_ops != &spi_profiler_platform_ops)
+		return NULL;
+
+	prof = desc->extra;
+
+	return &prof->stats;
+}
+
+/**
+ * @brief Format the recorded traffic as text.
+ * @param desc - The SPI descriptor, initialized with spi_profiler_platform_ops.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @param max_regs - Number of busiest registers to list.
+ * @return Number of characters written, FAILURE if desc is not profiled.
+ */
+int32_t spi_profiler_snprint(struct spi_desc *desc, char *buf, size_t len,
+			     uint16_t max_regs)
+{
+	struct spi_profiler_reg_stats *reg, *busiest;
+	struct spi_profiler_stats *stats;
+	struct spi_profiler_desc *prof;
+	uint8_t listed[SPI_PROFILER_MAX_REGS] = {0};
+	size_t cnt = 0;
+	uint16_t i, j;
+
+	stats = spi_profiler_get_stats(desc);
+	if (!stats || !buf)
+		return FAILURE;
+
+	prof = desc->extra;
+
+#define SPI_PROFILER_PRINT(fmt, args...) do { \
+	if (cnt < len) \
+		cnt += snprintf(buf + cnt, len - cnt, fmt, ##args); \
+} while (0)
+
+	SPI_PROFILER_PRINT("%s: %"PRIu32" transfers, %"PRIu64" bytes, %"PRIu64
+			   " us, max %"PRIu32" us, %"PRIu32" errors\n",
+			   prof->name, stats->transfers, stats->bytes,
+			   stats->time_us, stats->max_us, stats->errors);
+
+	SPI_PROFILER_PRINT("latency histogram (us):");
+	for (i = 0; i < SPI_PROFILER_HIST_BINS - 1; i++)
+		if (stats->hist[i])
+			SPI_PROFILER_PRINT(" <%lu:%"PRIu32, 1ul << i,
+					   stats->hist[i]);
+	if (stats->hist[i])
+		SPI_PROFILER_PRINT(" >=%lu:%"PRIu32, 1ul << (i - 1),
+				   stats->hist[i]);
+	SPI_PROFILER_PRINT("\n");
+
+	/* Registers sorted by bus time, then by number of accesses */
+	for (i = 0; i < max_regs && i < stats->num_regs; i++) {
+		busiest = NULL;
+		for (j = 0; j < stats->num_regs; j++) {
+			reg = &stats->regs[j];
+			if (listed[j])
+				continue;
+			if (!busiest || reg->time_us > busiest->time_us ||
+			    (reg->time_us == busiest->time_us &&
+			     reg->reads + reg->writes >
+			     busiest->reads + busiest->writes))
+				busiest = reg;
+		}
+		listed[busiest - stats->regs] = 1;
+		SPI_PROFILER_PRINT("reg 0x%04x: %"PRIu32" rd %"PRIu32" wr %"PRIu64
+				   " us\n", busiest->addr, busiest->reads,
+				   busiest->writes, busiest->time_us);
+	}
+
+	if (stats->regs_dropped)
+		SPI_PROFILER_PRINT("%"PRIu32" transfers to untracked registers\n",
+				   stats->regs_dropped);
+
+#undef SPI_PROFILER_PRINT
+
+	return cnt < len ? cnt : len;
+}
+
+/**
+ * @brief Print the recorded traffic on the standard output (UART).
+ * @param desc - The SPI descriptor, initialized with spi_profiler_platform_ops.
+ */
+void spi_profiler_dump(struct spi_desc *desc)
+{
+	char buf[256];
+	struct spi_profiler_stats *stats;
+	struct spi_profiler_desc *prof;
+	uint16_t i;
+
+	stats = spi_profiler_get_stats(desc);
+	if (!stats)
+		return;
+
+	prof = desc->extra;
+
+	spi_profiler_snprint(desc, buf, sizeof(buf), 0);
+	printf("%s", buf);
+	for (i = 0; i < stats->num_regs; i++)
+		printf("%s reg 0x%04x: %"PRIu32" rd %"PRIu32" wr %"PRIu64" us\n",
+		       prof->name, stats->regs[i].addr, stats->regs[i].reads,
+		       stats->regs[i].writes, stats->regs[i].time_us);
+}
+
+/**
+ * @brief SPI profiler platform ops structure
+ */
+const struct spi_platform_ops spi_profiler_platform_ops = {
+	.spi_ops_init = &spi_profiler_init,
+	.spi_ops_write_and_read = &spi_profiler_write_and_read,
+	.spi_ops_remove = &spi_profiler_remove
+};
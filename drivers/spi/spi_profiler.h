@@ -0,0 +1,177 @@
+/***************************************************************************//**
+ *   @file   spi_profiler.h
+ *   @brief  Header file of the SPI traffic profiler.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SPI_PROFILER_H_
+#define SPI_PROFILER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "spi.h"
+#include "timer.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Number of log2(us) latency histogram bins. Last bin collects the rest. */
+#define SPI_PROFILER_HIST_BINS		16
+/** Number of distinct register addresses tracked per descriptor */
+#define SPI_PROFILER_MAX_REGS		64
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum spi_profiler_decode
+ * @brief Instruction format used to extract the register address from the
+ * first bytes of each transfer.
+ */
+enum spi_profiler_decode {
+	/** Do not decode, only account transfers */
+	SPI_PROFILER_DECODE_NONE,
+	/** ADI 8-bit instruction: R/W bit 7, address bits 6:0 */
+	SPI_PROFILER_DECODE_ADI_8BIT,
+	/** ADI 8-bit instruction with R/W bit 6, address bits 5:0 (AD7124) */
+	SPI_PROFILER_DECODE_ADI_8BIT_RW6,
+	/** ADI 16-bit instruction: R/W bit 15, address bits 14:0 (3/4-wire) */
+	SPI_PROFILER_DECODE_ADI_16BIT,
+};
+
+/**
+ * @struct spi_profiler_reg_stats
+ * @brief Traffic recorded for one register address.
+ */
+struct spi_profiler_reg_stats {
+	/** Register address */
+	uint16_t addr;
+	/** Number of read transfers */
+	uint32_t reads;
+	/** Number of write transfers */
+	uint32_t writes;
+	/** Time spent on the bus for this register (us) */
+	uint64_t time_us;
+};
+
+/**
+ * @struct spi_profiler_stats
+ * @brief Traffic recorded for one SPI descriptor.
+ */
+struct spi_profiler_stats {
+	/** Number of transfers */
+	uint32_t transfers;
+	/** Number of failed transfers */
+	uint32_t errors;
+	/** Number of bytes clocked on the bus */
+	uint64_t bytes;
+	/** Total time spent in the platform driver (us) */
+	uint64_t time_us;
+	/** Longest transfer (us) */
+	uint32_t max_us;
+	/** Transfers with latency in [2^(i-1), 2^i) us, bin 0 is < 1 us */
+	uint32_t hist[SPI_PROFILER_HIST_BINS];
+	/** Number of valid entries in regs */
+	uint16_t num_regs;
+	/** Transfers whose register did not fit in regs */
+	uint32_t regs_dropped;
+	/** Per register traffic */
+	struct spi_profiler_reg_stats regs[SPI_PROFILER_MAX_REGS];
+};
+
+/**
+ * @struct spi_profiler_init_param
+ * @brief Parameters of the profiler, passed as spi_init_param.extra together
+ * with spi_profiler_platform_ops.
+ */
+struct spi_profiler_init_param {
+	/** Name printed in reports */
+	const char *name;
+	/** Platform ops of the profiled SPI controller */
+	const struct spi_platform_ops *platform_ops;
+	/** Extra parameters of the profiled SPI controller */
+	void *extra;
+	/** Register address decoding */
+	enum spi_profiler_decode decode;
+	/** Free running, up counting timer used for timing. May be NULL. */
+	struct timer_desc *timer;
+};
+
+/**
+ * @struct spi_profiler_desc
+ * @brief Profiler state, available as spi_desc.extra.
+ */
+struct spi_profiler_desc {
+	/** Name printed in reports */
+	const char *name;
+	/** Descriptor of the profiled SPI controller */
+	struct spi_desc *spi;
+	/** Register address decoding */
+	enum spi_profiler_decode decode;
+	/** Timer used for timing */
+	struct timer_desc *timer;
+	/** Recorded traffic */
+	struct spi_profiler_stats stats;
+};
+
+/**
+ * @brief SPI profiler platform ops structure
+ */
+extern const struct spi_platform_ops spi_profiler_platform_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Clear the traffic recorded for a profiled descriptor. */
+int32_t spi_profiler_reset(struct spi_desc *desc);
+
+/* Get the traffic recorded for a profiled descriptor. */
+struct spi_profiler_stats *spi_profiler_get_stats(struct spi_desc *desc);
+
+/* Format the recorded traffic as text. */
+int32_t spi_profiler_snprint(struct spi_desc *desc, char *buf, size_t len,
+			     uint16_t max_regs);
+
+/* Print the recorded traffic on the standard output (UART). */
+void spi_profiler_dump(struct spi_desc *desc);
+
+#endif // SPI_PROFILER_H_
@@ -40,7 +40,13 @@
 #include <inttypes.h>
 #include "tdm.h"
 #include <stdlib.h>
+#include <errno.h>
+#include "circular_buffer.h"
 #include "error.h"
+#include "delay.h"
+
+/** Interval at which tdm_stream_read() checks the ring buffer, in microseconds */
+#define TDM_STREAM_POLL_US	10
 
 /**
  * @brief Initialize the TDM communication peripheral.
@@ -58,6 +64,12 @@ int32_t tdm_init(struct tdm_desc **desc,
 		return FAILURE;
 
 	(*desc)->platform_ops = param->platform_ops;
+	if (param->data_size <= 8)
+		(*desc)->sample_bytes = 1;
+	else if (param->data_size <= 16)
+		(*desc)->sample_bytes = 2;
+	else
+		(*desc)->sample_bytes = 4;
 
 	return SUCCESS;
 }
@@ -69,6 +81,9 @@ int32_t tdm_init(struct tdm_desc **desc,
  */
 int32_t tdm_remove(struct tdm_desc *desc)
 {
+	if (desc->ring)
+		tdm_stream_stop(desc);
+
 	return desc->platform_ops->tdm_ops_remove(desc);
 }
 
@@ -99,3 +114,144 @@ int32_t tdm_write(struct tdm_desc *desc,
 {
 	return desc->platform_ops->tdm_ops_write(desc, data, nb_samples);
 }
+
+/**
+ * @brief Copy a received block to the ring buffer and pass it to the user.
+ * @param ctx - The TDM descriptor.
+ * @param block - The received block.
+ * @param nb_samples - Number of samples in the block.
+ */
+static void tdm_stream_push(void *ctx, void *block, uint32_t nb_samples)
+{
+	struct tdm_desc *desc = ctx;
+
+	cb_write(desc->ring, block, nb_samples * desc->sample_bytes);
+
+	if (desc->callback)
+		desc->callback(desc->ctx, block, nb_samples);
+}
+
+/**
+ * @brief Start continuous capture. The platform keeps receiving in the two
+ * halves of the stream buffer, each filled half is passed to the callback and,
+ * if a ring buffer is requested, copied to it for tdm_stream_read().
+ * @param desc - The TDM descriptor.
+ * @param param - The stream parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t tdm_stream_start(struct tdm_desc *desc,
+			 const struct tdm_stream_param *param)
+{
+	int32_t ret;
+
+	if (!desc || !param || !param->buffer || !param->nb_samples ||
+	    (param->nb_samples % 2))
+		return -EINVAL;
+
+	if (!desc->platform_ops->tdm_ops_stream_start)
+		return -ENOTSUP;
+
+	if (desc->ring)
+		return -EBUSY;
+
+	desc->callback = param->callback;
+	desc->ctx = param->ctx;
+
+	if (!param->ring_samples)
+		return desc->platform_ops->tdm_ops_stream_start(desc,
+				param->buffer, param->nb_samples,
+				param->callback, param->ctx);
+
+	ret = cb_init(&desc->ring, param->ring_samples * desc->sample_bytes);
+	if (ret != SUCCESS)
+		return ret;
+
+	desc->ring_samples = param->ring_samples;
+	desc->read_timeout_us = param->read_timeout_us ? param->read_timeout_us :
+				TDM_STREAM_READ_TIMEOUT_US;
+
+	ret = desc->platform_ops->tdm_ops_stream_start(desc, param->buffer,
+			param->nb_samples, tdm_stream_push, desc);
+	if (ret != SUCCESS) {
+		cb_remove(desc->ring);
+		desc->ring = NULL;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Stop continuous capture and free the ring buffer.
+ * @param desc - The TDM descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t tdm_stream_stop(struct tdm_desc *desc)
+{
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->platform_ops->tdm_ops_stream_stop)
+		return -ENOTSUP;
+
+	ret = desc->platform_ops->tdm_ops_stream_stop(desc);
+
+	if (desc->ring) {
+		cb_remove(desc->ring);
+		desc->ring = NULL;
+	}
+	desc->ring_samples = 0;
+	desc->callback = NULL;
+	desc->ctx = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Read captured samples from the stream ring buffer, waiting until
+ * enough samples were received. Meant to be called from an IIO device
+ * read_dev() so the capture keeps running between buffer refills. No IIO
+ * driver of a TDM based ADC (ad713x, ad7768) exists in the tree yet, so the
+ * function has no caller for now.
+ * @param desc - The TDM descriptor.
+ * @param data - The buffer to store the samples.
+ * @param nb_samples - Number of samples to read, at most the ring size.
+ * @return SUCCESS in case of success, -EOVERRUN if samples were lost because
+ * the ring buffer was not read fast enough, -ETIMEDOUT if the samples did not
+ * arrive in the read timeout, negative error code otherwise.
+ */
+int32_t tdm_stream_read(struct tdm_desc *desc,
+			void *data,
+			uint32_t nb_samples)
+{
+	uint32_t timeout;
+	uint32_t avail;
+	uint32_t size;
+	int32_t ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	if (!desc->ring || nb_samples > desc->ring_samples)
+		return -EINVAL;
+
+	if (!nb_samples)
+		return SUCCESS;
+
+	/* Wait here, cb_read() would spin forever if the capture stopped */
+	size = nb_samples * desc->sample_bytes;
+	timeout = desc->read_timeout_us / TDM_STREAM_POLL_US;
+	while (true) {
+		ret = cb_size(desc->ring, &avail);
+		if (ret == -EOVERRUN || (ret == SUCCESS && avail >= size))
+			break;
+		if (ret != SUCCESS)
+			return ret;
+		if (!timeout--)
+			return -ETIMEDOUT;
+		udelay(TDM_STREAM_POLL_US);
+	}
+
+	return cb_read(desc->ring, data, size);
+}
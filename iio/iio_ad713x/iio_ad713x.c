@@ -75,14 +75,33 @@ ssize_t iio_ad713x_transfer_dev_to_mem(void *iio_inst, size_t bytes_count,
 	iio_713x_inst = (struct iio_ad713x *)iio_inst;
 	bytes = (bytes_count * iio_713x_inst->dev_descriptor.num_ch);
 
+	/*
+	 * The length of the offload transfer depends on the SPI Engine word
+	 * size, so the whole receive buffer is handed over.
+	 */
+	if (iio_713x_inst->rx_buf) {
+		ret = dma_buf_sync_for_device(iio_713x_inst->rx_buf, 0,
+					      iio_713x_inst->rx_buf->size,
+					      DMA_BUF_FROM_DEVICE);
+		if (ret < 0)
+			return ret;
+	}
+
 	ret = spi_engine_offload_transfer(iio_713x_inst->spi_eng_desc,
 					  *(iio_713x_inst->spi_engine_offload_message), bytes);
 	if (ret < 0)
 		return ret;
 
-	if (iio_713x_inst->dcache_invalidate_range)
+	if (iio_713x_inst->rx_buf) {
+		ret = dma_buf_sync_for_cpu(iio_713x_inst->rx_buf, 0,
+					   iio_713x_inst->rx_buf->size,
+					   DMA_BUF_FROM_DEVICE);
+		if (ret < 0)
+			return ret;
+	} else if (iio_713x_inst->dcache_invalidate_range) {
 		iio_713x_inst->dcache_invalidate_range(
-			iio_713x_inst->spi_engine_offload_message->tx_addr, bytes);
+			iio_713x_inst->spi_engine_offload_message->rx_addr, bytes);
+	}
 
 	return bytes_count;
 }
@@ -105,6 +124,7 @@ ssize_t iio_ad713x_read_dev(void *iio_inst, char *pbuf, size_t offset,
 {
 	struct iio_ad713x *iio_713x_inst;
 	uint32_t i, j = 0, current_ch = 0, offload_data;
+	uintptr_t rx_data;
 	uint16_t *pbuf16;
 	size_t samples;
 
@@ -117,11 +137,14 @@ ssize_t iio_ad713x_read_dev(void *iio_inst, char *pbuf, size_t offset,
 			  ch_mask);
 	samples /= 2; /* because of uint16_t *pbuf16 = (uint16_t*)pbuf; */
 	offset = (offset * iio_713x_inst->dev_descriptor.num_ch) / hweight8(ch_mask);
+	if (iio_713x_inst->rx_buf)
+		rx_data = (uintptr_t)iio_713x_inst->rx_buf->cpu_addr;
+	else
+		rx_data = iio_713x_inst->spi_engine_offload_message->rx_addr;
 
 	for (i = 0; i < samples; i++) {
 		if (ch_mask & BIT(current_ch)) {
-			offload_data = *(uint32_t*)(iio_713x_inst->spi_engine_offload_message->rx_addr +
-						    offset + i * 4);
+			offload_data = *(uint32_t*)(rx_data + offset + i * 4);
 			offload_data <<= 1;
 			offload_data &= 0xffffff00;
 			offload_data >>= 8;
@@ -167,6 +190,10 @@ int32_t iio_ad713x_init(struct iio_ad713x **desc,
 	iio_ad713x->spi_eng_desc = param->spi_eng_desc;
 	iio_ad713x->spi_engine_offload_message = param->spi_engine_offload_message;
 	iio_ad713x->dcache_invalidate_range = param->dcache_invalidate_range;
+	iio_ad713x->rx_buf = param->rx_buf;
+	if (param->rx_buf)
+		iio_ad713x->spi_engine_offload_message->rx_addr =
+			param->rx_buf->bus_addr;
 
 	iio_ad713x->dev_descriptor.num_ch = param->num_channels;
 	iio_ad713x->dev_descriptor.channels = NULL;
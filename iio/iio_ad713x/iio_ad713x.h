@@ -46,6 +46,7 @@
 #include <stdio.h>
 #include "iio_types.h"
 #include "spi.h"
+#include "dma_buf.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -64,6 +65,10 @@ struct iio_ad713x_init_par {
 	struct spi_engine_offload_message *spi_engine_offload_message;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Optional, receive buffer allocated from a DMA buffer region. When
+	 *  set, it replaces the rx_addr of the offload message and is synced
+	 *  instead of calling dcache_invalidate_range */
+	struct dma_buf *rx_buf;
 };
 
 struct iio_ad713x {
@@ -75,6 +80,8 @@ struct iio_ad713x {
 	struct spi_engine_offload_message *spi_engine_offload_message;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Receive buffer allocated from a DMA buffer region */
+	struct dma_buf *rx_buf;
 };
 
 /******************************************************************************/
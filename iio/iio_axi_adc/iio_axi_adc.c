@@ -347,6 +347,35 @@ int32_t iio_axi_adc_prepare_transfer(void *dev, uint32_t mask)
 	return axi_adc_update_active_channels(iio_adc->adc, mask);
 }
 
+/**
+ * @brief Capture into a buffer allocated from the DMA buffer region.
+ * @param iio_adc - Instance of the iio_axi_adc
+ * @param buff - Buffer where to read samples
+ * @param bytes - Number of bytes to read
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_read_dma_buf(struct iio_axi_adc_desc *iio_adc,
+					void *buff, uint32_t bytes)
+{
+	struct dma_buf *buf;
+	uint32_t offset;
+	int32_t ret;
+
+	ret = dma_buf_lookup(iio_adc->dma_region, buff, &buf, &offset);
+	if (ret < 0)
+		return ret;
+
+	ret = dma_buf_sync_for_device(buf, offset, bytes, DMA_BUF_FROM_DEVICE);
+	if (ret < 0)
+		return ret;
+
+	ret = axi_dmac_transfer(iio_adc->dmac, buf->bus_addr + offset, bytes);
+	if (ret < 0)
+		return ret;
+
+	return dma_buf_sync_for_cpu(buf, offset, bytes, DMA_BUF_FROM_DEVICE);
+}
+
 /**
  * @brief Update active channels
  * @param dev - Instance of the iio_axi_adc
@@ -366,6 +395,9 @@ int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
 	bytes = nb_samples * hweight8(iio_adc->mask) * (STORAGE_BITS / 8);
 
 	iio_adc->dmac->flags = 0;
+	if (iio_adc->dma_region)
+		return iio_axi_adc_read_dma_buf(iio_adc, buff, bytes);
+
 	ret = axi_dmac_transfer(iio_adc->dmac, (uint32_t)buff, bytes);
 	if (ret < 0)
 		return ret;
@@ -495,6 +527,7 @@ int32_t iio_axi_adc_init(struct iio_axi_adc_desc **desc,
 	iio_axi_adc_inst->adc = init->rx_adc;
 	iio_axi_adc_inst->dmac = init->rx_dmac;
 	iio_axi_adc_inst->dcache_invalidate_range = init->dcache_invalidate_range;
+	iio_axi_adc_inst->dma_region = init->dma_region;
 	iio_axi_adc_inst->get_sampling_frequency = init->get_sampling_frequency;
 
 	status = iio_axi_adc_create_device_descriptor(iio_axi_adc_inst,
@@ -47,6 +47,7 @@
 #include "iio_types.h"
 #include "axi_adc_core.h"
 #include "axi_dmac.h"
+#include "dma_buf.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -65,6 +66,8 @@ struct iio_axi_adc_desc {
 	struct axi_dmac *dmac;
 	/** Invalidate cache memory function pointer */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Region the capture buffers are allocated from */
+	struct dma_buf_region *dma_region;
 	/** Custom implementation for get sampling frequency */
 	int (*get_sampling_frequency)(struct axi_adc *dev, uint32_t chan,
 				      uint64_t *sampling_freq_hz);
@@ -85,6 +88,10 @@ struct iio_axi_adc_init_param {
 	struct axi_dmac *rx_dmac;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
+	/** Optional, region the capture buffers are allocated from. When set,
+	 *  buffers are transferred at their bus address and synced through it
+	 *  instead of dcache_invalidate_range */
+	struct dma_buf_region *dma_region;
 	/** Custom sampling frequency getter */
 	int (*get_sampling_frequency)(struct axi_adc *dev, uint32_t chan,
 				      uint64_t *sampling_freq_hz);
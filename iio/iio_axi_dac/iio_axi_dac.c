@@ -55,6 +55,15 @@
 /******************************************************************************/
 
 #define STORAGE_BITS 16
+/* Slot alignment, keeps the slots on separate cache lines */
+#define STREAM_SLOT_ALIGN 64
+
+enum iio_axi_dac_buffer_attr {
+	STREAM_ENABLE,
+	STREAM_QUEUE_DEPTH,
+	STREAM_QUEUED,
+	STREAM_UNDERFLOWS,
+};
 
 /**
  * @brief get_dds_calibscale().
@@ -459,6 +468,302 @@ static struct iio_attribute iio_altvoltage_attributes[] = {
 	END_ATTRIBUTES_ARRAY,
 };
 
+/**
+ * @brief Split the stream memory in depth slots.
+ * @param iio_dac - Instance of the iio_axi_dac.
+ * @param depth - Number of slots.
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_stream_set_depth(struct iio_axi_dac_desc *iio_dac,
+		uint32_t depth)
+{
+	struct iio_axi_dac_stream *stream = &iio_dac->stream;
+	uint32_t slot_size;
+
+	if (!depth || depth > IIO_AXI_DAC_STREAM_MAX_DEPTH)
+		return -EINVAL;
+
+	slot_size = stream->buff_size / depth;
+	slot_size -= slot_size % STREAM_SLOT_ALIGN;
+	if (!slot_size)
+		return -EINVAL;
+
+	stream->depth = depth;
+	stream->slot_size = slot_size;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Retire the slots played by the DMAC, hand it the filled ones and
+ * account for the gaps in between.
+ * @param desc - Instance of the iio_axi_dac.
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+int32_t iio_axi_dac_stream_poll(struct iio_axi_dac_desc *desc)
+{
+	struct iio_axi_dac_stream *stream;
+	struct axi_dmac *dmac;
+	uint32_t reg_val;
+	uint32_t slot;
+	uint32_t addr;
+
+	if (!desc)
+		return -EINVAL;
+
+	stream = &desc->stream;
+	dmac = desc->dmac;
+	if (!stream->enabled)
+		return SUCCESS;
+
+	if (stream->tail != stream->submitted) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &reg_val);
+		while (stream->tail != stream->submitted &&
+		       (reg_val & BIT(stream->id[stream->tail % stream->depth])))
+			stream->tail++;
+	}
+
+	if (stream->tail == stream->submitted && stream->submitted &&
+	    stream->submitted == stream->head && !stream->starved) {
+		stream->starved = true;
+		stream->underflows++;
+	}
+
+	while (stream->submitted != stream->head) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_START_TRANSFER, &reg_val);
+		if (reg_val & 1)
+			break;
+
+		slot = stream->submitted % stream->depth;
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID, &reg_val);
+		stream->id[slot] = reg_val;
+
+		if (stream->dma)
+			addr = stream->dma->bus_addr + stream->dma_offset +
+			       slot * stream->slot_size;
+		else
+			addr = (uint32_t)(uintptr_t)(stream->buff +
+						     slot * stream->slot_size);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, stream->bytes[slot] - 1);
+		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_START_TRANSFER, 0x1);
+
+		stream->submitted++;
+		stream->starved = false;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Wait for the DMAC to play the queued buffers, then reset the queue.
+ * @param iio_dac - Instance of the iio_axi_dac.
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_stream_drain(struct iio_axi_dac_desc *iio_dac)
+{
+	struct iio_axi_dac_stream *stream = &iio_dac->stream;
+	uint32_t underflows = stream->underflows;
+	uint32_t timeout = 0;
+	int32_t ret = SUCCESS;
+
+	while (stream->tail != stream->head) {
+		iio_axi_dac_stream_poll(iio_dac);
+		if (++timeout == UINT32_MAX) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+	}
+	/* Everything is queued, running dry at the end is not an underflow */
+	stream->underflows = underflows;
+
+	axi_dmac_write(iio_dac->dmac, AXI_DMAC_REG_CTRL, 0x0);
+	stream->head = 0;
+	stream->submitted = 0;
+	stream->tail = 0;
+	stream->starved = false;
+
+	return ret;
+}
+
+/**
+ * @brief Queue one buffer in streaming mode. Blocks while the queue is full.
+ * @param iio_dac - Instance of the iio_axi_dac.
+ * @param buff - Samples.
+ * @param bytes - Size of buff in bytes.
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_stream_push(struct iio_axi_dac_desc *iio_dac,
+				       void *buff, uint32_t bytes)
+{
+	struct iio_axi_dac_stream *stream = &iio_dac->stream;
+	uint32_t reg_val;
+	uint32_t timeout = 0;
+	uint32_t offset;
+	uint8_t *slot;
+	int32_t ret;
+
+	if (!bytes || bytes > stream->slot_size ||
+	    (bytes - 1) > iio_dac->dmac->transfer_max_size)
+		return -EINVAL;
+
+	axi_dmac_read(iio_dac->dmac, AXI_DMAC_REG_CTRL, &reg_val);
+	if (!(reg_val & AXI_DMAC_CTRL_ENABLE))
+		axi_dmac_write(iio_dac->dmac, AXI_DMAC_REG_CTRL,
+			       AXI_DMAC_CTRL_ENABLE);
+
+	iio_axi_dac_stream_poll(iio_dac);
+	while (stream->head - stream->tail >= stream->depth) {
+		iio_axi_dac_stream_poll(iio_dac);
+		if (++timeout == UINT32_MAX)
+			return -ETIMEDOUT;
+	}
+
+	offset = (stream->head % stream->depth) * stream->slot_size;
+	slot = stream->buff + offset;
+	if (stream->dma) {
+		offset += stream->dma_offset;
+		ret = dma_buf_sync_for_cpu(stream->dma, offset, bytes,
+					   DMA_BUF_TO_DEVICE);
+		if (ret < 0)
+			return ret;
+		memcpy(slot, buff, bytes);
+		ret = dma_buf_sync_for_device(stream->dma, offset, bytes,
+					      DMA_BUF_TO_DEVICE);
+		if (ret < 0)
+			return ret;
+	} else {
+		memcpy(slot, buff, bytes);
+		if (iio_dac->dcache_flush_range)
+			iio_dac->dcache_flush_range((uint32_t)(uintptr_t)slot, bytes);
+	}
+
+	stream->bytes[stream->head % stream->depth] = bytes;
+	stream->head++;
+
+	return iio_axi_dac_stream_poll(iio_dac);
+}
+
+/**
+ * @brief Show a buffer attribute.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @param priv - Attribute id.
+ * @return Number of bytes written in buf, or negative value on failure.
+ */
+static ssize_t get_buffer_attr(void *device, char *buf, size_t len,
+			       const struct iio_ch_info *channel,
+			       intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+	struct iio_axi_dac_stream *stream = &iio_dac->stream;
+	uint32_t val;
+
+	iio_axi_dac_stream_poll(iio_dac);
+
+	switch (priv) {
+	case STREAM_ENABLE:
+		val = stream->enabled;
+		break;
+	case STREAM_QUEUE_DEPTH:
+		val = stream->depth;
+		break;
+	case STREAM_QUEUED:
+		val = stream->head - stream->tail;
+		break;
+	case STREAM_UNDERFLOWS:
+		val = stream->underflows;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return snprintf(buf, len, "%"PRIu32"", val);
+}
+
+/**
+ * @brief Store a buffer attribute. The queue can only be reconfigured while
+ * it is empty. Writing underflows clears the counter.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @param priv - Attribute id.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static ssize_t set_buffer_attr(void *device, char *buf, size_t len,
+			       const struct iio_ch_info *channel,
+			       intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+	struct iio_axi_dac_stream *stream = &iio_dac->stream;
+	uint32_t val = srt_to_uint32(buf);
+	int32_t ret;
+
+	iio_axi_dac_stream_poll(iio_dac);
+
+	switch (priv) {
+	case STREAM_ENABLE:
+		if (stream->head != stream->tail)
+			return -EBUSY;
+		if (val && !stream->buff)
+			return -ENOENT;
+		/* Stop a cyclic transfer still replaying the last buffer */
+		axi_dmac_write(iio_dac->dmac, AXI_DMAC_REG_CTRL, 0x0);
+		stream->enabled = !!val;
+		break;
+	case STREAM_QUEUE_DEPTH:
+		if (stream->head != stream->tail)
+			return -EBUSY;
+		if (!stream->buff)
+			return -ENOENT;
+		ret = iio_axi_dac_stream_set_depth(iio_dac, val);
+		if (ret < 0)
+			return ret;
+		break;
+	case STREAM_UNDERFLOWS:
+		stream->underflows = 0;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return len;
+}
+
+static struct iio_attribute iio_axi_dac_buffer_attributes[] = {
+	{
+		.name = "stream_enable",
+		.priv = STREAM_ENABLE,
+		.show = get_buffer_attr,
+		.store = set_buffer_attr,
+	},
+	{
+		.name = "queue_depth",
+		.priv = STREAM_QUEUE_DEPTH,
+		.show = get_buffer_attr,
+		.store = set_buffer_attr,
+	},
+	{
+		.name = "queued",
+		.priv = STREAM_QUEUED,
+		.show = get_buffer_attr,
+		.store = NULL,
+	},
+	{
+		.name = "underflows",
+		.priv = STREAM_UNDERFLOWS,
+		.show = get_buffer_attr,
+		.store = set_buffer_attr,
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 /**
  * @brief Update active channels
  * @param dev - Instance of the iio_axi_dac
@@ -483,10 +788,57 @@ int32_t iio_axi_dac_prepare_transfer(void *dev, uint32_t mask)
 	}
 
 	iio_dac->mask = mask;
+	iio_dac->stream.underflows = 0;
 
 	return SUCCESS;
 }
 
+/**
+ * @brief Play the queued buffers before the client releases the device.
+ * @param dev - Instance of the iio_axi_dac
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_end_transfer(void *dev)
+{
+	struct iio_axi_dac_desc *iio_dac = dev;
+
+	if (!iio_dac->stream.enabled)
+		return SUCCESS;
+
+	return iio_axi_dac_stream_drain(iio_dac);
+}
+
+/**
+ * @brief Replay a buffer allocated from the DMA buffer region.
+ * @param iio_dac - Instance of the iio_axi_dac
+ * @param buff - Samples, already written by the CPU
+ * @param bytes - Size of buff in bytes
+ * @return SUCCESS in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_write_dma_buf(struct iio_axi_dac_desc *iio_dac,
+		void *buff, uint32_t bytes)
+{
+	struct dma_buf *buf;
+	uint32_t offset;
+	int32_t ret;
+
+	ret = dma_buf_lookup(iio_dac->dma_region, buff, &buf, &offset);
+	if (ret < 0)
+		return ret;
+
+	/* The CPU filled the buffer, take it back before writing it out */
+	ret = dma_buf_sync_for_cpu(buf, offset, bytes, DMA_BUF_TO_DEVICE);
+	if (ret < 0)
+		return ret;
+	ret = dma_buf_sync_for_device(buf, offset, bytes, DMA_BUF_TO_DEVICE);
+	if (ret < 0)
+		return ret;
+
+	iio_dac->dmac->flags = DMA_CYCLIC;
+
+	return axi_dmac_transfer(iio_dac->dmac, buf->bus_addr + offset, bytes);
+}
+
 /**
  * @brief Update active channels
  * @param dev - Instance of the iio_axi_dac
@@ -505,6 +857,12 @@ int32_t iio_axi_dac_write_data(void *dev, void *buff, uint32_t nb_samples)
 	iio_dac = (struct iio_axi_dac_desc *)dev;
 	bytes = nb_samples * hweight8(iio_dac->mask) * (STORAGE_BITS / 8);
 
+	if (iio_dac->stream.enabled)
+		return iio_axi_dac_stream_push(iio_dac, buff, bytes);
+
+	if (iio_dac->dma_region)
+		return iio_axi_dac_write_dma_buf(iio_dac, buff, bytes);
+
 	if(iio_dac->dcache_flush_range)
 		iio_dac->dcache_flush_range((uint32_t)buff, bytes);
 
@@ -609,7 +967,9 @@ static int32_t iio_axi_dac_create_device_descriptor(
 		if (ret < 0)
 			goto error;
 	}
+	iio_device->buffer_attributes = iio_axi_dac_buffer_attributes;
 	iio_device->prepare_transfer = iio_axi_dac_prepare_transfer;
+	iio_device->end_transfer = iio_axi_dac_end_transfer;
 	iio_device->write_dev = iio_axi_dac_write_data;
 
 	return SUCCESS;
@@ -660,6 +1020,32 @@ int32_t iio_axi_dac_init(struct iio_axi_dac_desc **desc,
 	iio_axi_dac_inst->dac = init->tx_dac;
 	iio_axi_dac_inst->dmac = init->tx_dmac;
 	iio_axi_dac_inst->dcache_flush_range = init->dcache_flush_range;
+	iio_axi_dac_inst->dma_region = init->dma_region;
+	iio_axi_dac_inst->stream.buff = init->stream_buff;
+	iio_axi_dac_inst->stream.buff_size = init->stream_buff_size;
+	if (init->stream_buff && init->dma_region) {
+		status = dma_buf_lookup(init->dma_region, init->stream_buff,
+					&iio_axi_dac_inst->stream.dma,
+					&iio_axi_dac_inst->stream.dma_offset);
+		if (!IS_ERR_VALUE(status) && init->stream_buff_size >
+		    iio_axi_dac_inst->stream.dma->size -
+		    iio_axi_dac_inst->stream.dma_offset)
+			status = -EINVAL;
+		if (IS_ERR_VALUE(status)) {
+			free(iio_axi_dac_inst);
+			return status;
+		}
+	}
+	if (init->stream_buff) {
+		status = iio_axi_dac_stream_set_depth(iio_axi_dac_inst,
+						      init->stream_queue_depth ?
+						      init->stream_queue_depth :
+						      IIO_AXI_DAC_STREAM_DEFAULT_DEPTH);
+		if (IS_ERR_VALUE(status)) {
+			free(iio_axi_dac_inst);
+			return status;
+		}
+	}
 
 	status = iio_axi_dac_create_device_descriptor(iio_axi_dac_inst,
 			&iio_axi_dac_inst->dev_descriptor);
@@ -47,11 +47,59 @@
 #include "iio_types.h"
 #include "axi_dac_core.h"
 #include "axi_dmac.h"
+#include "dma_buf.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of buffers queued in streaming mode */
+#define IIO_AXI_DAC_STREAM_MAX_DEPTH		16
+/** Queue depth used when iio_axi_dac_init_param.stream_queue_depth is 0 */
+#define IIO_AXI_DAC_STREAM_DEFAULT_DEPTH	4
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @struct iio_axi_dac_stream
+ * @brief Streaming TX queue. Buffers pushed by the client are copied in
+ * consecutive slots of the stream memory and consumed back-to-back by the
+ * DMAC. The counters are free running, slot = counter % depth.
+ */
+struct iio_axi_dac_stream {
+	/** Streaming instead of cyclic transfers */
+	bool enabled;
+	/** DMA reachable memory holding the slots */
+	uint8_t *buff;
+	/** Size of buff in bytes */
+	uint32_t buff_size;
+	/** Handle of buff when it is allocated from the DMA buffer region */
+	struct dma_buf *dma;
+	/** Offset of buff in dma */
+	uint32_t dma_offset;
+	/** Number of slots buff is split in */
+	uint8_t depth;
+	/** Size of one slot in bytes */
+	uint32_t slot_size;
+	/** Bytes in each slot */
+	uint32_t bytes[IIO_AXI_DAC_STREAM_MAX_DEPTH];
+	/** DMAC transfer id of each submitted slot */
+	uint8_t id[IIO_AXI_DAC_STREAM_MAX_DEPTH];
+	/** Slots filled by the client */
+	uint32_t head;
+	/** Slots handed to the DMAC */
+	uint32_t submitted;
+	/** Slots played by the DMAC */
+	uint32_t tail;
+	/** The DMAC ran out of data, counted once per gap */
+	bool starved;
+	/** Number of gaps in the output since the stream started */
+	uint32_t underflows;
+};
+
+
 /**
  * @struct iio_basic_desc
  * @brief Application desciptor.
@@ -64,6 +112,10 @@ struct iio_axi_dac_desc {
 	uint32_t mask;
 	/** flush contents of instruction and/or data cache */
 	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	/** Region the transmit buffers are allocated from */
+	struct dma_buf_region *dma_region;
+	/** Streaming TX queue */
+	struct iio_axi_dac_stream stream;
 	/** iio device descriptor */
 	struct iio_device dev_descriptor;
 	/** Channel names */
@@ -81,6 +133,16 @@ struct iio_axi_dac_init_param {
 	struct axi_dmac *tx_dmac;
 	/** Function pointer to flush the data cache for the given address range */
 	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	/** Optional, region the transmit buffers and stream_buff are allocated
+	 *  from. When set, buffers are transferred at their bus address and
+	 *  synced through it instead of dcache_flush_range */
+	struct dma_buf_region *dma_region;
+	/** DMA reachable memory for the streaming queue, NULL if not used */
+	void *stream_buff;
+	/** Size of stream_buff in bytes */
+	uint32_t stream_buff_size;
+	/** Initial number of queued buffers, 0 for the default */
+	uint8_t stream_queue_depth;
 };
 
 /******************************************************************************/
@@ -93,6 +155,8 @@ int32_t iio_axi_dac_init(struct iio_axi_dac_desc **desc,
 /** Get device descriptor. */
 void iio_axi_dac_get_dev_descriptor(struct iio_axi_dac_desc *desc,
 				    struct iio_device **dev_descriptor);
+/* Move the streaming queue forward, may be called from the main loop. */
+int32_t iio_axi_dac_stream_poll(struct iio_axi_dac_desc *desc);
 /* Free the resources allocated by iio_axi_dac_init(). */
 int32_t iio_axi_dac_remove(struct iio_axi_dac_desc *desc);
 
@@ -0,0 +1,184 @@
+/***************************************************************************//**
+ *   @file   iio_jesd204_rx.c
+ *   @brief  IIO view of the JESD204 RX link supervisor.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "iio_jesd204_rx.h"
+#include "axi_jesd204_rx.h"
+#include "error.h"
+
+enum iio_jesd204_rx_attributes {
+	IIO_JESD204_RX_LINK_STATE,
+	IIO_JESD204_RX_LINK_IRQS,
+	IIO_JESD204_RX_LINK_RESTARTS,
+	IIO_JESD204_RX_LINK_FAILED_RESTARTS,
+	IIO_JESD204_RX_LINK_RECOVERY_STEPS,
+	IIO_JESD204_RX_LANE_ERRORS,
+	IIO_JESD204_RX_LANE_DESYNCS,
+};
+
+static const char * const iio_jesd204_rx_link_state[] = {
+	[AXI_JESD204_RX_LINK_DOWN] = "down",
+	[AXI_JESD204_RX_LINK_RESET] = "reset",
+	[AXI_JESD204_RX_LINK_WAIT_SYNC] = "wait_sync",
+	[AXI_JESD204_RX_LINK_UP] = "up",
+};
+
+/**
+ * @brief Show a per lane counter, one value per lane separated by spaces.
+ * @param sup - The link supervisor.
+ * @param buf - Output buffer.
+ * @param len - Output buffer size.
+ * @param errors - true for the lane errors, false for the desyncs.
+ * @return Length of the output.
+ */
+static ssize_t iio_jesd204_rx_lanes(struct axi_jesd204_rx_supervisor *sup,
+				    char *buf, size_t len, bool errors)
+{
+	struct axi_jesd204_rx_lane_stats *lane;
+	size_t n = 0;
+	uint32_t i;
+
+	buf[0] = '\0';
+	for (i = 0; i < sup->jesd->num_lanes && n < len; i++) {
+		lane = &sup->stats.lane[i];
+		n += snprintf(buf + n, len - n, "%s%"PRIu32, i ? " " : "",
+			      errors ? lane->errors : lane->desyncs);
+	}
+
+	return n < len ? n : len - 1;
+}
+
+/**
+ * @brief Show the link state or one of the link statistics.
+ * @param device - The link supervisor.
+ * @param buf - Output buffer.
+ * @param len - Output buffer size.
+ * @param channel - Unused.
+ * @param priv - Attribute to show, enum iio_jesd204_rx_attributes.
+ * @return Length of the output, FAILURE otherwise.
+ */
+static ssize_t get_jesd204_rx_attr(void *device, char *buf, size_t len,
+				   const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct axi_jesd204_rx_supervisor *sup = device;
+
+	if (!sup || !len)
+		return FAILURE;
+
+	switch (priv) {
+	case IIO_JESD204_RX_LINK_STATE:
+		return snprintf(buf, len, "%s",
+				iio_jesd204_rx_link_state[sup->state]);
+	case IIO_JESD204_RX_LINK_IRQS:
+		return snprintf(buf, len, "%"PRIu32, sup->stats.irqs);
+	case IIO_JESD204_RX_LINK_RESTARTS:
+		return snprintf(buf, len, "%"PRIu32, sup->stats.restarts);
+	case IIO_JESD204_RX_LINK_FAILED_RESTARTS:
+		return snprintf(buf, len, "%"PRIu32,
+				sup->stats.failed_restarts);
+	case IIO_JESD204_RX_LINK_RECOVERY_STEPS:
+		return snprintf(buf, len, "%"PRIu32,
+				sup->stats.recovery_steps);
+	case IIO_JESD204_RX_LANE_ERRORS:
+		return iio_jesd204_rx_lanes(sup, buf, len, true);
+	case IIO_JESD204_RX_LANE_DESYNCS:
+		return iio_jesd204_rx_lanes(sup, buf, len, false);
+	default:
+		return FAILURE;
+	}
+}
+
+/**
+ * @brief Clear the link statistics, whatever the written value.
+ * @param device - The link supervisor.
+ * @param buf - Input buffer.
+ * @param len - Input buffer size.
+ * @param channel - Unused.
+ * @param priv - Unused.
+ * @return len, FAILURE otherwise.
+ */
+static ssize_t set_jesd204_rx_reset_stats(void *device, char *buf,
+					  size_t len,
+					  const struct iio_ch_info *channel,
+					  intptr_t priv)
+{
+	if (!device)
+		return FAILURE;
+
+	axi_jesd204_rx_supervisor_reset_stats(device);
+
+	return len;
+}
+
+#define IIO_JESD204_RX_ATTR(_name, _priv) {\
+	.name = _name,\
+	.priv = _priv,\
+	.show = get_jesd204_rx_attr,\
+	.store = NULL\
+}
+
+static struct iio_attribute iio_jesd204_rx_attributes[] = {
+	IIO_JESD204_RX_ATTR("link_state", IIO_JESD204_RX_LINK_STATE),
+	IIO_JESD204_RX_ATTR("link_irqs", IIO_JESD204_RX_LINK_IRQS),
+	IIO_JESD204_RX_ATTR("link_restarts", IIO_JESD204_RX_LINK_RESTARTS),
+	IIO_JESD204_RX_ATTR("link_failed_restarts",
+			    IIO_JESD204_RX_LINK_FAILED_RESTARTS),
+	IIO_JESD204_RX_ATTR("link_recovery_steps",
+			    IIO_JESD204_RX_LINK_RECOVERY_STEPS),
+	IIO_JESD204_RX_ATTR("lane_errors", IIO_JESD204_RX_LANE_ERRORS),
+	IIO_JESD204_RX_ATTR("lane_desyncs", IIO_JESD204_RX_LANE_DESYNCS),
+	END_ATTRIBUTES_ARRAY,
+};
+
+static struct iio_attribute iio_jesd204_rx_debug_attributes[] = {
+	{
+		.name = "reset_stats",
+		.show = NULL,
+		.store = set_jesd204_rx_reset_stats
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
+struct iio_device iio_jesd204_rx_descriptor = {
+	.num_ch = 0,
+	.channels = NULL,
+	.attributes = iio_jesd204_rx_attributes,
+	.debug_attributes = iio_jesd204_rx_debug_attributes,
+	.buffer_attributes = NULL,
+};
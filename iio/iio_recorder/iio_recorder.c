@@ -0,0 +1,305 @@
+/***************************************************************************//**
+ *   @file   iio_recorder.c
+ *   @brief  Continuous recorder of IIO device captures to a FatFs file.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "iio_recorder.h"
+#include "error.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Fill the file header: channel mask and scan types of the recorded
+ *        channels.
+ * @param rec - Recorder descriptor.
+ * @param param - Recorder parameters.
+ * @param header - File header, zeroed.
+ * @return SUCCESS in case of success, -EINVAL if a channel is not valid.
+ */
+static int32_t iio_recorder_fill_header(struct iio_recorder *rec,
+					const struct iio_recorder_init_param *param,
+					struct iio_recorder_file_header *header)
+{
+	struct iio_recorder_ch_info	*info;
+	struct scan_type		*scan;
+	uint32_t			storagebits = 0;
+	uint32_t			i;
+
+	header->magic = IIO_RECORDER_FILE_MAGIC;
+	header->version = IIO_RECORDER_VERSION;
+	header->header_size = IIO_RECORDER_HEADER_SIZE;
+	header->block_size = rec->block_size;
+	header->ch_mask = param->ch_mask;
+	header->sample_rate_hz = param->sample_rate_hz;
+
+	for (i = 0; i < param->dev->num_ch && i < IIO_RECORDER_MAX_CH; i++) {
+		if (!(param->ch_mask & (1u << i)))
+			continue;
+		scan = param->dev->channels[i].scan_type;
+		if (!scan || !scan->storagebits || scan->storagebits % 8)
+			return -EINVAL;
+		/* read_dev stores the samples of all the channels on the width
+		 * of the first one */
+		if (!storagebits)
+			storagebits = scan->storagebits;
+
+		info = &header->ch[header->num_ch++];
+		info->index = i;
+		info->sign = scan->sign;
+		info->realbits = scan->realbits;
+		info->storagebits = storagebits;
+		info->shift = scan->shift;
+		info->is_big_endian = scan->is_big_endian;
+	}
+	header->bytes_per_scan = header->num_ch * storagebits / 8;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Create the recording file, write its header and start the device
+ *        transfer.
+ * @param rec - Where to store the recorder descriptor.
+ * @param param - Recorder parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t iio_recorder_init(struct iio_recorder **rec,
+			  const struct iio_recorder_init_param *param)
+{
+	struct iio_recorder_file_header	*header;
+	struct ff_stream_init_param	stream_param;
+	struct iio_recorder		*desc;
+	uint32_t			data_size;
+	int32_t				ret;
+
+	if (!rec || !param || !param->dev || !param->dev->read_dev ||
+	    !param->ch_mask || param->num_blocks < 2 ||
+	    !param->block_size ||
+	    param->block_size % IIO_RECORDER_HEADER_SIZE)
+		return -EINVAL;
+	if (param->dev->num_ch < IIO_RECORDER_MAX_CH &&
+	    param->ch_mask >> param->dev->num_ch)
+		return -EINVAL;
+
+	desc = calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+	desc->dev = param->dev;
+	desc->dev_instance = param->dev_instance;
+	desc->block_size = param->block_size;
+	desc->num_blocks = param->num_blocks;
+	desc->get_time_us = param->get_time_us;
+
+	desc->ring = calloc(desc->num_blocks, desc->block_size);
+	if (!desc->ring) {
+		ret = -ENOMEM;
+		goto error_desc;
+	}
+
+	/* The first block of the ring holds the file header until written */
+	header = (struct iio_recorder_file_header *)desc->ring;
+	ret = iio_recorder_fill_header(desc, param, header);
+	if (ret != SUCCESS)
+		goto error_ring;
+	data_size = desc->block_size - sizeof(struct iio_recorder_block_header);
+	desc->nb_samples = data_size / header->bytes_per_scan;
+	if (!desc->nb_samples) {
+		ret = -EINVAL;
+		goto error_ring;
+	}
+	if (desc->get_time_us)
+		header->start_us = desc->get_time_us();
+
+	/* Blocks are sector multiples, written straight from the ring */
+	stream_param = (struct ff_stream_init_param) {
+		.path = param->path,
+		.mode = FF_STREAM_WRITE,
+		.size = param->file_size,
+		.buffer_size = IIO_RECORDER_HEADER_SIZE,
+	};
+	ret = ff_stream_open(&desc->stream, &stream_param);
+	if (ret != SUCCESS)
+		goto error_ring;
+	ret = ff_stream_write(desc->stream, header, IIO_RECORDER_HEADER_SIZE);
+	if (ret != SUCCESS)
+		goto error_stream;
+	memset(header, 0, IIO_RECORDER_HEADER_SIZE);
+
+	if (desc->dev->prepare_transfer) {
+		ret = desc->dev->prepare_transfer(desc->dev_instance,
+						  param->ch_mask);
+		if (ret < 0)
+			goto error_stream;
+	}
+
+	*rec = desc;
+
+	return SUCCESS;
+
+error_stream:
+	ff_stream_close(desc->stream);
+error_ring:
+	free(desc->ring);
+error_desc:
+	free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Capture a block in the ring with the read_dev() callback of the
+ *        device. When the ring is full, the block is dropped: it is
+ *        accounted and reported by the header of the next captured block.
+ * @param rec - Recorder descriptor.
+ * @return SUCCESS in case of success, -EOVERRUN if the ring was full,
+ *         negative error code otherwise.
+ */
+int32_t iio_recorder_capture(struct iio_recorder *rec)
+{
+	struct iio_recorder_block_header	*header;
+	uint32_t				pending;
+	uint64_t				timestamp_us = 0;
+	int32_t					ret;
+
+	pending = rec->head - rec->tail;
+	if (pending == rec->num_blocks) {
+		rec->dropped++;
+		rec->sequence++;
+		rec->stats.dropped++;
+
+		return -EOVERRUN;
+	}
+
+	header = (struct iio_recorder_block_header *)(rec->ring +
+			(rec->head % rec->num_blocks) * rec->block_size);
+	if (rec->get_time_us)
+		timestamp_us = rec->get_time_us();
+	ret = rec->dev->read_dev(rec->dev_instance, header + 1,
+				 rec->nb_samples);
+	if (ret < 0) {
+		rec->dropped++;
+		rec->sequence++;
+		rec->stats.capture_errors++;
+
+		return ret;
+	}
+
+	header->magic = IIO_RECORDER_BLOCK_MAGIC;
+	header->sequence = rec->sequence++;
+	header->timestamp_us = timestamp_us;
+	header->nb_samples = rec->nb_samples;
+	header->dropped = rec->dropped;
+	rec->dropped = 0;
+
+	rec->head++;
+	rec->stats.captured++;
+	if (pending + 1 > rec->stats.max_pending)
+		rec->stats.max_pending = pending + 1;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write the captured blocks to the file, oldest first.
+ * @param rec - Recorder descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t iio_recorder_process(struct iio_recorder *rec)
+{
+	uint8_t	*block;
+	int32_t	ret;
+
+	while (rec->tail != rec->head) {
+		block = rec->ring + (rec->tail % rec->num_blocks) *
+			rec->block_size;
+		ret = ff_stream_write(rec->stream, block, rec->block_size);
+		if (ret != SUCCESS)
+			return ret;
+		rec->tail++;
+		rec->stats.written++;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the recording statistics.
+ * @param rec - Recorder descriptor.
+ * @param stats - Where to store the statistics.
+ */
+void iio_recorder_get_stats(struct iio_recorder *rec,
+			    struct iio_recorder_stats *stats)
+{
+	*stats = rec->stats;
+}
+
+/**
+ * @brief Write the pending blocks, stop the device transfer and close the
+ *        file.
+ * @param rec - Recorder descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t iio_recorder_remove(struct iio_recorder *rec)
+{
+	int32_t	ret;
+	int32_t	ret2;
+
+	if (!rec)
+		return -EINVAL;
+
+	ret = iio_recorder_process(rec);
+	if (rec->dev->end_transfer) {
+		ret2 = rec->dev->end_transfer(rec->dev_instance);
+		if (ret == SUCCESS && ret2 < 0)
+			ret = ret2;
+	}
+	ret2 = ff_stream_close(rec->stream);
+	if (ret == SUCCESS)
+		ret = ret2;
+
+	free(rec->ring);
+	free(rec);
+
+	return ret;
+}
@@ -0,0 +1,227 @@
+/***************************************************************************//**
+ *   @file   iio_recorder.h
+ *   @brief  Continuous recorder of IIO device captures to a FatFs file.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_RECORDER_H_
+#define IIO_RECORDER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iio_types.h"
+#include "adi_ff_stream.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define IIO_RECORDER_FILE_MAGIC		0x43455249 /* "IREC" */
+#define IIO_RECORDER_BLOCK_MAGIC	0x4B4C4249 /* "IBLK" */
+#define IIO_RECORDER_VERSION		1
+/* The file header takes a sector, the blocks stay sector aligned */
+#define IIO_RECORDER_HEADER_SIZE	512
+#define IIO_RECORDER_MAX_CH		32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct iio_recorder_ch_info
+ * @brief Scan type of a recorded channel, as stored in the file
+ */
+struct iio_recorder_ch_info {
+	/** Index of the channel in the device */
+	uint8_t		index;
+	/** 's' or 'u' */
+	uint8_t		sign;
+	/** Number of valid bits */
+	uint8_t		realbits;
+	/** Number of bits of a sample in the buffer */
+	uint8_t		storagebits;
+	/** Shift right by this before masking out realbits */
+	uint8_t		shift;
+	/** 1 if big endian */
+	uint8_t		is_big_endian;
+	uint8_t		reserved[2];
+} __attribute__((packed));
+
+/**
+ * @struct iio_recorder_file_header
+ * @brief Start of a recording file, padded to IIO_RECORDER_HEADER_SIZE.
+ *        All the fields are little endian.
+ */
+struct iio_recorder_file_header {
+	/** IIO_RECORDER_FILE_MAGIC */
+	uint32_t			magic;
+	/** IIO_RECORDER_VERSION */
+	uint16_t			version;
+	/** IIO_RECORDER_HEADER_SIZE, offset of the first block */
+	uint16_t			header_size;
+	/** Size of each block, header included */
+	uint32_t			block_size;
+	/** Recorded channels */
+	uint32_t			ch_mask;
+	/** Sample rate, 0 if unknown */
+	uint32_t			sample_rate_hz;
+	/** Number of recorded channels */
+	uint16_t			num_ch;
+	/** Bytes of one sample of all the recorded channels */
+	uint16_t			bytes_per_scan;
+	/** Time of the start of the recording, in microseconds */
+	uint64_t			start_us;
+	/** Scan types of the recorded channels, in scan order */
+	struct iio_recorder_ch_info	ch[IIO_RECORDER_MAX_CH];
+} __attribute__((packed));
+
+/**
+ * @struct iio_recorder_block_header
+ * @brief Start of each block of the file, followed by the samples
+ */
+struct iio_recorder_block_header {
+	/** IIO_RECORDER_BLOCK_MAGIC */
+	uint32_t	magic;
+	/** Block number, counting the dropped blocks */
+	uint32_t	sequence;
+	/** Time of the start of the capture, in microseconds */
+	uint64_t	timestamp_us;
+	/** Number of samples in the block */
+	uint32_t	nb_samples;
+	/** Blocks dropped right before this one */
+	uint32_t	dropped;
+	uint32_t	reserved[2];
+} __attribute__((packed));
+
+/**
+ * @struct iio_recorder_stats
+ * @brief Recording statistics
+ */
+struct iio_recorder_stats {
+	/** Blocks captured */
+	uint32_t	captured;
+	/** Blocks written to the file */
+	uint32_t	written;
+	/** Blocks not captured because the ring was full */
+	uint32_t	dropped;
+	/** Maximum number of blocks waiting to be written */
+	uint32_t	max_pending;
+	/** Capture errors */
+	uint32_t	capture_errors;
+};
+
+/**
+ * @struct iio_recorder_init_param
+ * @brief Recorder parameters
+ */
+struct iio_recorder_init_param {
+	/** IIO device descriptor, with read_dev */
+	struct iio_device	*dev;
+	/** Instance passed to the device callbacks */
+	void			*dev_instance;
+	/** Channels to record */
+	uint32_t		ch_mask;
+	/** Sample rate stored in the file header, 0 if unknown */
+	uint32_t		sample_rate_hz;
+	/** Path of the file to create */
+	const char		*path;
+	/** Bytes allocated contiguously for the file, 0 to grow it */
+	FSIZE_t			file_size;
+	/**
+	 * Size of each block, block header included. A multiple of the
+	 * sector size, the larger the fewer disk commands.
+	 */
+	uint32_t		block_size;
+	/** Number of blocks of the capture ring, at least 2 */
+	uint32_t		num_blocks;
+	/** Time in microseconds, for the timestamps, may be NULL */
+	uint64_t		(*get_time_us)(void);
+};
+
+/**
+ * @struct iio_recorder
+ * @brief Recorder descriptor
+ */
+struct iio_recorder {
+	/** IIO device descriptor */
+	struct iio_device		*dev;
+	/** Instance passed to the device callbacks */
+	void				*dev_instance;
+	/** Output file */
+	struct ff_stream		*stream;
+	/** Capture ring, num_blocks blocks of block_size bytes */
+	uint8_t				*ring;
+	/** Size of each block */
+	uint32_t			block_size;
+	/** Number of blocks of the ring */
+	uint32_t			num_blocks;
+	/** Samples captured in each block */
+	uint32_t			nb_samples;
+	/** Time in microseconds */
+	uint64_t			(*get_time_us)(void);
+	/** Blocks captured, the producer index */
+	volatile uint32_t		head;
+	/** Blocks written, the consumer index */
+	volatile uint32_t		tail;
+	/** Blocks dropped since the last captured block */
+	uint32_t			dropped;
+	/** Block sequence number */
+	uint32_t			sequence;
+	/** Statistics */
+	struct iio_recorder_stats	stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Create the file, write its header and start the device transfer. */
+int32_t iio_recorder_init(struct iio_recorder **rec,
+			  const struct iio_recorder_init_param *param);
+/* Capture a block in the ring. */
+int32_t iio_recorder_capture(struct iio_recorder *rec);
+/* Write the captured blocks to the file. */
+int32_t iio_recorder_process(struct iio_recorder *rec);
+/* Get the recording statistics. */
+void iio_recorder_get_stats(struct iio_recorder *rec,
+			    struct iio_recorder_stats *stats);
+/* Write the pending blocks, stop the device transfer and close the file. */
+int32_t iio_recorder_remove(struct iio_recorder *rec);
+
+#endif /* IIO_RECORDER_H_ */
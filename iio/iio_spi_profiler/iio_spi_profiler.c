@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ *   @file   iio_spi_profiler.c
+ *   @brief  IIO view of the SPI traffic profiler.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "iio_spi_profiler.h"
+#include "spi_profiler.h"
+#include "error.h"
+
+enum iio_spi_profiler_attributes {
+	IIO_SPI_PROFILER_TRANSFERS,
+	IIO_SPI_PROFILER_BYTES,
+	IIO_SPI_PROFILER_TIME_US,
+	IIO_SPI_PROFILER_MAX_US,
+	IIO_SPI_PROFILER_ERRORS,
+};
+
+/**
+ * @brief Show one of the traffic counters.
+ * @param device - SPI descriptor using spi_profiler_platform_ops.
+ * @param buf - Output buffer.
+ * @param len - Output buffer size.
+ * @param channel - Unused.
+ * @param priv - Counter to show, enum iio_spi_profiler_attributes.
+ * @return Length of the output, FAILURE otherwise.
+ */
+static ssize_t get_spi_profiler_attr(void *device, char *buf, size_t len,
+				     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct spi_profiler_stats *stats;
+
+	stats = spi_profiler_get_stats(device);
+	if (!stats)
+		return FAILURE;
+
+	switch (priv) {
+	case IIO_SPI_PROFILER_TRANSFERS:
+		return snprintf(buf, len, "%"PRIu32, stats->transfers);
+	case IIO_SPI_PROFILER_BYTES:
+		return snprintf(buf, len, "%"PRIu64, stats->bytes);
+	case IIO_SPI_PROFILER_TIME_US:
+		return snprintf(buf, len, "%"PRIu64, stats->time_us);
+	case IIO_SPI_PROFILER_MAX_US:
+		return snprintf(buf, len, "%"PRIu32, stats->max_us);
+	case IIO_SPI_PROFILER_ERRORS:
+		return snprintf(buf, len, "%"PRIu32, stats->errors);
+	default:
+		return FAILURE;
+	}
+}
+
+/**
+ * @brief Show the traffic report with the busiest registers.
+ * @param device - SPI descriptor using spi_profiler_platform_ops.
+ * @param buf - Output buffer.
+ * @param len - Output buffer size.
+ * @param channel - Unused.
+ * @param priv - Unused.
+ * @return Length of the output, FAILURE otherwise.
+ */
+static ssize_t get_spi_profiler_stats(void *device, char *buf, size_t len,
+				      const struct iio_ch_info *channel, intptr_t priv)
+{
+	return spi_profiler_snprint(device, buf, len, IIO_SPI_PROFILER_REGS);
+}
+
+/**
+ * @brief Clear the recorded traffic, whatever the written value.
+ * @param device - SPI descriptor using spi_profiler_platform_ops.
+ * @param buf - Input buffer.
+ * @param len - Input buffer size.
+ * @param channel - Unused.
+ * @param priv - Unused.
+ * @return len, FAILURE otherwise.
+ */
+static ssize_t set_spi_profiler_reset(void *device, char *buf, size_t len,
+				      const struct iio_ch_info *channel, intptr_t priv)
+{
+	if (spi_profiler_reset(device) != SUCCESS)
+		return FAILURE;
+
+	return len;
+}
+
+#define IIO_SPI_PROFILER_ATTR(_name, _priv) {\
+	.name = _name,\
+	.priv = _priv,\
+	.show = get_spi_profiler_attr,\
+	.store = NULL\
+}
+
+static struct iio_attribute iio_spi_profiler_attributes[] = {
+	IIO_SPI_PROFILER_ATTR("spi_transfers", IIO_SPI_PROFILER_TRANSFERS),
+	IIO_SPI_PROFILER_ATTR("spi_bytes", IIO_SPI_PROFILER_BYTES),
+	IIO_SPI_PROFILER_ATTR("spi_time_us", IIO_SPI_PROFILER_TIME_US),
+	IIO_SPI_PROFILER_ATTR("spi_max_us", IIO_SPI_PROFILER_MAX_US),
+	IIO_SPI_PROFILER_ATTR("spi_errors", IIO_SPI_PROFILER_ERRORS),
+	END_ATTRIBUTES_ARRAY,
+};
+
+static struct iio_attribute iio_spi_profiler_debug_attributes[] = {
+	{
+		.name = "spi_stats",
+		.show = get_spi_profiler_stats,
+		.store = NULL
+	},
+	{
+		.name = "spi_reset",
+		.show = NULL,
+		.store = set_spi_profiler_reset
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
+struct iio_device iio_spi_profiler_descriptor = {
+	.num_ch = 0,
+	.channels = NULL,
+	.attributes = iio_spi_profiler_attributes,
+	.debug_attributes = iio_spi_profiler_debug_attributes,
+	.buffer_attributes = NULL,
+};
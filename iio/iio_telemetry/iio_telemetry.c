@@ -0,0 +1,366 @@
+/***************************************************************************//**
+ *   @file   iio_telemetry.c
+ *   @brief  Batched binary telemetry of IIO channels over MQTT.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "iio_telemetry.h"
+#include "error.h"
+#include "util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Store a 16 bit value in little endian order.
+ */
+static void iio_telemetry_put16(uint8_t *buf, uint16_t val)
+{
+	buf[0] = val & 0xFF;
+	buf[1] = val >> 8;
+}
+
+/**
+ * @brief Store a 32 bit value in little endian order.
+ */
+static void iio_telemetry_put32(uint8_t *buf, uint32_t val)
+{
+	iio_telemetry_put16(buf, val & 0xFFFF);
+	iio_telemetry_put16(buf + 2, val >> 16);
+}
+
+/**
+ * @brief Bytes of a sample of a source: read_dev() stores the samples of all
+ *        the active channels on the width of the first one.
+ * @param src - Source.
+ * @return Number of bytes, 0 if the channel mask is not valid.
+ */
+static uint32_t iio_telemetry_sample_len(const struct iio_telemetry_source *src)
+{
+	struct scan_type	*scan = NULL;
+	uint32_t		nb_ch = 0;
+	uint32_t		i;
+
+	for (i = 0; i < src->dev->num_ch && i < 32; i++) {
+		if (!(src->ch_mask & (1u << i)))
+			continue;
+		if (!scan)
+			scan = src->dev->channels[i].scan_type;
+		nb_ch++;
+	}
+	/* Reject masks selecting channels past the last one */
+	if (!scan || !nb_ch || (i < 32 && src->ch_mask >> i))
+		return 0;
+
+	return nb_ch * (scan->storagebits / 8);
+}
+
+/**
+ * @brief End the transfer of the first sources, prepared for sampling.
+ * @param tel - Publisher descriptor.
+ * @param nb_sources - Number of sources to end.
+ */
+static void iio_telemetry_end_sources(struct iio_telemetry *tel,
+				      uint32_t nb_sources)
+{
+	const struct iio_telemetry_source	*src;
+	uint32_t				i;
+
+	for (i = 0; i < nb_sources; i++) {
+		src = &tel->sources[i];
+		if (src->dev->end_transfer)
+			src->dev->end_transfer(src->dev_instance);
+	}
+}
+
+/**
+ * @brief Create a publisher and prepare the sources for sampling.
+ * @param tel - Where to store the publisher descriptor.
+ * @param param - Publisher parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t iio_telemetry_init(struct iio_telemetry **tel,
+			   const struct iio_telemetry_init_param *param)
+{
+	const struct iio_telemetry_source	*src;
+	struct iio_telemetry			*desc;
+	uint32_t				len;
+	uint32_t				now;
+	uint32_t				i = 0;
+	int32_t					ret;
+
+	if (!tel || !param || !param->mqtt || !param->topic ||
+	    !param->sources || !param->nb_sources || param->nb_sources > 255 ||
+	    !param->get_time_ms)
+		return -EINVAL;
+
+	desc = calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+	desc->next_ms = calloc(param->nb_sources, sizeof(*desc->next_ms));
+	desc->sample_len = calloc(param->nb_sources, sizeof(*desc->sample_len));
+	desc->payload = calloc(1, param->payload_size);
+	if (!desc->next_ms || !desc->sample_len || !desc->payload) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	desc->mqtt = param->mqtt;
+	desc->topic = param->topic;
+	desc->sources = param->sources;
+	desc->nb_sources = param->nb_sources;
+	desc->payload_size = param->payload_size;
+	desc->max_latency_ms = param->max_latency_ms;
+	desc->backoff = 1;
+	desc->max_backoff = param->max_backoff ? param->max_backoff : 1;
+	desc->get_time_ms = param->get_time_ms;
+
+	now = desc->get_time_ms();
+	for (i = 0; i < desc->nb_sources; i++) {
+		src = &desc->sources[i];
+		if (!src->dev || !src->dev->read_dev) {
+			ret = -EINVAL;
+			goto error;
+		}
+		len = iio_telemetry_sample_len(src);
+		if (!len || len > 255 || IIO_TELEMETRY_HEADER_LEN +
+		    IIO_TELEMETRY_FRAME_HEADER_LEN + len > desc->payload_size) {
+			ret = -EINVAL;
+			goto error;
+		}
+		desc->sample_len[i] = len;
+		desc->next_ms[i] = now;
+
+		if (src->dev->prepare_transfer) {
+			ret = src->dev->prepare_transfer(src->dev_instance,
+							 src->ch_mask);
+			if (ret < 0)
+				goto error;
+		}
+	}
+
+	*tel = desc;
+
+	return SUCCESS;
+
+error:
+	/* Source i failed or was not prepared, the ones before it were */
+	iio_telemetry_end_sources(desc, i);
+	free(desc->payload);
+	free(desc->sample_len);
+	free(desc->next_ms);
+	free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Publish the frames sampled so far, in a single message. If the
+ *        link does not take it, the frames are kept for the next attempt and
+ *        the sampling periods are stretched, up to max_backoff times; each
+ *        message published shrinks them back.
+ * @param tel - Publisher descriptor.
+ * @return SUCCESS in case of success, -EAGAIN if the link is congested,
+ *         negative error code otherwise.
+ */
+int32_t iio_telemetry_flush(struct iio_telemetry *tel)
+{
+	struct mqtt_message	msg = {
+		.qos = MQTT_QOS0,
+		.retained = false,
+	};
+	int32_t			ret;
+
+	if (!tel->nb_frames)
+		return SUCCESS;
+
+	tel->payload[0] = IIO_TELEMETRY_VERSION;
+	tel->payload[1] = tel->nb_frames;
+	iio_telemetry_put16(tel->payload + 2, tel->sequence);
+	iio_telemetry_put32(tel->payload + 4, tel->base_ms);
+	msg.payload = tel->payload;
+	msg.len = tel->payload_len;
+
+	/*
+	 * Without a publish queue, a link that cannot take the message makes
+	 * mqtt_publish() fail instead of returning -EAGAIN: back off the same.
+	 */
+	ret = mqtt_publish(tel->mqtt, tel->topic, &msg);
+	if (ret != SUCCESS) {
+		tel->stats.congested++;
+		if (tel->backoff < tel->max_backoff)
+			tel->backoff = min(tel->backoff * 2, tel->max_backoff);
+
+		return -EAGAIN;
+	}
+
+	tel->stats.publishes++;
+	tel->sequence++;
+	tel->nb_frames = 0;
+	tel->payload_len = 0;
+	if (tel->backoff > 1)
+		tel->backoff /= 2;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Sample a source in a new frame of the message being built.
+ * @param tel - Publisher descriptor.
+ * @param idx - Source index.
+ * @param now - Current time.
+ * @return SUCCESS in case of success, -EAGAIN if the sample was skipped,
+ *         negative error code otherwise.
+ */
+static int32_t iio_telemetry_sample(struct iio_telemetry *tel, uint32_t idx,
+				    uint32_t now)
+{
+	const struct iio_telemetry_source	*src = &tel->sources[idx];
+	uint32_t				len = tel->sample_len[idx];
+	uint8_t					*frame;
+	bool					full;
+	int32_t					ret;
+
+	/* A full message, or a time offset that does not fit, publishes it */
+	full = tel->nb_frames == 255 ||
+	       tel->payload_len + IIO_TELEMETRY_FRAME_HEADER_LEN + len >
+	       tel->payload_size;
+	if (tel->nb_frames && (full || now - tel->base_ms > 0xFFFF)) {
+		ret = iio_telemetry_flush(tel);
+		if (ret != SUCCESS) {
+			tel->stats.dropped++;
+			return ret;
+		}
+	}
+
+	if (!tel->nb_frames) {
+		tel->base_ms = now;
+		tel->payload_len = IIO_TELEMETRY_HEADER_LEN;
+	}
+
+	frame = tel->payload + tel->payload_len;
+	ret = src->dev->read_dev(src->dev_instance,
+				 frame + IIO_TELEMETRY_FRAME_HEADER_LEN, 1);
+	if (ret < 0)
+		return ret;
+
+	frame[0] = idx;
+	frame[1] = len;
+	iio_telemetry_put16(frame + 2, now - tel->base_ms);
+	tel->payload_len += IIO_TELEMETRY_FRAME_HEADER_LEN + len;
+	tel->nb_frames++;
+	tel->stats.frames++;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Sample the sources that are due and publish the messages that are
+ *        full or hold a frame older than max_latency_ms. To be called often
+ *        compared to the sampling periods.
+ * @param tel - Publisher descriptor.
+ * @return SUCCESS in case of success, -EAGAIN if the link is congested,
+ *         negative error code otherwise.
+ */
+int32_t iio_telemetry_poll(struct iio_telemetry *tel)
+{
+	uint32_t	now;
+	uint32_t	i;
+	int32_t		ret;
+	int32_t		err = SUCCESS;
+
+	if (!tel)
+		return -EINVAL;
+
+	now = tel->get_time_ms();
+	for (i = 0; i < tel->nb_sources; i++) {
+		if ((int32_t)(now - tel->next_ms[i]) < 0)
+			continue;
+		/* Late samples are not caught up with */
+		tel->next_ms[i] = now + tel->sources[i].period_ms * tel->backoff;
+
+		ret = iio_telemetry_sample(tel, i, now);
+		if (ret != SUCCESS && ret != -EAGAIN)
+			return ret;
+		if (ret == -EAGAIN)
+			err = -EAGAIN;
+	}
+
+	if (tel->nb_frames && now - tel->base_ms >= tel->max_latency_ms) {
+		ret = iio_telemetry_flush(tel);
+		if (ret != SUCCESS)
+			return ret;
+	}
+
+	return err;
+}
+
+/**
+ * @brief Get the publisher statistics.
+ * @param tel - Publisher descriptor.
+ * @param stats - Where to store the statistics.
+ */
+void iio_telemetry_get_stats(struct iio_telemetry *tel,
+			     struct iio_telemetry_stats *stats)
+{
+	*stats = tel->stats;
+}
+
+/**
+ * @brief End the transfer of the sources and free the resources allocated by
+ *        iio_telemetry_init(). The frames not published yet are lost, call
+ *        iio_telemetry_flush() first to keep them.
+ * @param tel - Publisher descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t iio_telemetry_remove(struct iio_telemetry *tel)
+{
+	if (!tel)
+		return -EINVAL;
+
+	iio_telemetry_end_sources(tel, tel->nb_sources);
+	free(tel->payload);
+	free(tel->sample_len);
+	free(tel->next_ms);
+	free(tel);
+
+	return SUCCESS;
+}
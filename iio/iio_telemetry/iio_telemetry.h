@@ -0,0 +1,182 @@
+/***************************************************************************//**
+ *   @file   iio_telemetry.h
+ *   @brief  Batched binary telemetry of IIO channels over MQTT.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_TELEMETRY_H_
+#define IIO_TELEMETRY_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "iio_types.h"
+#include "mqtt_client.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/*
+ * PUBLISH payload, little endian:
+ *   u8 version, u8 number of frames, u16 sequence, u32 base time in ms,
+ * then for each frame:
+ *   u8 source index, u8 data length, u16 time in ms after the base time,
+ *   data: one sample of the active channels of the source, as read_dev()
+ *   stores it.
+ */
+#define IIO_TELEMETRY_VERSION		1
+#define IIO_TELEMETRY_HEADER_LEN	8
+#define IIO_TELEMETRY_FRAME_HEADER_LEN	4
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct iio_telemetry_source
+ * @brief Channels of an IIO device sampled at a fixed period. Sources of the
+ *        same device must use the same channel mask.
+ */
+struct iio_telemetry_source {
+	/** IIO device descriptor, with read_dev */
+	struct iio_device	*dev;
+	/** Instance passed to the device callbacks */
+	void			*dev_instance;
+	/** Channels sampled */
+	uint32_t		ch_mask;
+	/** Sampling period */
+	uint32_t		period_ms;
+};
+
+/**
+ * @struct iio_telemetry_stats
+ * @brief Publisher statistics
+ */
+struct iio_telemetry_stats {
+	/** Frames sampled */
+	uint32_t	frames;
+	/** Messages published */
+	uint32_t	publishes;
+	/** Publishes deferred because the link did not take them */
+	uint32_t	congested;
+	/** Samples skipped because the message buffer was full */
+	uint32_t	dropped;
+};
+
+/**
+ * @struct iio_telemetry_init_param
+ * @brief Publisher parameters
+ */
+struct iio_telemetry_init_param {
+	/** Connected MQTT client, preferably with a publish queue */
+	struct mqtt_desc			*mqtt;
+	/** Topic of the messages */
+	const int8_t				*topic;
+	/** Sources, up to 255 */
+	const struct iio_telemetry_source	*sources;
+	/** Number of sources */
+	uint32_t				nb_sources;
+	/** Maximum payload of a message */
+	uint32_t				payload_size;
+	/** Maximum time a frame waits to be published */
+	uint32_t				max_latency_ms;
+	/** Maximum factor the periods are stretched by under congestion */
+	uint32_t				max_backoff;
+	/** Time in milliseconds */
+	uint32_t				(*get_time_ms)(void);
+};
+
+/**
+ * @struct iio_telemetry
+ * @brief Publisher descriptor
+ */
+struct iio_telemetry {
+	/** MQTT client */
+	struct mqtt_desc			*mqtt;
+	/** Topic of the messages */
+	const int8_t				*topic;
+	/** Sources */
+	const struct iio_telemetry_source	*sources;
+	/** Number of sources */
+	uint32_t				nb_sources;
+	/** Time of the next sample of each source */
+	uint32_t				*next_ms;
+	/** Bytes of a sample of each source */
+	uint8_t					*sample_len;
+	/** Message being built */
+	uint8_t					*payload;
+	/** Maximum payload of a message */
+	uint32_t				payload_size;
+	/** Bytes in payload */
+	uint32_t				payload_len;
+	/** Frames in payload */
+	uint8_t					nb_frames;
+	/** Sequence number of the message */
+	uint16_t				sequence;
+	/** Time of the first frame of the message */
+	uint32_t				base_ms;
+	/** Maximum time a frame waits to be published */
+	uint32_t				max_latency_ms;
+	/** Current factor of the periods */
+	uint32_t				backoff;
+	/** Maximum factor of the periods */
+	uint32_t				max_backoff;
+	/** Time in milliseconds */
+	uint32_t				(*get_time_ms)(void);
+	/** Statistics */
+	struct iio_telemetry_stats		stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Create a publisher and prepare the sources for sampling. */
+int32_t iio_telemetry_init(struct iio_telemetry **tel,
+			   const struct iio_telemetry_init_param *param);
+/* Sample the sources that are due and publish the full messages. */
+int32_t iio_telemetry_poll(struct iio_telemetry *tel);
+/* Publish the frames sampled so far. */
+int32_t iio_telemetry_flush(struct iio_telemetry *tel);
+/* Get the publisher statistics. */
+void iio_telemetry_get_stats(struct iio_telemetry *tel,
+			     struct iio_telemetry_stats *stats);
+/* Free the resources allocated by iio_telemetry_init(). */
+int32_t iio_telemetry_remove(struct iio_telemetry *tel);
+
+#endif /* IIO_TELEMETRY_H_ */
@@ -43,6 +43,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /************************* Structure Declarations *****************************/
@@ -56,16 +57,68 @@ struct clk_hw {
 	int32_t (*dev_clk_round_rate)();
 };
 
+struct clk;
+
+/**
+ * @struct clk_notifier
+ * @brief Rate change callback attached to a clock.
+ */
+struct clk_notifier {
+	/** Called after the rate of the clock changed */
+	int32_t (*notifier_call)(struct clk_notifier *nb, struct clk *clk,
+				 uint64_t old_rate, uint64_t new_rate);
+	/** Consumer private data */
+	void			*priv;
+	/** Next notifier of the same clock */
+	struct clk_notifier	*next;
+};
+
 struct clk {
 	struct clk_hw	*hw;
 	uint32_t	hw_ch_num;
 	const char	*name;
+	/** Clock tree links, filled in by clk_register() */
+	struct clk	*parent;
+	struct clk	*first_child;
+	struct clk	*next_sibling;
+	/** Cached output rate, valid until an ancestor changes rate */
+	uint64_t	rate;
+	bool		rate_valid;
+	/** Last rate successfully requested through clk_set_rate() */
+	uint64_t	req_rate;
+	bool		req_valid;
+	/** Last clk_round_rate() request and its result */
+	uint64_t	round_req;
+	uint64_t	round_rate;
+	bool		round_valid;
+	/** Number of clk_enable() calls not balanced by clk_disable() */
+	uint32_t	enable_count;
+	/** Rate change notifiers */
+	struct clk_notifier	*notifiers;
 };
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
+/* Add the clock to the clock tree, under the given parent. */
+int32_t clk_register(struct clk *clk,
+		     struct clk *parent);
+
+/* Remove the clock from the clock tree. */
+int32_t clk_unregister(struct clk *clk);
+
+/* Attach a rate change notifier to the clock. */
+int32_t clk_notifier_register(struct clk *clk,
+			      struct clk_notifier *nb);
+
+/* Detach a rate change notifier from the clock. */
+int32_t clk_notifier_unregister(struct clk *clk,
+				struct clk_notifier *nb);
+
+/* Drop the cached rates of the clock and of all its descendants. */
+void clk_invalidate_rate(struct clk *clk);
+
 /* Start the clock. */
 int32_t clk_enable(struct clk * clk);
 
@@ -0,0 +1,201 @@
+/***************************************************************************//**
+ *   @file   dma_buf.h
+ *   @brief  Header file of the DMA buffer allocator
+********************************************************************************
+ *   @copyright
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef DMA_BUF_H_
+#define DMA_BUF_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Cache line size used when the region does not specify one. It is the
+ *  largest line size of the supported cores, so it is safe on all of them. */
+#define DMA_BUF_DEFAULT_LINE_SIZE	64
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum dma_buf_dir
+ * @brief Direction of the data movement for a DMA buffer sync.
+ */
+enum dma_buf_dir {
+	/** The CPU writes the buffer, the device reads it */
+	DMA_BUF_TO_DEVICE,
+	/** The device writes the buffer, the CPU reads it */
+	DMA_BUF_FROM_DEVICE,
+	/** Both the CPU and the device write the buffer */
+	DMA_BUF_BIDIRECTIONAL
+};
+
+/**
+ * @enum dma_buf_owner
+ * @brief Which side may access the buffer memory.
+ */
+enum dma_buf_owner {
+	/** The CPU caches are in sync with memory for the whole buffer */
+	DMA_BUF_OWNER_CPU,
+	/** Part of the buffer was synced for the CPU */
+	DMA_BUF_OWNER_SHARED,
+	/** The buffer was handed to the device */
+	DMA_BUF_OWNER_DEVICE
+};
+
+struct dma_buf_region;
+struct dma_buf_region_init_param;
+
+/**
+ * @struct dma_buf_platform_ops
+ * @brief Structure holding the platform specific cache maintenance functions.
+ * Addresses and sizes passed to flush and invalidate are cache line aligned.
+ */
+struct dma_buf_platform_ops {
+	/** Optional, acquire the region memory and fill in its addresses */
+	int32_t (*dma_buf_ops_init)(struct dma_buf_region *,
+				    const struct dma_buf_region_init_param *);
+	/** Write back the dirty cache lines of a range */
+	int32_t (*dma_buf_ops_flush)(struct dma_buf_region *, uintptr_t,
+				     uint32_t);
+	/** Discard the cache lines of a range */
+	int32_t (*dma_buf_ops_invalidate)(struct dma_buf_region *, uintptr_t,
+					  uint32_t);
+	/** Optional, release the region memory */
+	int32_t (*dma_buf_ops_remove)(struct dma_buf_region *);
+};
+
+/**
+ * @struct dma_buf_region_init_param
+ * @brief Structure holding the parameters for DMA buffer region
+ * initialization.
+ */
+struct dma_buf_region_init_param {
+	/** CPU address of the reserved memory, 0 if the platform provides it */
+	uintptr_t cpu_addr;
+	/** Address of the memory as seen by the DMA, 0 if same as cpu_addr */
+	uint32_t bus_addr;
+	/** Size of the reserved memory, in bytes */
+	uint32_t size;
+	/** Cache line size, 0 for DMA_BUF_DEFAULT_LINE_SIZE */
+	uint32_t line_size;
+	/** The memory is not cached or the DMA is cache coherent */
+	bool coherent;
+	/** Platform specific cache maintenance functions */
+	const struct dma_buf_platform_ops *platform_ops;
+	/** Platform specific parameters */
+	void *extra;
+};
+
+/**
+ * @struct dma_buf
+ * @brief Buffer allocated from a DMA buffer region.
+ */
+struct dma_buf {
+	/** Region the buffer belongs to */
+	struct dma_buf_region *region;
+	/** Address used by the CPU */
+	void *cpu_addr;
+	/** Address used by the DMA */
+	uint32_t bus_addr;
+	/** Requested size, in bytes */
+	uint32_t size;
+	/** Size padded to a multiple of the cache line size, in bytes */
+	uint32_t alloc_size;
+	/** Side the buffer was last synced for, informative only: the cache
+	 *  maintenance is done on every sync */
+	enum dma_buf_owner owner;
+	/** Next buffer of the region, in address order */
+	struct dma_buf *next;
+};
+
+/**
+ * @struct dma_buf_region
+ * @brief Reserved memory from which DMA buffers are allocated.
+ */
+struct dma_buf_region {
+	/** CPU address of the first cache line of the region */
+	uintptr_t cpu_addr;
+	/** Address of the first cache line of the region as seen by the DMA */
+	uint32_t bus_addr;
+	/** Usable size of the region, in bytes */
+	uint32_t size;
+	/** Cache line size */
+	uint32_t line_size;
+	/** Cache maintenance is not needed */
+	bool coherent;
+	/** Allocated buffers, in address order */
+	struct dma_buf *bufs;
+	/** Platform specific cache maintenance functions */
+	const struct dma_buf_platform_ops *platform_ops;
+	/** Platform specific descriptor */
+	void *extra;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Initialize a DMA buffer region. */
+int32_t dma_buf_region_init(struct dma_buf_region **region,
+			    const struct dma_buf_region_init_param *param);
+/* Free the resources allocated by dma_buf_region_init(). */
+int32_t dma_buf_region_remove(struct dma_buf_region *region);
+/* Allocate a cache line aligned and padded buffer from a region. */
+int32_t dma_buf_alloc(struct dma_buf_region *region, uint32_t size,
+		      struct dma_buf **buf);
+/* Return a buffer to its region. */
+int32_t dma_buf_free(struct dma_buf *buf);
+/* Find the buffer that contains a CPU address. */
+int32_t dma_buf_lookup(struct dma_buf_region *region, const void *cpu_addr,
+		       struct dma_buf **buf, uint32_t *offset);
+/* Hand a part of the buffer to the device. */
+int32_t dma_buf_sync_for_device(struct dma_buf *buf, uint32_t offset,
+				uint32_t size, enum dma_buf_dir dir);
+/* Hand a part of the buffer back to the CPU. */
+int32_t dma_buf_sync_for_cpu(struct dma_buf *buf, uint32_t offset,
+			     uint32_t size, enum dma_buf_dir dir);
+
+#endif /* DMA_BUF_H_ */
@@ -42,6 +42,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/** Default longest wait of tdm_stream_read() for the samples, in microseconds */
+#define TDM_STREAM_READ_TIMEOUT_US	1000000
+
 /**
  * @struct tdm_platform_ops
  * @brief Structure holding TDM function pointers that point to the platform
@@ -49,6 +52,16 @@
  */
 struct tdm_platform_ops;
 
+/**
+ * @brief Stream callback, called from interrupt context each time half of the
+ * stream buffer was filled.
+ * @param ctx - Context given to tdm_stream_start().
+ * @param block - The filled half of the stream buffer.
+ * @param nb_samples - Number of samples in the block.
+ */
+typedef void (*tdm_stream_callback)(void *ctx, void *block,
+				    uint32_t nb_samples);
+
 enum tdm_mode {
 	TDM_MASTER_TX,
 	TDM_MASTER_RX,
@@ -85,6 +98,27 @@ struct tdm_init_param {
 	void *extra;
 };
 
+/**
+ * @struct tdm_stream_param
+ * @brief Structure holding the parameters for continuous TDM capture
+ */
+struct tdm_stream_param {
+	/** Buffer the samples are continuously received in, as two halves */
+	void *buffer;
+	/** Number of samples the buffer holds, must be even */
+	uint32_t nb_samples;
+	/** Size of the ring buffer read by tdm_stream_read(), in number of
+	 *  samples. 0 if the blocks are only passed to the callback */
+	uint32_t ring_samples;
+	/** Longest wait of tdm_stream_read() for the samples, in microseconds.
+	 *  0 for TDM_STREAM_READ_TIMEOUT_US */
+	uint32_t read_timeout_us;
+	/** Called each time half of the buffer was filled, may be NULL */
+	tdm_stream_callback callback;
+	/** Context passed to the callback */
+	void *ctx;
+};
+
 /**
  * @struct tdm_desc
  * @brief Structure holding TDM descriptor.
@@ -92,6 +126,18 @@ struct tdm_init_param {
 struct tdm_desc {
 	/** Platform operation function pointers */
 	const struct tdm_platform_ops *platform_ops;
+	/** Size of a sample in memory, specified in number of bytes */
+	uint8_t sample_bytes;
+	/** Ring buffer the stream blocks are copied to, NULL if not used */
+	struct circular_buffer *ring;
+	/** Size of the ring buffer, specified in number of samples */
+	uint32_t ring_samples;
+	/** Longest wait of tdm_stream_read(), in microseconds */
+	uint32_t read_timeout_us;
+	/** User stream callback */
+	tdm_stream_callback callback;
+	/** User stream callback context */
+	void *ctx;
 	/**  TDM extra parameters (device specific) */
 	void *extra;
 };
@@ -110,6 +156,11 @@ struct tdm_platform_ops {
 	int32_t (*tdm_ops_write)(struct tdm_desc *, void *, uint16_t);
 	/** TDM remove operation function pointer */
 	int32_t (*tdm_ops_remove)(struct tdm_desc *);
+	/** TDM continuous read start operation function pointer */
+	int32_t (*tdm_ops_stream_start)(struct tdm_desc *, void *, uint32_t,
+					tdm_stream_callback, void *);
+	/** TDM continuous read stop operation function pointer */
+	int32_t (*tdm_ops_stream_stop)(struct tdm_desc *);
 };
 
 /* Initialize the TDM communication peripheral. */
@@ -129,4 +180,16 @@ int32_t tdm_write(struct tdm_desc *desc,
 		  void *data,
 		  uint16_t bytes_number);
 
+/* Start continuous capture. */
+int32_t tdm_stream_start(struct tdm_desc *desc,
+			 const struct tdm_stream_param *param);
+
+/* Stop continuous capture. */
+int32_t tdm_stream_stop(struct tdm_desc *desc);
+
+/* Read captured samples from the stream ring buffer. */
+int32_t tdm_stream_read(struct tdm_desc *desc,
+			void *data,
+			uint32_t nb_samples);
+
 #endif // TDM_H_
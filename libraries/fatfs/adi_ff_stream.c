@@ -0,0 +1,437 @@
+/***************************************************************************//**
+ *   @file   adi_ff_stream.c
+ *   @brief  Streaming log files on FatFs: contiguous preallocation, sector aligned writes from ping-pong buffers and fast seek playback.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "adi_ff_stream.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Items of the first link map, enough for a file of 15 fragments */
+#define LINK_MAP_ITEMS		32
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Convert a FatFs result to an error code.
+ * @param res - FatFs result.
+ * @return SUCCESS or negative error code.
+ */
+static int32_t ff_stream_err(FRESULT res)
+{
+	switch (res) {
+	case FR_OK:
+		return SUCCESS;
+	case FR_NO_FILE:
+	case FR_NO_PATH:
+		return -ENOENT;
+	case FR_EXIST:
+		return -EEXIST;
+	case FR_DENIED:
+	case FR_WRITE_PROTECTED:
+		return -EACCES;
+	case FR_NOT_ENOUGH_CORE:
+		return -ENOMEM;
+	case FR_INVALID_PARAMETER:
+	case FR_INVALID_NAME:
+	case FR_INVALID_OBJECT:
+		return -EINVAL;
+	default:
+		return -EIO;
+	}
+}
+
+/**
+ * @brief Build the cluster link map of the file and enable the fast seek
+ *        mode: seeks and cluster changes no longer walk the FAT chain.
+ * @param stream - Stream descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t ff_stream_link_map(struct ff_stream *stream)
+{
+	DWORD	*map;
+	DWORD	items = LINK_MAP_ITEMS;
+	FRESULT	res;
+
+	do {
+		map = realloc(stream->link_map, items * sizeof(*map));
+		if (!map)
+			return -ENOMEM;
+		stream->link_map = map;
+		map[0] = items;
+		stream->file.cltbl = map;
+		res = f_lseek(&stream->file, CREATE_LINKMAP);
+		/* map[0] holds the number of items required */
+		items = map[0];
+	} while (res == FR_NOT_ENOUGH_CORE);
+
+	if (res != FR_OK)
+		stream->file.cltbl = NULL;
+
+	return ff_stream_err(res);
+}
+
+/**
+ * @brief Write data at the file pointer. Sector aligned data is written by
+ *        FatFs straight to the disk, a cluster at a time.
+ * @param stream - Stream descriptor.
+ * @param data - Data to write.
+ * @param len - Number of bytes.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t ff_stream_file_write(struct ff_stream *stream,
+				    const void *data, uint32_t len)
+{
+	UINT	written;
+	FRESULT	res;
+
+	res = f_write(&stream->file, data, len, &written);
+	if (res != FR_OK)
+		return ff_stream_err(res);
+	/* Volume full, or past the preallocated size in fast seek mode */
+	if (written != len)
+		return -ENOSPC;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Open a stream.
+ *        For writing, the file is created, replacing an existing one, and
+ *        param->size bytes are allocated contiguously so that the appends
+ *        neither search free clusters nor walk the FAT chain.
+ *        For reading, the cluster link map of the file is built so that the
+ *        seeks are done without reading the FAT.
+ * @param stream - Where to store the stream descriptor.
+ * @param param - Stream parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_open(struct ff_stream **stream,
+		       const struct ff_stream_init_param *param)
+{
+	struct ff_stream	*desc;
+	FRESULT			res;
+	uint32_t		i;
+	int32_t			ret;
+
+	if (!stream || !param || !param->path)
+		return -EINVAL;
+	if (param->mode == FF_STREAM_WRITE &&
+	    (!param->buffer_size || param->buffer_size % FF_MIN_SS))
+		return -EINVAL;
+
+	desc = calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+	desc->mode = param->mode;
+
+	if (param->mode == FF_STREAM_READ) {
+		res = f_open(&desc->file, param->path, FA_READ | FA_OPEN_EXISTING);
+		if (res != FR_OK) {
+			ret = ff_stream_err(res);
+			goto error_desc;
+		}
+		ret = ff_stream_link_map(desc);
+		if (ret != SUCCESS)
+			goto error_file;
+
+		*stream = desc;
+
+		return SUCCESS;
+	}
+
+	desc->buffer_size = param->buffer_size;
+	for (i = 0; i < 2; i++) {
+		desc->buffer[i] = param->buffer[i];
+		if (desc->buffer[i])
+			continue;
+
+		/* Allocate only the buffers the caller did not provide */
+		desc->buffer[i] = malloc(desc->buffer_size);
+		if (!desc->buffer[i]) {
+			ret = -ENOMEM;
+			goto error_buffers;
+		}
+		desc->own_buffer[i] = true;
+	}
+
+	res = f_open(&desc->file, param->path, FA_WRITE | FA_CREATE_ALWAYS);
+	if (res != FR_OK) {
+		ret = ff_stream_err(res);
+		goto error_buffers;
+	}
+	if (param->size) {
+		res = f_expand(&desc->file, param->size, 1);
+		if (res != FR_OK) {
+			/* FR_DENIED: no contiguous free area large enough */
+			ret = res == FR_DENIED ? -ENOSPC : ff_stream_err(res);
+			goto error_file;
+		}
+		ret = ff_stream_link_map(desc);
+		if (ret != SUCCESS)
+			goto error_file;
+	}
+
+	*stream = desc;
+
+	return SUCCESS;
+
+error_file:
+	f_close(&desc->file);
+	if (param->mode == FF_STREAM_WRITE)
+		f_unlink(param->path);
+error_buffers:
+	for (i = 0; i < 2; i++)
+		if (desc->own_buffer[i])
+			free(desc->buffer[i]);
+error_desc:
+	free(desc->link_map);
+	free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Get the buffer to be filled next, by a DMA transfer for instance.
+ *        While it is filled, the other buffer can be written to the file.
+ * @param stream - Stream descriptor.
+ * @return The buffer, of stream->buffer_size bytes, NULL if both buffers
+ *         are waiting to be written.
+ */
+uint8_t *ff_stream_get_buffer(struct ff_stream *stream)
+{
+	if (stream->level[stream->fill])
+		return NULL;
+
+	return stream->buffer[stream->fill];
+}
+
+/**
+ * @brief Hand the buffer given by ff_stream_get_buffer() to the stream and
+ *        switch to the other buffer. May be called from interrupt context,
+ *        the data is written by ff_stream_process().
+ *        Buffers are expected full: a shorter buffer ends the sector
+ *        alignment of the writes that follow.
+ * @param stream - Stream descriptor.
+ * @param len - Number of bytes in the buffer.
+ * @return SUCCESS in case of success, -EOVERRUN if no buffer was free,
+ *         negative error code otherwise.
+ */
+int32_t ff_stream_submit(struct ff_stream *stream, uint32_t len)
+{
+	if (!len || len > stream->buffer_size)
+		return -EINVAL;
+	if (stream->level[stream->fill])
+		return -EOVERRUN;
+
+	stream->level[stream->fill] = len;
+	stream->fill ^= 1;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write the submitted buffers to the file, in order, and free them.
+ * @param stream - Stream descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_process(struct ff_stream *stream)
+{
+	int32_t	ret;
+
+	while (stream->level[stream->drain]) {
+		ret = ff_stream_file_write(stream, stream->buffer[stream->drain],
+					   stream->level[stream->drain]);
+		if (ret != SUCCESS)
+			return ret;
+		stream->level[stream->drain] = 0;
+		stream->drain ^= 1;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Append data to the file. Data is gathered in the buffers, which
+ *        are written when full. While no data is buffered, whole buffers
+ *        worth of data are written straight from data.
+ *        Not to be mixed with ff_stream_get_buffer()/ff_stream_submit().
+ * @param stream - Stream descriptor.
+ * @param data - Data to write.
+ * @param len - Number of bytes.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_write(struct ff_stream *stream, const void *data,
+			uint32_t len)
+{
+	const uint8_t	*src = data;
+	uint8_t		*buffer;
+	uint32_t	copy_len;
+	int32_t		ret;
+
+	if (stream->mode != FF_STREAM_WRITE)
+		return -EINVAL;
+
+	while (len) {
+		if (!stream->offset && len >= stream->buffer_size) {
+			ret = ff_stream_process(stream);
+			if (ret != SUCCESS)
+				return ret;
+			copy_len = len - len % stream->buffer_size;
+			ret = ff_stream_file_write(stream, src, copy_len);
+			if (ret != SUCCESS)
+				return ret;
+		} else {
+			buffer = ff_stream_get_buffer(stream);
+			if (!buffer) {
+				ret = ff_stream_process(stream);
+				if (ret != SUCCESS)
+					return ret;
+				continue;
+			}
+			copy_len = stream->buffer_size - stream->offset;
+			if (copy_len > len)
+				copy_len = len;
+			memcpy(buffer + stream->offset, src, copy_len);
+			stream->offset += copy_len;
+			if (stream->offset == stream->buffer_size) {
+				stream->offset = 0;
+				ret = ff_stream_submit(stream, stream->buffer_size);
+				if (ret != SUCCESS)
+					return ret;
+				ret = ff_stream_process(stream);
+				if (ret != SUCCESS)
+					return ret;
+			}
+		}
+		src += copy_len;
+		len -= copy_len;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read data from the current position of a stream opened for
+ *        reading.
+ * @param stream - Stream descriptor.
+ * @param data - Where to store the data.
+ * @param len - Number of bytes to read.
+ * @param read - Number of bytes read, less than len at the end of the file.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_read(struct ff_stream *stream, void *data, uint32_t len,
+		       uint32_t *read)
+{
+	UINT	nb;
+	FRESULT	res;
+
+	if (stream->mode != FF_STREAM_READ)
+		return -EINVAL;
+
+	res = f_read(&stream->file, data, len, &nb);
+	*read = nb;
+
+	return ff_stream_err(res);
+}
+
+/**
+ * @brief Move the position of a stream opened for reading, using the
+ *        cluster link map.
+ * @param stream - Stream descriptor.
+ * @param offset - New position, clipped at the end of the file.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_seek(struct ff_stream *stream, FSIZE_t offset)
+{
+	if (stream->mode != FF_STREAM_READ)
+		return -EINVAL;
+
+	return ff_stream_err(f_lseek(&stream->file, offset));
+}
+
+/**
+ * @brief Close a stream. For writing, the submitted and the partially
+ *        filled buffers are written, the file is truncated to the written
+ *        data and everything is synced to the disk.
+ * @param stream - Stream descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t ff_stream_close(struct ff_stream *stream)
+{
+	FRESULT	res;
+	int32_t	ret = SUCCESS;
+	uint32_t	i;
+
+	if (!stream)
+		return -EINVAL;
+
+	if (stream->mode == FF_STREAM_WRITE) {
+		ret = ff_stream_process(stream);
+		if (ret == SUCCESS && stream->offset) {
+			ret = ff_stream_submit(stream, stream->offset);
+			if (ret == SUCCESS)
+				ret = ff_stream_process(stream);
+		}
+		/* Release the preallocated clusters that were not used */
+		if (ret == SUCCESS &&
+		    f_tell(&stream->file) < f_size(&stream->file))
+			ret = ff_stream_err(f_truncate(&stream->file));
+	}
+
+	res = f_close(&stream->file);
+	if (ret == SUCCESS)
+		ret = ff_stream_err(res);
+
+	for (i = 0; i < 2; i++)
+		if (stream->own_buffer[i])
+			free(stream->buffer[i]);
+	free(stream->link_map);
+	free(stream);
+
+	return ret;
+}
@@ -0,0 +1,140 @@
+/***************************************************************************//**
+ *   @file   adi_ff_stream.h
+ *   @brief  Streaming log files on FatFs: contiguous preallocation, sector aligned writes from ping-pong buffers and fast seek playback.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef ADI_FF_STREAM_H_
+#define ADI_FF_STREAM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ff.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum ff_stream_mode
+ * @brief Direction of a stream
+ */
+enum ff_stream_mode {
+	/** Create the file and append to it */
+	FF_STREAM_WRITE,
+	/** Play an existing file back */
+	FF_STREAM_READ,
+};
+
+/**
+ * @struct ff_stream_init_param
+ * @brief Parameters of ff_stream_open()
+ */
+struct ff_stream_init_param {
+	/** Path of the file, on a mounted volume */
+	const char		*path;
+	/** Direction of the stream */
+	enum ff_stream_mode	mode;
+	/**
+	 * Write: bytes allocated contiguously when the file is created, the
+	 * file is truncated to the written data on close. 0 to let the file
+	 * grow cluster by cluster.
+	 */
+	FSIZE_t			size;
+	/**
+	 * Write: size of each of the two buffers, a multiple of the sector
+	 * size. A multiple of the cluster size gives the longest disk writes.
+	 */
+	uint32_t		buffer_size;
+	/** Write: the two buffers (e.g. DMA capable), each allocated if NULL */
+	uint8_t			*buffer[2];
+};
+
+/**
+ * @struct ff_stream
+ * @brief Stream descriptor
+ */
+struct ff_stream {
+	/** FatFs file */
+	FIL			file;
+	/** Direction of the stream */
+	enum ff_stream_mode	mode;
+	/** Cluster link map of the file, for the fast seek mode */
+	DWORD			*link_map;
+	/** Ping-pong buffers */
+	uint8_t			*buffer[2];
+	/** Size of each buffer */
+	uint32_t		buffer_size;
+	/** Each buffer was allocated by ff_stream_open() */
+	bool			own_buffer[2];
+	/** Bytes of each submitted buffer, 0 while the buffer is free */
+	volatile uint32_t	level[2];
+	/** Buffer filled by the producer */
+	volatile uint8_t	fill;
+	/** Buffer written to the file next */
+	uint8_t			drain;
+	/** Bytes copied in the fill buffer by ff_stream_write() */
+	uint32_t		offset;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Open a stream. */
+int32_t ff_stream_open(struct ff_stream **stream,
+		       const struct ff_stream_init_param *param);
+/* Get the buffer to be filled next, NULL if both are waiting to be written. */
+uint8_t *ff_stream_get_buffer(struct ff_stream *stream);
+/* Hand the filled buffer to the stream. */
+int32_t ff_stream_submit(struct ff_stream *stream, uint32_t len);
+/* Write the submitted buffers to the file. */
+int32_t ff_stream_process(struct ff_stream *stream);
+/* Append data to the file, through the buffers. */
+int32_t ff_stream_write(struct ff_stream *stream, const void *data,
+			uint32_t len);
+/* Read data from the current position of a stream opened for reading. */
+int32_t ff_stream_read(struct ff_stream *stream, void *data, uint32_t len,
+		       uint32_t *read);
+/* Move the position of a stream opened for reading. */
+int32_t ff_stream_seek(struct ff_stream *stream, FSIZE_t offset);
+/* Write the buffered data, trim the preallocation and close the file. */
+int32_t ff_stream_close(struct ff_stream *stream);
+
+#endif /* ADI_FF_STREAM_H_ */
@@ -121,6 +121,8 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 	ldesc->network.sock = param->sock;
 	ldesc->network.mqttread = mqtt_noos_read;
 	ldesc->network.mqttwrite = mqtt_noos_write;
+	ldesc->network.tx_queue = param->publish_queue;
+	ldesc->network.tx_queue_size = param->publish_queue_size;
 
 	app_handler = param->message_handler;
 
@@ -205,21 +207,83 @@ int32_t mqtt_disconnect(struct mqtt_desc *desc)
 	return MQTTDisconnect(desc->mqtt_client);
 }
 
+/**
+ * @brief Add a QoS0 PUBLISH packet to the publish queue, without waiting.
+ * If the queue is full, the queued packets the socket takes right away are
+ * sent first.
+ * @param desc - Reference to MQTT client
+ * @param topic - Topic name
+ * @param msg - QoS0 message
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - -EAGAIN : The queue is full
+ *  - -EMSGSIZE : The packet is larger than the queue
+ *  - \ref FAILURE : Otherwise
+ */
+static int32_t mqtt_queue_publish(struct mqtt_desc *desc, const int8_t *topic,
+				  const struct mqtt_message *msg)
+{
+	Network		*net = &desc->network;
+	MQTTString	topic_name = MQTTString_initializer;
+	uint32_t	queued;
+	int32_t		ret;
+	int		len;
+
+	if (!desc->mqtt_client->isconnected)
+		return FAILURE;
+
+	topic_name.cstring = (char *)topic;
+	while (true) {
+		len = MQTTSerialize_publish(net->tx_queue + net->tx_len,
+					    net->tx_queue_size - net->tx_len,
+					    0, MQTT_QOS0, msg->retained, 0,
+					    topic_name, msg->payload,
+					    msg->len);
+		if (len > 0) {
+			net->tx_len += len;
+			return SUCCESS;
+		}
+		if (len != MQTTPACKET_BUFFER_TOO_SHORT)
+			return FAILURE;
+		if (!net->tx_len)
+			return -EMSGSIZE;
+
+		queued = net->tx_len;
+		ret = mqtt_flush(desc, 0);
+		if (IS_ERR_VALUE(ret) && ret != -EAGAIN)
+			return ret;
+		/* Never wait: give up when the socket takes nothing more */
+		if (net->tx_len == queued)
+			return -EAGAIN;
+	}
+}
+
 /**
  * @brief Send publish to MQTT broker
+ * With a publish queue, QoS0 messages are queued and this never waits.
  * @param desc - Reference to MQTT client
  * @param topic - Topic pattern which can include wildcards
  * @param msg - Message to send
  * @return
  *  - \ref SUCCESS : On success
+ *  - -EAGAIN : QoS0 message not queued, the publish queue is full
  *  - \ref FAILURE : Otherwise
  */
 int32_t mqtt_publish(struct mqtt_desc *desc, const int8_t* topic,
 		     const struct mqtt_message* msg)
 {
+	int32_t	ret;
+
 	if (!desc || !msg)
 		return FAILURE;
 
+	if (msg->qos == MQTT_QOS0 && desc->network.tx_queue) {
+		ret = mqtt_queue_publish(desc, topic, msg);
+		/* Packets larger than the queue are sent right away */
+		if (ret != -EMSGSIZE)
+			return ret;
+	}
+
 	MQTTMessage message = { 0 };
 
 	message.payload = (void *)msg->payload;
@@ -291,5 +355,41 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic)
  */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms)
 {
+	int32_t	ret;
+
+	ret = mqtt_flush(desc, 0);
+	if (IS_ERR_VALUE(ret) && ret != -EAGAIN)
+		return ret;
+
 	return MQTTYield(desc->mqtt_client, timeout_ms);
 }
+
+/**
+ * @brief Send the queued publish packets
+ *
+ * The packets are sent in as few socket writes as the socket allows.
+ * @param desc - Reference to MQTT client
+ * @param timeout_ms - Time to wait for the socket to take the data, 0 to send
+ * only what it takes right away
+ * @return
+ *  - \ref SUCCESS : The queue is empty
+ *  - -EAGAIN : Packets are left in the queue
+ *  - negative error code : Otherwise
+ */
+int32_t mqtt_flush(struct mqtt_desc *desc, uint32_t timeout_ms)
+{
+	uint32_t	queued;
+	int32_t		ret;
+
+	if (!desc)
+		return FAILURE;
+
+	queued = desc->network.tx_len;
+	ret = mqtt_noos_flush(&desc->network, timeout_ms);
+	/* The keep alive ping is only needed when nothing is sent */
+	if (desc->network.tx_len < queued)
+		TimerCountdown(&desc->mqtt_client->last_sent,
+			       desc->mqtt_client->keepAliveInterval);
+
+	return ret;
+}
@@ -227,6 +227,14 @@ struct mqtt_init_param {
 	uint32_t		send_buff_size;
 	/** Size of the read buffer */
 	uint32_t		read_buff_size;
+	/**
+	 * Queue of QoS0 PUBLISH packets, sent together by \ref mqtt_flush,
+	 * \ref mqtt_yield, before any other packet or when full. NULL to send
+	 * each publish right away.
+	 */
+	uint8_t			*publish_queue;
+	/** Size of the publish queue */
+	uint32_t		publish_queue_size;
 	/**
 	 * Callback to be called when a message is received from the broker
 	 * @param Message received from the broker.
@@ -267,5 +275,7 @@ int32_t mqtt_subscribe(struct mqtt_desc *desc, const int8_t *topic,
 int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic);
 /* Allow messages to be received */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms);
+/* Send the queued publish packets */
+int32_t mqtt_flush(struct mqtt_desc *desc, uint32_t timeout_ms);
 
 #endif
@@ -43,11 +43,11 @@
 
 #include "mqtt_noos_support.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
 #include "timer.h"
 #include "error.h"
 #include "util.h"
-#include "delay.h"
-#include "error.h"
 
 /******************************************************************************/
 /**************************** Global Variables ********************************/
@@ -147,40 +147,165 @@ char TimerIsExpired(Timer* t)
 	return false;
 }
 
-/* Implementation of mqtt_noos_read used by MQTTClient.c */
+/**
+ * @brief Read from the network, through the receive buffer.
+ * Implementation of mqtt_noos_read used by MQTTClient.c.
+ * The socket is read until len bytes are available or the timeout expires,
+ * without delays in between. A timeout of 0 makes a single attempt.
+ * @param net - Network structure
+ * @param buff - Where to store the data
+ * @param len - Number of bytes to read
+ * @param timeout - Timeout in milliseconds
+ * @return Number of bytes read, less than len if the timeout expired, or
+ * negative error code.
+ */
 int mqtt_noos_read(Network* net, unsigned char* buff, int len, int timeout)
 {
-	uint32_t	sent;
+	Timer		deadline;
+	uint32_t	received;
+	uint32_t	avail;
+	uint32_t	left;
 	int32_t		rc;
 
-	if (!len)
+	if (len <= 0)
 		return 0;
 
+	TimerCountdownMS(&deadline, timeout);
+	received = 0;
+	while (true) {
+		left = (uint32_t)len - received;
+		avail = net->rx_end - net->rx_start;
+		if (avail) {
+			avail = min(avail, left);
+			memcpy(buff + received, net->rx_buff + net->rx_start,
+			       avail);
+			net->rx_start += avail;
+			received += avail;
+			if (received == (uint32_t)len)
+				return received;
+			left -= avail;
+		}
+
+		/* Large reads go straight to the caller buffer */
+		if (left >= MQTT_NOOS_RX_BUFF_SIZE) {
+			rc = socket_recv(net->sock, buff + received, left);
+			if (rc > 0) {
+				received += rc;
+				if (received == (uint32_t)len)
+					return received;
+			}
+		} else {
+			rc = socket_recv(net->sock, net->rx_buff,
+					 MQTT_NOOS_RX_BUFF_SIZE);
+			if (rc > 0) {
+				net->rx_start = 0;
+				net->rx_end = rc;
+			}
+		}
+		if (rc > 0)
+			continue;
+		if (rc != -EAGAIN && IS_ERR_VALUE(rc))
+			return rc;
+		if (TimerIsExpired(&deadline))
+			return received;
+	}
+}
+
+/**
+ * @brief Send data until all of it is sent or the deadline expires.
+ * @param net - Network structure
+ * @param buff - Data to send
+ * @param len - Number of bytes
+ * @param deadline - Timer of the deadline
+ * @return Number of bytes sent or negative error code.
+ */
+static int32_t mqtt_noos_send(Network *net, const uint8_t *buff, uint32_t len,
+			      Timer *deadline)
+{
+	uint32_t	sent;
+	int32_t		rc;
+
 	sent = 0;
-	do {
- 		rc = socket_recv(net->sock, (void *)(buff + sent),
-				(uint32_t)(len - sent));
- 		if (rc != -EAGAIN) { //If data available or error
- 			if (IS_ERR_VALUE(rc))
- 				return rc;
-				 
- 			sent += rc;
- 			if (sent >= len)
- 				return sent;
- 		}
-
-		mdelay(1);
-	} while (--timeout);
-
-	/* 0 bytes have been read */
-	return 0;
+	while (sent < len) {
+		rc = socket_send(net->sock, buff + sent, len - sent);
+		if (rc > 0) {
+			sent += rc;
+			continue;
+		}
+		if (rc != -EAGAIN && IS_ERR_VALUE(rc))
+			return rc;
+		if (TimerIsExpired(deadline))
+			break;
+	}
+
+	return sent;
+}
+
+/**
+ * @brief Send the queued packets, in a single socket write when the socket
+ * takes them all.
+ * @param net - Network structure
+ * @param deadline - Timer of the deadline
+ * @return SUCCESS if the queue is empty, -EAGAIN if data is left in the queue,
+ * negative error code otherwise.
+ */
+static int32_t mqtt_noos_send_queue(Network *net, Timer *deadline)
+{
+	int32_t	sent;
+
+	sent = mqtt_noos_send(net, net->tx_queue, net->tx_len, deadline);
+	if (IS_ERR_VALUE(sent))
+		return sent;
+
+	/* A packet sent partially is completed before anything else */
+	net->tx_len -= sent;
+	memmove(net->tx_queue, net->tx_queue + sent, net->tx_len);
+
+	return net->tx_len ? -EAGAIN : SUCCESS;
 }
 
-/* Implementation of mqtt_noos_write used by MQTTClient.c */
+/**
+ * @brief Send the queued packets.
+ * @param net - Network structure
+ * @param timeout_ms - Timeout, 0 to send only what the socket takes now
+ * @return SUCCESS if the queue is empty, -EAGAIN if data is left in the queue,
+ * negative error code otherwise.
+ */
+int32_t mqtt_noos_flush(Network *net, uint32_t timeout_ms)
+{
+	Timer	deadline;
+
+	if (!net->tx_len)
+		return SUCCESS;
+
+	TimerCountdownMS(&deadline, timeout_ms);
+
+	return mqtt_noos_send_queue(net, &deadline);
+}
+
+/**
+ * @brief Write to the network.
+ * Implementation of mqtt_noos_write used by MQTTClient.c.
+ * The queued packets are sent first, to keep the order of the stream.
+ * @param net - Network structure
+ * @param buff - Data to send
+ * @param len - Number of bytes
+ * @param timeout - Timeout in milliseconds
+ * @return Number of bytes of buff sent or negative error code.
+ */
 int mqtt_noos_write(Network* net, unsigned char* buff, int len, int timeout)
 {
-	/* non blocking read is not implemented */
-	UNUSED_PARAM(timeout);
+	Timer	deadline;
+	int32_t	rc;
+
+	TimerCountdownMS(&deadline, timeout);
+	if (net->tx_len) {
+		rc = mqtt_noos_send_queue(net, &deadline);
+		if (rc == -EAGAIN)
+			return 0;
+		if (IS_ERR_VALUE(rc))
+			return rc;
+	}
 
-	return socket_send(net->sock, (const void *)buff, (uint32_t)len);
+	return mqtt_noos_send(net, buff, (uint32_t)len, &deadline);
 }
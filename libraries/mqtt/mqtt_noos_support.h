@@ -47,6 +47,15 @@
 #include <stdint.h>
 #include "tcp_socket.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bytes read from the socket at once, MQTTClient reads a few at a time */
+#ifndef MQTT_NOOS_RX_BUFF_SIZE
+#define MQTT_NOOS_RX_BUFF_SIZE	256
+#endif
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -80,6 +89,18 @@ struct network_port_noos {
 	/** Reference to no-os network wrapper write function */
 	int			(*mqttwrite)(Network*, unsigned char*, int,
 					     int);
+	/** Data received from the socket and not yet read */
+	uint8_t			rx_buff[MQTT_NOOS_RX_BUFF_SIZE];
+	/** Offset of the first unread byte in rx_buff */
+	uint32_t		rx_start;
+	/** Offset of the end of the data in rx_buff */
+	uint32_t		rx_end;
+	/** Packets waiting to be sent, before any other packet. May be NULL */
+	uint8_t			*tx_queue;
+	/** Size of tx_queue */
+	uint32_t		tx_queue_size;
+	/** Bytes in tx_queue */
+	uint32_t		tx_len;
 };
 
 /******************************************************************************/
@@ -95,5 +116,7 @@ void mqtt_timer_remove();
 int mqtt_noos_read(Network*, unsigned char*, int, int);
 /* Function to be linked to Network.mqttwrite */
 int mqtt_noos_write(Network*, unsigned char*, int, int);
+/* Send the queued packets */
+int32_t mqtt_noos_flush(Network *net, uint32_t timeout_ms);
 
 #endif
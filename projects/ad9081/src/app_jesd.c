@@ -177,5 +177,8 @@ int32_t app_jesd_init(struct clk clk[2],
 	clk[1].name = "jesd_tx";
 	clk[1].hw = &jesd_tx_hw;
 
+	clk_register(&clk[0], NULL);
+	clk_register(&clk[1], NULL);
+
 	return SUCCESS;
 }
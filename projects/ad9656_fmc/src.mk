@@ -23,6 +23,7 @@ SRCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c			\
         $(DRIVERS)/axi_core/clk_axi_clkgen/clk_axi_clkgen.c		\
         $(DRIVERS)/axi_core/jesd204/axi_adxcvr.c			\
         $(DRIVERS)/axi_core/jesd204/axi_jesd204_rx.c			\
+        $(DRIVERS)/axi_core/jesd204/jesd204_link.c			\
         $(DRIVERS)/axi_core/jesd204/xilinx_transceiver.c		\
         $(DRIVERS)/adc/ad9656/ad9656.c					\
         $(DRIVERS)/spi/spi.c						\
@@ -47,6 +48,7 @@ INCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.h			\
         $(DRIVERS)/axi_core/clk_axi_clkgen/clk_axi_clkgen.h		\
         $(DRIVERS)/axi_core/jesd204/axi_adxcvr.h			\
         $(DRIVERS)/axi_core/jesd204/axi_jesd204_rx.h			\
+        $(DRIVERS)/axi_core/jesd204/jesd204_link.h			\
         $(DRIVERS)/axi_core/jesd204/xilinx_transceiver.h		\
         $(DRIVERS)/adc/ad9656/ad9656.h
 ifeq (y,$(strip $(TINYIIOD)))
@@ -31,6 +31,7 @@ SRCS += $(PLATFORM_DRIVERS)/xilinx_gpio.c \
 	$(DRIVERS)/spi/spi.c \
 	$(PLATFORM_DRIVERS)/xilinx_spi.c \
 	$(PLATFORM_DRIVERS)/delay.c \
+	$(PLATFORM_DRIVERS)/timer.c \
 	$(NO-OS)/util/util.c \
 	$(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c \
 	$(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.c \
@@ -42,6 +43,8 @@ INCS +=	$(INCLUDE)/spi.h \
 	$(PLATFORM_DRIVERS)/gpio_extra.h \
 	$(INCLUDE)/error.h \
 	$(INCLUDE)/delay.h \
+	$(INCLUDE)/timer.h \
+	$(PLATFORM_DRIVERS)/timer_extra.h \
 	$(INCLUDE)/util.h \
 	$(INCLUDE)/print_log.h \
 	$(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.h \
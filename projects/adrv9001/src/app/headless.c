@@ -45,6 +45,8 @@
 #include "error.h"
 #include "util.h"
 #include "spi.h"
+#include "timer.h"
+#include "timer_extra.h"
 
 #include "axi_adc_core.h"
 #include "axi_dac_core.h"
@@ -80,6 +82,14 @@ int main(void)
 	struct adi_adrv9001_ArmVersion arm_version;
 	struct adi_adrv9001_SiliconVersion silicon_version;
 	struct adrv9002_rf_phy phy;
+#ifdef _XPARAMETERS_PS_H_
+	struct xil_timer_init_param timer_extra = {
+		.type = TIMER_GLOBAL,
+	};
+	struct timer_init_param timer_param = {
+		.extra = &timer_extra,
+	};
+#endif
 
 	struct axi_adc_init rx1_adc_init = {
 		"axi-adrv9002-rx-lpc",
@@ -164,10 +174,21 @@ int main(void)
 #if defined(ADRV9002_RX2TX2)
 	phy.rx2tx2 = true;
 #endif
+	phy.fw_checksum_expected = ARM_IMAGE_CHECKSUM;
+	phy.stream_checksum_expected = STREAM_IMAGE_CHECKSUM;
+
+#ifdef _XPARAMETERS_PS_H_
+	/* Times the firmware load; without it the load time reads 0 */
+	if (timer_init(&phy.timer, &timer_param) != SUCCESS)
+		phy.timer = NULL;
+#endif
 
 	ret = adrv9002_setup(&phy, adrv9002_init_get());
-	if (ret)
+	if (ret) {
+		if (phy.timer)
+			timer_remove(phy.timer);
 		return ret;
+	}
 
 	adi_adrv9001_ApiVersion_Get(phy.adrv9001, &api_version);
 	adi_adrv9001_arm_Version(phy.adrv9001, &arm_version);
@@ -341,6 +362,8 @@ int main(void)
 	printf("Bye\n");
 
 error:
+	if (phy.timer)
+		timer_remove(phy.timer);
 	adi_adrv9001_HwClose(phy.adrv9001);
 	axi_adc_remove(phy.rx1_adc);
 	axi_dac_remove(phy.tx1_dac);
@@ -204,7 +204,12 @@ int32_t no_os_hw_reset(void *devHalCfg, uint8_t pinLevel)
 int32_t no_os_spi_write(void *devHalCfg, const uint8_t txData[],
 			uint32_t numTxBytes)
 {
-	static const int32_t MAX_SIZE = 4096;
+	/*
+	 * spi_write_and_read() overwrites the buffer with the read back bytes.
+	 * The size is a multiple of the 3 byte instruction, so a split never
+	 * cuts one in half.
+	 */
+	static uint8_t buff[4095];
 	uint32_t toWrite = 0;
 	int32_t result = 0;
 	int32_t remaining = numTxBytes;
@@ -216,9 +221,9 @@ int32_t no_os_spi_write(void *devHalCfg, const uint8_t txData[],
 	halCfg = (struct adrv9002_hal_cfg *)devHalCfg;
 
 	do {
-		toWrite = (remaining > MAX_SIZE) ? MAX_SIZE : remaining;
-		result = spi_write_and_read(halCfg->spi, &txData[numTxBytes - remaining],
-					    toWrite);
+		toWrite = (remaining > (int32_t)sizeof(buff)) ? sizeof(buff) : remaining;
+		memcpy(buff, &txData[numTxBytes - remaining], toWrite);
+		result = spi_write_and_read(halCfg->spi, buff, toWrite);
 		if (result < 0)
 			return ADI_COMMON_ERR_API_FAIL;
 
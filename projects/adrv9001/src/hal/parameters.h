@@ -91,6 +91,14 @@
 #define DAC1_DDR_BASEADDR		(DDR_MEM_BASEADDR + 0xA000000)
 #define DAC2_DDR_BASEADDR		(DDR_MEM_BASEADDR + 0xA100000)
 
+/* 32-bit word sums of the images in src/firmware */
+#ifdef SI_REV_B0
+#define ARM_IMAGE_CHECKSUM		0x7E11A881
+#else
+#define ARM_IMAGE_CHECKSUM		0x71CC29D3
+#endif
+#define STREAM_IMAGE_CHECKSUM		0xC86624F8
+
 /* AXI ADC/DAC */
 #define RX1_ADC_BASEADDR		XPAR_AXI_ADRV9001_BASEADDR
 #define RX2_ADC_BASEADDR		(XPAR_AXI_ADRV9001_BASEADDR + 0x1000)
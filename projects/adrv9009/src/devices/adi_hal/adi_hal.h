@@ -324,6 +324,41 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo, uint16_t addr, uint8_t data);
 adiHalErr_t  ADIHAL_spiWriteBytes(void *devHalInfo, uint16_t *addr,
 				  uint8_t *data, uint32_t count);
 
+/**
+ * \brief Writes consecutive SPI registers of an ADI Device in streaming mode
+ *
+ * This function sends a single instruction followed by count data bytes, so
+ * data[0] goes to addr, data[1] to addr + 1, etc. The device must have SPI
+ * streaming enabled (SPI_INTERFACE_CONFIG_B) and the address set to auto
+ * increment (SPI_INTERFACE_CONFIG_A); in single instruction mode, or with a
+ * descending address, only the first byte would reach the intended register.
+ *
+ * Platforms limited in transfer length may split the stream into several
+ * instructions, each restarting at the address of its first byte.
+ *
+ * \pre This function may only be used after the required SPI drivers and resources
+ * are opened by the ADIHAL_openHw() function call and not after ADIHAL_closeHW.
+ *
+ * <B>Dependencies</B>
+ * --Application and Platform Specific modules
+ *
+ * \param devHalInfo Pointer to Platform HAL defined structure containing
+ *                   hardware settings describing the device of interest.
+ *
+ * \param addr 15-bit address of the first SPI register to write.
+ *
+ * \param data An array of 8-bit data values to write to addr, addr + 1, ...
+ *
+ * \param count The number of registers to write. Must be smaller or equal
+ *              to the size of the data array.
+ *
+ * \retval ADIHAL_OK if function completed successfully.
+ * \retval ADIHAL_SPI_FAIL if function failed to complete SPI transaction
+ * \retval ADIHAL_WAIT_TIMEOUT if HAL timeout expired before SPI transaction could be completed.
+ */
+adiHalErr_t ADIHAL_spiWriteStream(void *devHalInfo, uint16_t addr,
+				  uint8_t *data, uint32_t count);
+
 /**
  * \brief Performs a Single SPI Read from an ADI Device
  *
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <string.h>
 #include "adi_hal.h"
 #include "parameters.h"
 #include "spi.h"
@@ -50,6 +51,13 @@
 #include "error.h"
 #include "delay.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Data bytes sent after one instruction by ADIHAL_spiWriteStream() */
+#define ADIHAL_SPI_STREAM_MAX	64
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -192,6 +200,31 @@ adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 	return ADIHAL_OK;
 }
 
+adiHalErr_t ADIHAL_spiWriteStream(void *devHalInfo,
+				  uint16_t addr, uint8_t *data, uint32_t count)
+{
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	uint8_t buf[2 + ADIHAL_SPI_STREAM_MAX];
+	uint32_t len;
+	int32_t status;
+
+	while (count) {
+		len = (count > ADIHAL_SPI_STREAM_MAX) ? ADIHAL_SPI_STREAM_MAX : count;
+		buf[0] = (addr >> 8) & 0x7F;
+		buf[1] = addr & 0xFF;
+		memcpy(&buf[2], data, len);
+		status = spi_write_and_read(devHalData->spi_adrv_desc, buf, 2 + len);
+		if (status != SUCCESS)
+			return ADIHAL_SPI_FAIL;
+
+		addr += len;
+		data += len;
+		count -= len;
+	}
+
+	return ADIHAL_OK;
+}
+
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 			       uint16_t addr, uint8_t *readdata)
 {
@@ -51,6 +51,9 @@
 #include <xil_printf.h>
 #include <xil_cache.h>
 #include "axi_adxcvr.h"
+#include "jesd204_link.h"
+#include "timer.h"
+#include "timer_extra.h"
 #else
 #include "clk_altera_a10_fpll.h"
 #include "altera_adxcvr.h"
@@ -454,6 +457,7 @@ static int fmcdaq2_altera_pll_setup()
 	return SUCCESS;
 }
 
+#ifdef ALTERA_PLATFORM
 static int fmcdaq2_trasnceiver_setup(struct fmcdaq2_dev *dev,
 				     struct fmcdaq2_init_param *dev_init)
 {
@@ -474,22 +478,10 @@ static int fmcdaq2_trasnceiver_setup(struct fmcdaq2_dev *dev,
 	if (status != SUCCESS) {
 		printf("error: %s: adxcvr_init() failed\n", dev->ad9144_xcvr->name);
 	}
-#ifndef ALTERA_PLATFORM
-	status = adxcvr_clk_enable(dev->ad9144_xcvr);
-	if (status != SUCCESS) {
-		printf("error: %s: adxcvr_clk_enable() failed\n", dev->ad9144_xcvr->name);
-	}
-#endif
 	status = adxcvr_init(&dev->ad9680_xcvr, &dev_init->ad9680_xcvr_param);
 	if (status != SUCCESS) {
 		printf("error: %s: adxcvr_init() failed\n", dev->ad9680_xcvr->name);
 	}
-#ifndef ALTERA_PLATFORM
-	status = adxcvr_clk_enable(dev->ad9680_xcvr);
-	if (status != SUCCESS) {
-		printf("error: %s: adxcvr_clk_enable() failed\n", dev->ad9680_xcvr->name);
-	}
-#endif
 	status = axi_jesd204_rx_init(&dev->ad9680_jesd, &dev_init->ad9680_jesd_param);
 	if (status != SUCCESS) {
 		printf("error: %s: axi_jesd204_rx_init() failed\n", dev->ad9680_jesd->name);
@@ -503,6 +495,149 @@ static int fmcdaq2_trasnceiver_setup(struct fmcdaq2_dev *dev,
 
 	return status;
 }
+#else
+/* Converter context of the link bring-up operations */
+struct fmcdaq2_link_ctx {
+	struct fmcdaq2_dev *dev;
+	struct fmcdaq2_init_param *dev_init;
+};
+
+/* ADC: configured before its transceiver and link layer come up */
+static int32_t fmcdaq2_ad9680_link_setup(void *ctx)
+{
+	struct fmcdaq2_link_ctx *link_ctx = ctx;
+
+	return ad9680_setup(&link_ctx->dev->ad9680_device,
+			    &link_ctx->dev_init->ad9680_param);
+}
+
+/* DAC: configured once its link layer and transceiver are running */
+static int32_t fmcdaq2_ad9144_link_setup(void *ctx)
+{
+	struct fmcdaq2_link_ctx *link_ctx = ctx;
+
+	return ad9144_setup(&link_ctx->dev->ad9144_device,
+			    &link_ctx->dev_init->ad9144_param);
+}
+
+static const struct jesd204_link_op
+	fmcdaq2_ad9680_link_ops[JESD204_LINK_PHASE_NUM] = {
+	[JESD204_LINK_PHASE_SETUP] = {
+		.start = fmcdaq2_ad9680_link_setup,
+	},
+};
+
+static const struct jesd204_link_op
+	fmcdaq2_ad9144_link_ops[JESD204_LINK_PHASE_NUM] = {
+	[JESD204_LINK_PHASE_RUNNING] = {
+		.start = fmcdaq2_ad9144_link_setup,
+	},
+};
+
+/* Time source of the link bring-up report */
+static struct timer_desc *fmcdaq2_link_timer;
+
+/*
+ * Microseconds counted from fmcdaq2_link_timer. The ticks are accumulated
+ * between calls, so the time keeps increasing past the 32-bit counter wrap.
+ */
+static uint32_t fmcdaq2_link_time_us(void)
+{
+	static uint32_t last, ticks, us;
+	uint32_t cnt, ticks_per_us;
+
+	if (timer_counter_get(fmcdaq2_link_timer, &cnt) != SUCCESS)
+		return us;
+
+	ticks_per_us = fmcdaq2_link_timer->freq_hz / 1000000;
+	ticks += cnt - last;
+	last = cnt;
+	us += ticks / ticks_per_us;
+	ticks %= ticks_per_us;
+
+	return us;
+}
+
+/*
+ * Bring up both links together: the transceivers lock and the link layers
+ * synchronize in parallel, each step polled instead of waited for.
+ */
+static int fmcdaq2_link_setup(struct fmcdaq2_dev *dev,
+			      struct fmcdaq2_init_param *dev_init)
+{
+	struct fmcdaq2_link_ctx link_ctx = {dev, dev_init};
+	struct jesd204_link_bringup_param bringup_param = { 0 };
+	struct jesd204_link links[2];
+	int status;
+#ifdef _XPARAMETERS_PS_H_
+	struct xil_timer_init_param timer_extra = {
+		.type = TIMER_GLOBAL,
+	};
+	struct timer_init_param timer_param = {
+		.extra = &timer_extra,
+	};
+
+	/* Without it (MicroBlaze) only the poll delays are accounted for */
+	if (timer_init(&fmcdaq2_link_timer, &timer_param) == SUCCESS)
+		bringup_param.get_time_us = fmcdaq2_link_time_us;
+#endif
+
+	status = axi_jesd204_tx_init(&dev->ad9144_jesd, &dev_init->ad9144_jesd_param);
+	if (status != SUCCESS) {
+		printf("error: %s: axi_jesd204_tx_init() failed\n",
+		       dev_init->ad9144_jesd_param.name);
+		return status;
+	}
+
+	status = axi_jesd204_rx_init(&dev->ad9680_jesd, &dev_init->ad9680_jesd_param);
+	if (status != SUCCESS) {
+		printf("error: %s: axi_jesd204_rx_init() failed\n",
+		       dev_init->ad9680_jesd_param.name);
+		return status;
+	}
+
+	status = adxcvr_init(&dev->ad9144_xcvr, &dev_init->ad9144_xcvr_param);
+	if (status != SUCCESS) {
+		printf("error: %s: adxcvr_init() failed\n",
+		       dev_init->ad9144_xcvr_param.name);
+		return status;
+	}
+
+	status = adxcvr_init(&dev->ad9680_xcvr, &dev_init->ad9680_xcvr_param);
+	if (status != SUCCESS) {
+		printf("error: %s: adxcvr_init() failed\n",
+		       dev_init->ad9680_xcvr_param.name);
+		return status;
+	}
+
+	links[0] = (struct jesd204_link) {
+		.name = "ad9680_link",
+		.dev = {
+			[JESD204_LINK_DEV_CONVERTER] = {&link_ctx, fmcdaq2_ad9680_link_ops},
+			[JESD204_LINK_DEV_XCVR] = {dev->ad9680_xcvr, adxcvr_link_ops},
+			[JESD204_LINK_DEV_CORE] = {dev->ad9680_jesd, axi_jesd204_rx_link_ops},
+		},
+	};
+	links[1] = (struct jesd204_link) {
+		.name = "ad9144_link",
+		.dev = {
+			[JESD204_LINK_DEV_CONVERTER] = {&link_ctx, fmcdaq2_ad9144_link_ops},
+			[JESD204_LINK_DEV_XCVR] = {dev->ad9144_xcvr, adxcvr_link_ops},
+			[JESD204_LINK_DEV_CORE] = {dev->ad9144_jesd, axi_jesd204_tx_link_ops},
+		},
+	};
+
+	status = jesd204_link_bringup(links, ARRAY_SIZE(links), &bringup_param);
+	jesd204_link_report(links, ARRAY_SIZE(links));
+
+	if (fmcdaq2_link_timer) {
+		timer_remove(fmcdaq2_link_timer);
+		fmcdaq2_link_timer = NULL;
+	}
+
+	return status;
+}
+#endif
 
 
 static int fmcdaq2_test(struct fmcdaq2_dev *dev,
@@ -931,6 +1066,12 @@ static int fmcdaq2_setup(struct fmcdaq2_dev *dev,
 	if (status != SUCCESS)
 		return status;
 
+#ifndef ALTERA_PLATFORM
+	status = fmcdaq2_link_setup(dev, dev_init);
+	if (status != SUCCESS) {
+		printf("error: fmcdaq2_link_setup() failed\n");
+	}
+#else
 	status = ad9680_setup(&dev->ad9680_device, &dev_init->ad9680_param);
 	if (status != SUCCESS) {
 		printf("error: ad9680_setup() failed\n");
@@ -944,6 +1085,7 @@ static int fmcdaq2_setup(struct fmcdaq2_dev *dev,
 	if (status != SUCCESS) {
 		printf("error: ad9144_setup() failed\n");
 	}
+#endif
 
 	status = axi_adc_init(&dev->ad9680_core,  &dev_init->ad9680_core_param);
 	if (status != SUCCESS) {
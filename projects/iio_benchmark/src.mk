@@ -0,0 +1,43 @@
+################################################################################
+#									       #
+#     Shared variables:							       #
+#	- PROJECT							       #
+#	- DRIVERS							       #
+#	- INCLUDE							       #
+#	- PLATFORM_DRIVERS						       #
+#	- NO-OS								       #
+#	- TINYIIOD_DIR							       #
+#									       #
+################################################################################
+
+CFLAGS += -DENABLE_IIO_NETWORK -DDISABLE_SECURE_SOCKET
+
+SRCS += $(PROJECT)/src/main.c						\
+	$(PROJECT)/src/load_gen.c
+SRCS += $(NO-OS)/libraries/iio/iio.c					\
+	$(TINYIIOD_DIR)/tinyiiod.c					\
+	$(TINYIIOD_DIR)/parser.c					\
+	$(NO-OS)/iio/iio_demo/demo_dev.c
+SRCS += $(NO-OS)/network/tcp_socket.c					\
+	$(NO-OS)/util/circular_buffer.c					\
+	$(NO-OS)/util/list.c						\
+	$(NO-OS)/util/util.c
+SRCS +=	$(PLATFORM_DRIVERS)/linux_socket.c				\
+	$(PLATFORM_DRIVERS)/linux_uart.c				\
+	$(PLATFORM_DRIVERS)/linux_delay.c
+INCS += $(PROJECT)/src/load_gen.h
+INCS += $(NO-OS)/libraries/iio/iio.h					\
+	$(NO-OS)/libraries/iio/iio_types.h				\
+	$(TINYIIOD_DIR)/tinyiiod.h					\
+	$(NO-OS)/iio/iio_demo/demo_dev.h				\
+	$(NO-OS)/iio/iio_demo/iio_demo_dev.h
+INCS += $(NO-OS)/network/network_interface.h				\
+	$(NO-OS)/network/tcp_socket.h					\
+	$(INCLUDE)/circular_buffer.h					\
+	$(INCLUDE)/list.h						\
+	$(INCLUDE)/util.h						\
+	$(INCLUDE)/delay.h						\
+	$(INCLUDE)/uart.h						\
+	$(INCLUDE)/error.h
+INCS +=	$(PLATFORM_DRIVERS)/linux_socket.h				\
+	$(PLATFORM_DRIVERS)/linux_uart.h
@@ -0,0 +1,392 @@
+/***************************************************************************//**
+ *   @file   load_gen.c
+ *   @brief  IIO client load generator used by the IIO server benchmark.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "load_gen.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LOAD_GEN_RX_SIZE	65536
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct load_gen_client
+ * @brief State of one client thread.
+ */
+struct load_gen_client {
+	/** Load parameters */
+	const struct load_gen_param *param;
+	/** Connection to the server */
+	int fd;
+	/** Receive buffer */
+	char rx[LOAD_GEN_RX_SIZE];
+	/** Start of the unread data in rx */
+	uint32_t rx_pos;
+	/** End of the unread data in rx */
+	uint32_t rx_len;
+	/** Latency of each request (ns) */
+	uint64_t *latency;
+	/** Completed requests */
+	uint32_t requests;
+	/** Failed requests */
+	uint32_t errors;
+	/** Payload bytes received */
+	uint64_t bytes;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+static uint64_t load_gen_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int load_gen_cmp(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/* Refill the receive buffer, returns -1 when the connection is lost */
+static int load_gen_fill(struct load_gen_client *cli)
+{
+	ssize_t ret;
+
+	if (cli->rx_pos == cli->rx_len)
+		cli->rx_pos = cli->rx_len = 0;
+
+	do {
+		ret = recv(cli->fd, cli->rx + cli->rx_len,
+			   sizeof(cli->rx) - cli->rx_len, 0);
+	} while (ret < 0 && errno == EINTR);
+	if (ret <= 0)
+		return -1;
+
+	cli->rx_len += ret;
+
+	return 0;
+}
+
+/* Read exactly len bytes, data may be NULL to discard them */
+static int load_gen_read(struct load_gen_client *cli, void *data, uint32_t len)
+{
+	uint32_t n;
+
+	while (len) {
+		if (cli->rx_pos == cli->rx_len && load_gen_fill(cli))
+			return -1;
+
+		n = cli->rx_len - cli->rx_pos;
+		if (n > len)
+			n = len;
+		if (data) {
+			memcpy(data, cli->rx + cli->rx_pos, n);
+			data = (char *)data + n;
+		}
+		cli->rx_pos += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/* Read a '\n' terminated line and parse it as an integer */
+static int load_gen_read_int(struct load_gen_client *cli, long *val)
+{
+	char line[32];
+	uint32_t i = 0;
+
+	do {
+		if (i == sizeof(line) || load_gen_read(cli, &line[i], 1))
+			return -1;
+	} while (line[i++] != '\n');
+	line[i - 1] = '\0';
+
+	*val = strtol(line, NULL, 10);
+
+	return 0;
+}
+
+static int load_gen_send(struct load_gen_client *cli, const char *cmd)
+{
+	size_t len = strlen(cmd);
+	ssize_t ret;
+
+	while (len) {
+		ret = send(cli->fd, cmd, len, MSG_NOSIGNAL);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		cmd += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/* Issue a command answered by a return code only */
+static int load_gen_cmd(struct load_gen_client *cli, const char *cmd)
+{
+	long ret;
+
+	if (load_gen_send(cli, cmd) || load_gen_read_int(cli, &ret))
+		return -1;
+
+	return ret < 0 ? -1 : 0;
+}
+
+/* READ: "<len>\n" followed, on success, by len bytes and '\n' */
+static int load_gen_read_attr(struct load_gen_client *cli, const char *cmd)
+{
+	long len;
+
+	if (load_gen_send(cli, cmd) || load_gen_read_int(cli, &len))
+		return -1;
+	if (len < 0)
+		return -1;
+	if (load_gen_read(cli, NULL, len + 1))
+		return -1;
+
+	cli->bytes += len;
+
+	return 0;
+}
+
+/* READBUF: chunks of "<len>\n" + data, the first followed by the mask line */
+static int load_gen_readbuf(struct load_gen_client *cli, const char *cmd,
+			    uint32_t bytes)
+{
+	long mask, len;
+	int first = 1;
+
+	if (load_gen_send(cli, cmd))
+		return -1;
+
+	while (bytes) {
+		if (load_gen_read_int(cli, &len) || len <= 0 ||
+		    (uint32_t)len > bytes)
+			return -1;
+		if (first) {
+			if (load_gen_read_int(cli, &mask))
+				return -1;
+			first = 0;
+		}
+		if (load_gen_read(cli, NULL, len))
+			return -1;
+		cli->bytes += len;
+		bytes -= len;
+	}
+
+	return 0;
+}
+
+static int load_gen_connect(const struct load_gen_param *param)
+{
+	struct sockaddr_in sin = {
+		.sin_family = AF_INET,
+		.sin_port = htons(param->port),
+	};
+	int on = 1;
+	int fd;
+
+	if (inet_pton(AF_INET, param->addr, &sin.sin_addr) != 1)
+		return -1;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0)
+		return -1;
+
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	if (connect(fd, (struct sockaddr *)&sin, sizeof(sin))) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void *load_gen_client_thread(void *arg)
+{
+	struct load_gen_client *cli = arg;
+	const struct load_gen_param *param = cli->param;
+	uint32_t frame = param->sample_size * __builtin_popcount(param->mask);
+	char cmd[128];
+	uint64_t start;
+	uint32_t i;
+	int ret = 0;
+
+	if (param->buffer_size) {
+		snprintf(cmd, sizeof(cmd), "OPEN %s %u %08x\r\n", param->device,
+			 (unsigned)(param->buffer_size / frame),
+			 (unsigned)param->mask);
+		if (load_gen_cmd(cli, cmd)) {
+			cli->errors = param->requests;
+			return NULL;
+		}
+		snprintf(cmd, sizeof(cmd), "READBUF %s %u\r\n", param->device,
+			 (unsigned)param->buffer_size);
+	} else {
+		snprintf(cmd, sizeof(cmd), "READ %s %s\r\n", param->device,
+			 param->attr);
+	}
+
+	for (i = 0; i < param->requests; i++) {
+		start = load_gen_now_ns();
+		if (param->buffer_size)
+			ret = load_gen_readbuf(cli, cmd, param->buffer_size);
+		else
+			ret = load_gen_read_attr(cli, cmd);
+		if (ret) {
+			/* The stream can't be resynchronized, give up */
+			cli->errors += param->requests - i;
+			break;
+		}
+		cli->latency[cli->requests++] = load_gen_now_ns() - start;
+	}
+
+	if (param->buffer_size && !ret) {
+		snprintf(cmd, sizeof(cmd), "CLOSE %s\r\n", param->device);
+		load_gen_cmd(cli, cmd);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Run the clients to completion and collect the measurements.
+ * @param param - Load parameters.
+ * @param res - Measurements.
+ * @return 0 in case of success, -1 if the clients could not be started.
+ */
+int32_t load_gen_run(const struct load_gen_param *param,
+		     struct load_gen_result *res)
+{
+	struct load_gen_client *cli[LOAD_GEN_MAX_CLIENTS] = {NULL};
+	pthread_t thread[LOAD_GEN_MAX_CLIENTS];
+	uint64_t *latency;
+	uint64_t start;
+	uint32_t i, n;
+	int32_t ret = -1;
+
+	if (!param->clients || param->clients > LOAD_GEN_MAX_CLIENTS ||
+	    (param->buffer_size && (!param->sample_size || !param->mask)))
+		return -1;
+
+	latency = calloc((size_t)param->clients * param->requests + 1,
+			 sizeof(*latency));
+	if (!latency)
+		return -1;
+
+	for (i = 0; i < param->clients; i++) {
+		cli[i] = calloc(1, sizeof(*cli[i]));
+		if (!cli[i])
+			goto out;
+		cli[i]->param = param;
+		cli[i]->latency = latency + (size_t)i * param->requests;
+		cli[i]->fd = load_gen_connect(param);
+		if (cli[i]->fd < 0)
+			goto out;
+	}
+
+	start = load_gen_now_ns();
+	for (i = 0; i < param->clients; i++)
+		pthread_create(&thread[i], NULL, load_gen_client_thread, cli[i]);
+	for (i = 0; i < param->clients; i++)
+		pthread_join(thread[i], NULL);
+
+	memset(res, 0, sizeof(*res));
+	res->elapsed_ns = load_gen_now_ns() - start;
+
+	/* Gather the latencies at the start of the array */
+	for (i = 0, n = 0; i < param->clients; i++) {
+		memmove(latency + n, cli[i]->latency,
+			cli[i]->requests * sizeof(*latency));
+		n += cli[i]->requests;
+		res->errors += cli[i]->errors;
+		res->bytes += cli[i]->bytes;
+	}
+	res->requests = n;
+
+	if (n) {
+		qsort(latency, n, sizeof(*latency), load_gen_cmp);
+		res->p50_ns = latency[(n - 1) / 2];
+		res->p99_ns = latency[(uint64_t)(n - 1) * 99 / 100];
+		res->max_ns = latency[n - 1];
+	}
+	ret = 0;
+out:
+	for (i = 0; i < param->clients; i++) {
+		if (!cli[i])
+			break;
+		if (cli[i]->fd >= 0)
+			close(cli[i]->fd);
+		free(cli[i]);
+	}
+	free(latency);
+
+	return ret;
+}
@@ -0,0 +1,113 @@
+/***************************************************************************//**
+ *   @file   load_gen.h
+ *   @brief  IIO client load generator used by the IIO server benchmark.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LOAD_GEN_H_
+#define LOAD_GEN_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of concurrent clients, the IIO server handles 4 sockets */
+#define LOAD_GEN_MAX_CLIENTS	4
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct load_gen_param
+ * @brief Load generator parameters.
+ */
+struct load_gen_param {
+	/** IPv4 address of the IIO server */
+	const char *addr;
+	/** Port of the IIO server */
+	uint16_t port;
+	/** Number of concurrent clients, each with its own connection */
+	uint32_t clients;
+	/** Number of requests issued by each client */
+	uint32_t requests;
+	/** Device id of the device under test */
+	const char *device;
+	/** Attribute read by each request when buffer_size is 0 */
+	const char *attr;
+	/** Bytes of each buffer refill, 0 for attribute reads */
+	uint32_t buffer_size;
+	/** Bytes per sample of each channel, used to open the buffer */
+	uint32_t sample_size;
+	/** Channel mask used to open the buffer */
+	uint32_t mask;
+};
+
+/**
+ * @struct load_gen_result
+ * @brief Load generator measurements, latencies are per request.
+ */
+struct load_gen_result {
+	/** Completed requests */
+	uint32_t requests;
+	/** Requests answered with an error or not answered */
+	uint32_t errors;
+	/** Payload bytes received */
+	uint64_t bytes;
+	/** Time from the first request to the last answer (ns) */
+	uint64_t elapsed_ns;
+	/** Median latency (ns) */
+	uint64_t p50_ns;
+	/** 99th percentile latency (ns) */
+	uint64_t p99_ns;
+	/** Maximum latency (ns) */
+	uint64_t max_ns;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Run the clients to completion and collect the measurements. */
+int32_t load_gen_run(const struct load_gen_param *param,
+		     struct load_gen_result *res);
+
+#endif /* LOAD_GEN_H_ */
@@ -0,0 +1,209 @@
+/***************************************************************************//**
+ *   @file   main.c
+ *   @brief  IIO server benchmark over a loopback TCP connection.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "error.h"
+#include "iio.h"
+#include "iio_demo_dev.h"
+#include "tcp_socket.h"
+#include "linux_socket.h"
+#include "load_gen.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* IIOD_PORT of the IIO server */
+#define IIO_BENCH_PORT		30431
+#define IIO_BENCH_DEVICE	"device0"
+/*
+ * The server queues at most 4 sockets and only drops a closed one when it
+ * next reads from it, give it time to reap the previous scenario's clients.
+ */
+#define IIO_BENCH_REAP_US	200000
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Serve the IIO clients until the process exits.
+ * @param arg - IIO server descriptor.
+ * @return Never returns.
+ */
+static void *iio_bench_server(void *arg)
+{
+	struct iio_desc *iio = arg;
+
+	while (true)
+		iio_step(iio);
+
+	return NULL;
+}
+
+/**
+ * @brief Run a load scenario and print its measurements.
+ * @param name - Scenario name.
+ * @param param - Load parameters.
+ * @return 0 if all the requests succeeded, 1 otherwise.
+ */
+static int iio_bench_scenario(const char *name,
+			      const struct load_gen_param *param)
+{
+	struct load_gen_result res;
+	double sec;
+
+	if (load_gen_run(param, &res)) {
+		printf("%-10s could not start the clients\n", name);
+		return 1;
+	}
+
+	sec = res.elapsed_ns / 1e9;
+	printf("%-10s %7u %8u %8u %10.0f %10.2f %8.1f %8.1f %8.1f\n", name,
+	       (unsigned)param->clients, (unsigned)res.requests,
+	       (unsigned)res.errors, sec ? res.requests / sec : 0,
+	       sec ? res.bytes / sec / 1e6 : 0, res.p50_ns / 1e3,
+	       res.p99_ns / 1e3, res.max_ns / 1e3);
+
+	return res.errors != 0;
+}
+
+/**
+ * @brief Start the IIO server with the demo device on loopback and load it.
+ *        Usage: iio_benchmark [-c clients] [-n requests] [-b buffer_bytes]
+ * @return 0 if all the requests succeeded, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	struct linux_socket_init_param net_param = {
+		.bind_addr = "127.0.0.1",
+		.timeout_ms = 100,
+	};
+	struct load_gen_param load = {
+		.addr = "127.0.0.1",
+		.port = IIO_BENCH_PORT,
+		.clients = 1,
+		.requests = 1000,
+		.device = IIO_BENCH_DEVICE,
+		.attr = "demo_global_attr",
+		.sample_size = 2,
+		.mask = 0x3,
+	};
+	struct iio_demo_init_param demo_param = {
+		.dev_global_attr = 2200,
+		.dev_ch_attr = 2211,
+	};
+	struct linux_socket_desc *net_desc;
+	struct tcp_socket_init_param socket_param;
+	struct iio_init_param iio_param;
+	struct iio_data_buffer rd_buf;
+	struct iio_demo_desc *demo;
+	struct iio_desc *iio;
+	uint32_t buffer_size = 16384;
+	pthread_t server;
+	int failed;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "c:n:b:")) != -1) {
+		switch (opt) {
+		case 'c':
+			load.clients = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			load.requests = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			buffer_size = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-c clients] [-n requests] "
+				"[-b buffer_bytes]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!load.clients || load.clients > LOAD_GEN_MAX_CLIENTS) {
+		fprintf(stderr, "clients must be between 1 and %d\n",
+			LOAD_GEN_MAX_CLIENTS);
+		return 1;
+	}
+
+	if (linux_socket_init(&net_desc, &net_param) ||
+	    iio_demo_dev_init(&demo, &demo_param))
+		return 1;
+
+	rd_buf.size = buffer_size;
+	rd_buf.buff = calloc(1, buffer_size + 1);
+	if (!rd_buf.buff)
+		return 1;
+
+	memset(&socket_param, 0, sizeof(socket_param));
+	linux_socket_get_network_interface(net_desc, &socket_param.net);
+	iio_param.phy_type = USE_NETWORK;
+	iio_param.tcp_socket_init_param = &socket_param;
+	if (iio_init(&iio, &iio_param) ||
+	    iio_register(iio, &iio_demo_dev_in_descriptor, "demo_device_input",
+			 demo, &rd_buf, NULL))
+		return 1;
+
+	if (pthread_create(&server, NULL, iio_bench_server, iio))
+		return 1;
+
+	printf("%-10s %7s %8s %8s %10s %10s %8s %8s %8s\n", "scenario",
+	       "clients", "requests", "errors", "req/s", "MB/s", "p50_us",
+	       "p99_us", "max_us");
+
+	load.buffer_size = 0;
+	failed = iio_bench_scenario("attr", &load);
+
+	if (buffer_size) {
+		usleep(IIO_BENCH_REAP_US);
+		load.buffer_size = buffer_size;
+		failed |= iio_bench_scenario("buffer", &load);
+	}
+
+	/* The server thread is blocked in iio_step(), exit with it */
+	return failed;
+}
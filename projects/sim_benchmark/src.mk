@@ -0,0 +1,95 @@
+################################################################################
+#									       #
+#     Shared variables:							       #
+#	- PROJECT							       #
+#	- DRIVERS							       #
+#	- INCLUDE							       #
+#	- PLATFORM_DRIVERS						       #
+#	- NO-OS								       #
+#									       #
+################################################################################
+
+SRCS += $(PROJECT)/src/main.c						\
+	$(PROJECT)/src/bench_ad7124.c					\
+	$(PROJECT)/src/bench_ad7606.c					\
+	$(PROJECT)/src/bench_ad9361.c					\
+	$(PROJECT)/src/bench_ad9081.c					\
+	$(PROJECT)/src/bench_sd.c
+SRCS += $(DRIVERS)/adc/ad7124/ad7124.c					\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.c				\
+	$(DRIVERS)/adc/ad7606/ad7606.c					\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_api.c			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361.c			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_conv.c			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_util.c			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_adc.c			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_dac.c			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_device.c			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_hal.c			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_jesd.c			\
+	$(DRIVERS)/sd-card/sd.c
+SRCS += $(DRIVERS)/spi/spi.c						\
+	$(DRIVERS)/i2c/i2c.c						\
+	$(DRIVERS)/gpio/gpio.c						\
+	$(NO-OS)/util/util.c						\
+	$(NO-OS)/util/crc8.c						\
+	$(NO-OS)/util/crc16.c
+SRCS +=	$(PLATFORM_DRIVERS)/sim_regmap.c				\
+	$(PLATFORM_DRIVERS)/sim_spi.c					\
+	$(PLATFORM_DRIVERS)/sim_i2c.c					\
+	$(PLATFORM_DRIVERS)/sim_gpio.c					\
+	$(PLATFORM_DRIVERS)/sim_delay.c					\
+	$(PLATFORM_DRIVERS)/axi_io.c					\
+	$(PLATFORM_DRIVERS)/irq.c
+INCS += $(PROJECT)/src/bench.h						\
+	$(PROJECT)/src/app_config.h
+INCS += $(DRIVERS)/adc/ad7124/ad7124.h					\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.h				\
+	$(DRIVERS)/adc/ad7606/ad7606.h					\
+	$(DRIVERS)/rf-transceiver/ad9361/common.h			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361.h			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_util.h			\
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_api.h			\
+	$(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.h			\
+	$(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.h			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081.h				\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_hal.h			\
+	$(DRIVERS)/sd-card/sd.h
+INCS += $(INCLUDE)/spi.h						\
+	$(INCLUDE)/i2c.h						\
+	$(INCLUDE)/gpio.h						\
+	$(INCLUDE)/delay.h						\
+	$(INCLUDE)/axi_io.h						\
+	$(INCLUDE)/irq.h						\
+	$(INCLUDE)/util.h						\
+	$(INCLUDE)/crc16.h						\
+	$(INCLUDE)/error.h
+INCS +=	$(PLATFORM_DRIVERS)/sim_regmap.h				\
+	$(PLATFORM_DRIVERS)/sim_spi.h					\
+	$(PLATFORM_DRIVERS)/sim_i2c.h					\
+	$(PLATFORM_DRIVERS)/sim_gpio.h					\
+	$(PLATFORM_DRIVERS)/sim_delay.h					\
+	$(PLATFORM_DRIVERS)/sim_axi_io.h				\
+	$(PLATFORM_DRIVERS)/irq_extra.h
+ifeq (y,$(strip $(IIO)))
+CFLAGS += -DIIO_SUPPORT
+SRCS += $(PROJECT)/src/bench_iio.c					\
+	$(NO-OS)/libraries/iio/iio.c					\
+	$(NO-OS)/iio/iio_demo/demo_dev.c				\
+	$(NO-OS)/libraries/iio/libtinyiiod/tinyiiod.c			\
+	$(NO-OS)/libraries/iio/libtinyiiod/parser.c			\
+	$(NO-OS)/util/xml.c						\
+	$(NO-OS)/util/list.c						\
+	$(NO-OS)/util/fifo.c						\
+	$(PLATFORM_DRIVERS)/sim_uart.c
+INCS += $(NO-OS)/libraries/iio/iio.h					\
+	$(NO-OS)/libraries/iio/iio_types.h				\
+	$(NO-OS)/libraries/iio/libtinyiiod/tinyiiod.h			\
+	$(NO-OS)/iio/iio_demo/demo_dev.h				\
+	$(NO-OS)/iio/iio_demo/iio_demo_dev.h				\
+	$(INCLUDE)/uart.h						\
+	$(INCLUDE)/xml.h						\
+	$(INCLUDE)/list.h						\
+	$(INCLUDE)/fifo.h						\
+	$(PLATFORM_DRIVERS)/sim_uart.h
+endif
@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ *   @file   bench.h
+ *   @brief  Common definitions of the host simulation benchmarks.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct bench_result
+ * @brief Outcome of one benchmark.
+ */
+struct bench_result {
+	/** Benchmark name */
+	const char *name;
+	/** Return code of the last iteration */
+	int32_t ret;
+	/** Number of iterations */
+	uint32_t iterations;
+	/** Host time spent in the benchmarked code (ns) */
+	uint64_t wall_ns;
+	/** Time requested through udelay()/mdelay() (us) */
+	uint64_t delay_us;
+	/** Bus transactions (SPI/I2C transfers, AXI accesses, IIO commands) */
+	uint64_t transactions;
+	/** Bytes moved on the bus */
+	uint64_t bytes;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Monotonic host time in nanoseconds. */
+uint64_t bench_now_ns(void);
+
+/* Print a benchmark outcome, values are per iteration. */
+void bench_print(const struct bench_result *res);
+
+/* ad7124_setup() against a register map model. */
+int32_t bench_ad7124(struct bench_result *res, uint32_t iterations);
+
+/* ad7606_init() in software mode against a register map model. */
+int32_t bench_ad7606(struct bench_result *res, uint32_t iterations);
+
+/* ad9361_init() against register map models of the chip and AXI cores. */
+int32_t bench_ad9361(struct bench_result *res, uint32_t iterations);
+
+/* AD9361 RX LO band switches reloading the gain table. */
+int32_t bench_ad9361_gt(struct bench_result *res, uint32_t iterations);
+
+/* AD9081 NCO tuning word calculation through the API. */
+int32_t bench_ad9081_ftw(struct bench_result *res, uint32_t iterations);
+
+/* AD9081 NCO tuning word calculation with the bit-serial division. */
+int32_t bench_ad9081_ftw_ref(struct bench_result *res, uint32_t iterations);
+
+/* AD9081 main NCO hop through adi_ad9081_dac_duc_nco_set(). */
+int32_t bench_ad9081_nco(struct bench_result *res, uint32_t iterations);
+
+/* AD9081 main NCO hop through a precomputed hop table. */
+int32_t bench_ad9081_hop(struct bench_result *res, uint32_t iterations);
+
+/* SD card sequential 4 KiB writes, streamed as multi-block writes. */
+int32_t bench_sd_seq(struct bench_result *res, uint32_t iterations);
+
+/* SD card sequential 100 byte log records through the write-behind buffer. */
+int32_t bench_sd_log(struct bench_result *res, uint32_t iterations);
+
+#ifdef IIO_SUPPORT
+/* IIO server serving the demo device to a scripted UART client. */
+int32_t bench_iio(struct bench_result *res, uint32_t iterations);
+#endif
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,130 @@
+/***************************************************************************//**
+ *   @file   bench_ad7124.c
+ *   @brief  AD7124 initialization benchmark on the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "bench.h"
+#include "error.h"
+#include "spi.h"
+#include "sim_delay.h"
+#include "sim_regmap.h"
+#include "sim_spi.h"
+#include "ad7124.h"
+#include "ad7124_regs.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Benchmark ad7124_setup() against a register map model.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of setup/remove cycles.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad7124(struct bench_result *res, uint32_t iterations)
+{
+	static struct ad7124_st_reg regs[AD7124_REG_NO];
+	uint32_t defaults[0x40] = {0};
+	struct sim_regmap_init_param map_param = {
+		.num_regs = 0x40,
+		.defaults = defaults,
+	};
+	struct sim_spi_model model = {
+		.protocol = {
+			.instr_bytes = 1,
+			.rw_mask = AD7124_COMM_REG_RD,
+			.read_value = AD7124_COMM_REG_RD,
+			.addr_mask = 0x3F,
+			.addr_step = 0,
+		},
+	};
+	struct spi_init_param spi_param = {
+		.max_speed_hz = 10000000,
+		.mode = SPI_MODE_3,
+		.platform_ops = &sim_spi_platform_ops,
+		.extra = &model,
+	};
+	struct ad7124_init_param init_param = {
+		.spi_init = &spi_param,
+		.regs = regs,
+		.spi_rdy_poll_cnt = 25000,
+	};
+	struct ad7124_dev *dev;
+	uint64_t start;
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < AD7124_REG_NO; i++)
+		defaults[ad7124_regs[i].addr] = ad7124_regs[i].value;
+
+	ret = sim_regmap_init(&model.map, &map_param);
+	if (ret != SUCCESS)
+		goto out;
+
+	for (i = 0; i < iterations; i++) {
+		memcpy(regs, ad7124_regs, sizeof(regs));
+		sim_regmap_reset(model.map, defaults);
+		model.transfers = 0;
+		model.bytes = 0;
+		sim_delay_reset();
+
+		start = bench_now_ns();
+		ret = ad7124_setup(&dev, &init_param);
+		res->wall_ns += bench_now_ns() - start;
+		res->delay_us += sim_delay_get_us();
+		res->transactions += model.transfers;
+		res->bytes += model.bytes;
+		res->iterations++;
+		if (ret < 0)
+			break;
+
+		ret = ad7124_remove(dev);
+		if (ret < 0)
+			break;
+	}
+
+	sim_regmap_remove(model.map);
+out:
+	res->ret = ret < 0 ? ret : SUCCESS;
+
+	return res->ret;
+}
@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ *   @file   bench_ad7606.c
+ *   @brief  AD7606B initialization benchmark on the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "bench.h"
+#include "error.h"
+#include "spi.h"
+#include "gpio.h"
+#include "util.h"
+#include "sim_delay.h"
+#include "sim_regmap.h"
+#include "sim_spi.h"
+#include "sim_gpio.h"
+#include "ad7606.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define AD7606_SIM_NUM_REGS	0x40
+#define AD7606B_SIM_ID		0x12
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief AD7606 register interface model: the data of a read command is
+ *        clocked out during the next frame.
+ * @param model - SPI device model.
+ * @param data - Frame to decode, receives the answer.
+ * @param bytes_number - Frame size.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t ad7606_sim_xfer(struct sim_spi_model *model, uint8_t *data,
+			       uint16_t bytes_number)
+{
+	uint32_t *pending = model->priv;
+	uint8_t addr = data[0] & 0x3F;
+	uint32_t val;
+	int32_t ret;
+
+	if (bytes_number < 2)
+		return FAILURE;
+
+	if (data[0] & AD7606_RD_FLAG_MSK(0)) {
+		ret = sim_regmap_read(model->map, addr, &val);
+	} else {
+		val = *pending;
+		ret = sim_regmap_write(model->map, addr, data[1]);
+	}
+	if (ret != SUCCESS)
+		return ret;
+
+	data[0] = 0;
+	data[1] = *pending;
+	*pending = val;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Benchmark ad7606_init() in software mode against a register map model.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of init/remove cycles.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad7606(struct bench_result *res, uint32_t iterations)
+{
+	static struct gpio_init_param gpios[9];
+	uint32_t defaults[AD7606_SIM_NUM_REGS] = {
+		[AD7606_REG_ID] = AD7606B_SIM_ID,
+	};
+	struct sim_regmap_init_param map_param = {
+		.num_regs = AD7606_SIM_NUM_REGS,
+		.defaults = defaults,
+	};
+	uint32_t pending = 0;
+	struct sim_spi_model model = {
+		.xfer = ad7606_sim_xfer,
+		.priv = &pending,
+	};
+	struct ad7606_init_param init_param = {
+		.spi_init = {
+			.max_speed_hz = 20000000,
+			.mode = SPI_MODE_2,
+			.platform_ops = &sim_spi_platform_ops,
+			.extra = &model,
+		},
+		.gpio_reset = &gpios[0],
+		.gpio_convst = &gpios[1],
+		.gpio_busy = &gpios[2],
+		.gpio_stby_n = &gpios[3],
+		.gpio_range = &gpios[4],
+		.gpio_os0 = &gpios[5],
+		.gpio_os1 = &gpios[6],
+		.gpio_os2 = &gpios[7],
+		.gpio_par_ser = &gpios[8],
+		.device_id = ID_AD7606B,
+		.oversampling = {
+			.os_pad = 0,
+			.os_ratio = AD7606_OSR_1,
+		},
+		.sw_mode = true,
+		.config = {
+			.op_mode = AD7606_NORMAL,
+			.dout_format = AD7606_1_DOUT,
+			.ext_os_clock = false,
+			.status_header = false,
+		},
+	};
+	struct ad7606_dev *dev;
+	uint64_t start;
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < 9; i++) {
+		gpios[i].number = i;
+		gpios[i].platform_ops = &sim_gpio_platform_ops;
+	}
+	for (i = 0; i < AD7606_MAX_CHANNELS; i++) {
+		init_param.range_ch[i].min = -10000;
+		init_param.range_ch[i].max = 10000;
+	}
+
+	ret = sim_regmap_init(&model.map, &map_param);
+	if (ret != SUCCESS)
+		goto out;
+
+	for (i = 0; i < iterations; i++) {
+		sim_regmap_reset(model.map, defaults);
+		pending = 0;
+		model.transfers = 0;
+		model.bytes = 0;
+		sim_delay_reset();
+
+		start = bench_now_ns();
+		ret = ad7606_init(&dev, &init_param);
+		res->wall_ns += bench_now_ns() - start;
+		res->delay_us += sim_delay_get_us();
+		res->transactions += model.transfers;
+		res->bytes += model.bytes;
+		res->iterations++;
+		if (ret < 0)
+			break;
+
+		ret = ad7606_remove(dev);
+		if (ret < 0)
+			break;
+	}
+
+	sim_regmap_remove(model.map);
+out:
+	res->ret = ret < 0 ? ret : SUCCESS;
+
+	return res->ret;
+}
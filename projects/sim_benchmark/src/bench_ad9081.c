@@ -0,0 +1,419 @@
+/***************************************************************************//**
+ *   @file   bench_ad9081.c
+ *   @brief  AD9081 NCO tuning word calculation and NCO hop benchmarks.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include "bench.h"
+#include "error.h"
+#include "spi.h"
+#include "sim_regmap.h"
+#include "sim_spi.h"
+#include "adi_ad9081.h"
+#include "adi_ad9081_hal.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* NCO hops per iteration, each one sets a main and a channelizer NCO */
+#define BENCH_AD9081_HOPS	256
+#define BENCH_AD9081_DAC_FREQ	12000000000ull
+#define BENCH_AD9081_CHAN_FREQ	1500000000ull
+/* NCO hop benchmark: main NCOs of all the DACs, FTW0 register */
+#define BENCH_AD9081_HOP_DACS	AD9081_DAC_ALL
+#define BENCH_AD9081_FTW0_ADDR	0x1CB
+
+/******************************************************************************/
+/************************ Variable Definitions ********************************/
+/******************************************************************************/
+
+/* Keeps the computed words alive so the compiler cannot drop the sweep */
+static volatile uint64_t bench_ad9081_sink;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Reference bit-serial 128-bit division, the algorithm the AD9081 API
+ *        used before the normalized and reciprocal divisions.
+ * @param a_hi - Dividend, upper 64 bits.
+ * @param a_lo - Dividend, lower 64 bits.
+ * @param b - Divisor.
+ * @return The lower 64 bits of the quotient.
+ */
+static uint64_t bench_ad9081_div_ref(uint64_t a_hi, uint64_t a_lo, uint64_t b)
+{
+	uint64_t part_hi = 0, part_lo = b, mask_hi = 0, mask_lo = 1;
+	uint64_t result_hi = 0, result_lo = 0;
+
+	while (!(part_hi & 0x8000000000000000ull)) {
+		adi_ad9081_hal_lshift_128(&part_hi, &part_lo);
+		adi_ad9081_hal_lshift_128(&mask_hi, &mask_lo);
+	}
+
+	do {
+		if ((a_hi > part_hi) || ((a_hi == part_hi) && (a_lo >= part_lo))) {
+			adi_ad9081_hal_sub_128(a_hi, a_lo, part_hi, part_lo,
+					       &a_hi, &a_lo);
+			adi_ad9081_hal_add_128(result_hi, result_lo, mask_hi,
+					       mask_lo, &result_hi, &result_lo);
+		}
+		adi_ad9081_hal_rshift_128(&part_hi, &part_lo);
+		adi_ad9081_hal_rshift_128(&mask_hi, &mask_lo);
+	} while (mask_hi || mask_lo);
+
+	return result_lo;
+}
+
+/**
+ * @brief Reference implementation of adi_ad9081_hal_calc_nco_ftw().
+ * @param freq - Converter clock frequency.
+ * @param nco_shift - NCO shift frequency.
+ * @param ftw - Frequency tuning word.
+ * @param a - Modulus numerator.
+ */
+static void bench_ad9081_calc_ref(uint64_t freq, int64_t nco_shift,
+				 uint64_t *ftw, uint64_t *a)
+{
+	uint64_t hi, lo, hi2, lo2;
+	uint64_t shift = nco_shift >= 0 ? nco_shift : -nco_shift;
+
+	adi_ad9081_hal_mult_128(281474976710656ull, shift, &hi, &lo);
+	*ftw = bench_ad9081_div_ref(hi, lo, freq);
+	adi_ad9081_hal_mult_128(*ftw, freq, &hi2, &lo2);
+	adi_ad9081_hal_sub_128(hi, lo, hi2, lo2, &hi2, &lo2);
+	adi_ad9081_hal_mult_128(lo2, 281474976710655ull, &hi, &lo);
+	*a = bench_ad9081_div_ref(hi, lo, freq);
+	if (nco_shift < 0) {
+		*a = *a ? 281474976710656ull - *a : 0;
+		*ftw = 281474976710656ull - *ftw - (*a ? 1 : 0);
+	}
+}
+
+/**
+ * @brief NCO shift of a hop, spread over both Nyquist halves.
+ * @param hop - Hop index.
+ * @param freq - Converter clock frequency.
+ * @return The NCO shift in Hz.
+ */
+static int64_t bench_ad9081_shift(uint32_t hop, uint64_t freq)
+{
+	int64_t shift = (int64_t)((freq / 2 - 1) / BENCH_AD9081_HOPS * hop) +
+			hop * 7919;
+
+	return (hop & 1) ? -shift : shift;
+}
+
+/**
+ * @brief Run the NCO hop sweep with the API calculation or the reference one.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of sweeps.
+ * @param ref - Use the reference bit-serial calculation.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t bench_ad9081_run(struct bench_result *res, uint32_t iterations,
+				bool ref)
+{
+	static const uint64_t freqs[2] = {
+		BENCH_AD9081_DAC_FREQ, BENCH_AD9081_CHAN_FREQ
+	};
+	adi_ad9081_device_t device = {0};
+	uint64_t ftw, a, b, ref_ftw, ref_a;
+	uint64_t start;
+	uint32_t i, hop, f;
+	int64_t shift;
+	int32_t ret = SUCCESS;
+
+	for (i = 0; i < iterations; i++) {
+		start = bench_now_ns();
+		for (hop = 0; hop < BENCH_AD9081_HOPS; hop++) {
+			for (f = 0; f < 2; f++) {
+				shift = bench_ad9081_shift(hop, freqs[f]);
+				if (ref) {
+					bench_ad9081_calc_ref(freqs[f], shift,
+							     &ftw, &a);
+				} else {
+					ret = adi_ad9081_hal_calc_nco_ftw(
+						      &device, freqs[f], shift,
+						      &ftw, &a, &b);
+					if (ret)
+						goto out;
+				}
+				bench_ad9081_sink = ftw ^ a;
+			}
+		}
+		res->wall_ns += bench_now_ns() - start;
+		res->transactions += BENCH_AD9081_HOPS * 2;
+		res->iterations++;
+	}
+
+	if (ref)
+		goto out;
+
+	/* Check the results against the reference outside of the timed loop */
+	for (hop = 0; hop < BENCH_AD9081_HOPS; hop++) {
+		for (f = 0; f < 2; f++) {
+			shift = bench_ad9081_shift(hop, freqs[f]);
+			adi_ad9081_hal_calc_nco_ftw(&device, freqs[f], shift,
+						    &ftw, &a, &b);
+			bench_ad9081_calc_ref(freqs[f], shift, &ref_ftw, &ref_a);
+			if ((ftw != ref_ftw) || (a != ref_a)) {
+				ret = -EINVAL;
+				goto out;
+			}
+		}
+	}
+out:
+	res->ret = ret;
+
+	return ret;
+}
+
+/**
+ * @brief Benchmark adi_ad9081_hal_calc_nco_ftw() over a sweep of NCO hops.
+ * @param res - Benchmark outcome, transactions counts the computed words.
+ * @param iterations - Number of sweeps.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad9081_ftw(struct bench_result *res, uint32_t iterations)
+{
+	return bench_ad9081_run(res, iterations, false);
+}
+
+/**
+ * @brief Same sweep as bench_ad9081_ftw() with the bit-serial division.
+ * @param res - Benchmark outcome, transactions counts the computed words.
+ * @param iterations - Number of sweeps.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad9081_ftw_ref(struct bench_result *res, uint32_t iterations)
+{
+	return bench_ad9081_run(res, iterations, true);
+}
+
+/**
+ * @brief AD9081 API SPI transfer callback on top of a simulated SPI device.
+ * @param user_data - SPI descriptor.
+ * @param in_data - Transmitted bytes.
+ * @param out_data - Received bytes, may be NULL.
+ * @param size_bytes - Transfer length.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t bench_ad9081_spi_xfer(void *user_data, uint8_t *in_data,
+				     uint8_t *out_data, uint32_t size_bytes)
+{
+	uint8_t data[16];
+	uint32_t i;
+	int32_t ret;
+
+	if (size_bytes > sizeof(data))
+		return FAILURE;
+
+	for (i = 0; i < size_bytes; i++)
+		data[i] = in_data[i];
+
+	ret = spi_write_and_read(user_data, data, size_bytes);
+	if (ret != SUCCESS || !out_data)
+		return ret;
+
+	for (i = 0; i < size_bytes; i++)
+		out_data[i] = data[i];
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read back the main NCO tuning word from the register map model.
+ * @param map - Register map model.
+ * @return The 48-bit tuning word.
+ */
+static uint64_t bench_ad9081_ftw_get(struct sim_regmap *map)
+{
+	uint64_t ftw = 0;
+	uint32_t val;
+	int8_t i;
+
+	for (i = 5; i >= 0; i--) {
+		sim_regmap_read(map, BENCH_AD9081_FTW0_ADDR + i, &val);
+		ftw = (ftw << 8) | (val & 0xFF);
+	}
+
+	return ftw;
+}
+
+/**
+ * @brief Hop the main NCOs of all the DACs over a list of frequencies, either
+ *        with adi_ad9081_dac_duc_nco_set() or with a precomputed hop table.
+ * @param res - Benchmark outcome, values are per hop.
+ * @param iterations - Number of sweeps.
+ * @param table - Use the hop table.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t bench_ad9081_hop_run(struct bench_result *res,
+				    uint32_t iterations, bool table)
+{
+	static adi_ad9081_dac_nco_hop_t hops[BENCH_AD9081_HOPS];
+	struct sim_regmap_init_param map_param = {
+		.num_regs = 0x4000,
+	};
+	struct sim_spi_model model = {
+		.protocol = {
+			.instr_bytes = 2,
+			.rw_mask = 0x8000,
+			.read_value = 0x8000,
+			.addr_mask = 0x3FFF,
+			.addr_step = 1,
+		},
+	};
+	struct spi_init_param spi_param = {
+		.max_speed_hz = 10000000,
+		.mode = SPI_MODE_0,
+		.platform_ops = &sim_spi_platform_ops,
+		.extra = &model,
+	};
+	adi_ad9081_dac_nco_hop_table_t hop_table;
+	adi_ad9081_device_t device = {0};
+	struct spi_desc *spi;
+	uint64_t ftw[BENCH_AD9081_HOPS];
+	int64_t shift[BENCH_AD9081_HOPS];
+	uint64_t start;
+	uint32_t i, hop;
+	int32_t ret;
+
+	ret = sim_regmap_init(&model.map, &map_param);
+	if (ret != SUCCESS)
+		goto out;
+
+	ret = spi_init(&spi, &spi_param);
+	if (ret != SUCCESS)
+		goto out_map;
+
+	device.hal_info.user_data = spi;
+	device.hal_info.spi_xfer = bench_ad9081_spi_xfer;
+	device.hal_info.msb = SPI_MSB_FIRST;
+	device.hal_info.addr_inc = SPI_ADDR_INC_AUTO;
+	device.dev_info.dac_freq_hz = BENCH_AD9081_DAC_FREQ;
+
+	/* Expected tuning words, and the table, outside of the timed loop */
+	for (hop = 0; hop < BENCH_AD9081_HOPS; hop++) {
+		shift[hop] = bench_ad9081_shift(hop, BENCH_AD9081_DAC_FREQ);
+		ret = adi_ad9081_hal_calc_tx_nco_ftw(&device,
+						     BENCH_AD9081_DAC_FREQ,
+						     shift[hop], &ftw[hop]);
+		if (ret)
+			goto out_spi;
+	}
+	if (table) {
+		ret = adi_ad9081_dac_duc_nco_hop_table_init(&device, &hop_table,
+				BENCH_AD9081_HOP_DACS, AD9081_DAC_CH_NONE, hops,
+				BENCH_AD9081_HOPS);
+		if (ret)
+			goto out_spi;
+		for (hop = 0; hop < BENCH_AD9081_HOPS; hop++) {
+			ret = adi_ad9081_dac_duc_nco_hop_table_set(&device,
+					&hop_table, hop, shift[hop]);
+			if (ret)
+				goto out_spi;
+		}
+	}
+
+	for (i = 0; i < iterations; i++) {
+		for (hop = 0; hop < BENCH_AD9081_HOPS; hop++) {
+			model.transfers = 0;
+			model.bytes = 0;
+
+			start = bench_now_ns();
+			if (table)
+				ret = adi_ad9081_dac_duc_nco_hop(&device,
+								 &hop_table,
+								 hop);
+			else
+				ret = adi_ad9081_dac_duc_nco_set(&device,
+								 BENCH_AD9081_HOP_DACS,
+								 AD9081_DAC_CH_NONE,
+								 shift[hop]);
+			res->wall_ns += bench_now_ns() - start;
+			res->transactions += model.transfers;
+			res->bytes += model.bytes;
+			res->iterations++;
+			if (ret)
+				goto out_spi;
+
+			if (bench_ad9081_ftw_get(model.map) != ftw[hop]) {
+				ret = -EINVAL;
+				goto out_spi;
+			}
+		}
+	}
+
+out_spi:
+	spi_remove(spi);
+out_map:
+	sim_regmap_remove(model.map);
+out:
+	res->ret = ret;
+
+	return ret;
+}
+
+/**
+ * @brief Benchmark a main NCO hop through adi_ad9081_dac_duc_nco_set().
+ * @param res - Benchmark outcome, values are per hop.
+ * @param iterations - Number of sweeps.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad9081_nco(struct bench_result *res, uint32_t iterations)
+{
+	return bench_ad9081_hop_run(res, iterations, false);
+}
+
+/**
+ * @brief Benchmark a main NCO hop through a precomputed hop table.
+ * @param res - Benchmark outcome, values are per hop.
+ * @param iterations - Number of sweeps.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_ad9081_hop(struct bench_result *res, uint32_t iterations)
+{
+	return bench_ad9081_hop_run(res, iterations, true);
+}
@@ -0,0 +1,236 @@
+/***************************************************************************//**
+ *   @file   bench_iio.c
+ *   @brief  IIO server benchmark on the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "bench.h"
+#include "error.h"
+#include "uart.h"
+#include "iio.h"
+#include "iio_demo_dev.h"
+#include "sim_delay.h"
+#include "sim_uart.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define BENCH_IIO_SAMPLES	400
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct bench_iio_client
+ * @brief Scripted IIO client on the other end of the simulated UART.
+ */
+struct bench_iio_client {
+	/** Commands to send */
+	const char *const *cmds;
+	/** Number of commands */
+	uint32_t num_cmds;
+	/** Command being sent */
+	uint32_t cmd;
+	/** Bytes of the current command already sent */
+	uint32_t pos;
+	/** Bytes exchanged with the server */
+	uint64_t bytes;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+/* One iio_step() per command: attribute traffic and a buffer capture */
+static const char *const bench_iio_cmds[] = {
+	"VERSION\r\n",
+	"PRINT\r\n",
+	"READ device0 demo_global_attr\r\n",
+	"WRITE device0 demo_global_attr 4\r\n2200",
+	"READ device0 INPUT voltage0 demo_channel_attr\r\n",
+	"WRITE device0 INPUT voltage0 demo_channel_attr 4\r\n2211",
+	"OPEN device0 400 00000003\r\n",
+	"READBUF device0 1600\r\n",
+	"CLOSE device0\r\n",
+};
+
+static uint16_t bench_iio_samples[BENCH_IIO_SAMPLES * 2];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Provide the bytes of the current command to the server.
+ * @param ctx - Client.
+ * @param data - Buffer to fill.
+ * @param len - Maximum number of bytes.
+ * @return Number of bytes provided, -1 at the end of the script.
+ */
+static int32_t bench_iio_client_tx(void *ctx, uint8_t *data, uint32_t len)
+{
+	struct bench_iio_client *client = ctx;
+	const char *cmd;
+	uint32_t left;
+
+	if (client->cmd >= client->num_cmds)
+		return -1;
+
+	cmd = client->cmds[client->cmd];
+	left = strlen(cmd) - client->pos;
+	if (len > left)
+		len = left;
+
+	memcpy(data, cmd + client->pos, len);
+	client->pos += len;
+	client->bytes += len;
+	if (client->pos == strlen(cmd)) {
+		client->cmd++;
+		client->pos = 0;
+	}
+
+	return len;
+}
+
+/**
+ * @brief Consume the answer of the server.
+ * @param ctx - Client.
+ * @param data - Answer bytes.
+ * @param len - Number of bytes.
+ * @return SUCCESS.
+ */
+static int32_t bench_iio_client_rx(void *ctx, const uint8_t *data,
+				   uint32_t len)
+{
+	struct bench_iio_client *client = ctx;
+
+	client->bytes += len;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Benchmark the IIO server serving the demo device to a scripted client.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of runs of the command script.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_iio(struct bench_result *res, uint32_t iterations)
+{
+	struct bench_iio_client client = {
+		.cmds = bench_iio_cmds,
+		.num_cmds = sizeof(bench_iio_cmds) / sizeof(bench_iio_cmds[0]),
+	};
+	struct sim_uart_init_param sim_uart_param = {
+		.peer_tx = bench_iio_client_tx,
+		.peer_rx = bench_iio_client_rx,
+		.ctx = &client,
+	};
+	struct uart_init_param uart_param = {
+		.baud_rate = 921600,
+		.size = UART_CS_8,
+		.parity = UART_PAR_NO,
+		.stop = UART_STOP_1,
+		.extra = &sim_uart_param,
+	};
+	struct iio_init_param iio_param = {
+		.phy_type = USE_UART,
+		.uart_init_param = &uart_param,
+	};
+	struct iio_demo_init_param demo_param = {
+		.dev_global_attr = 2200,
+		.dev_ch_attr = 2211,
+	};
+	struct iio_data_buffer rd_buf = {
+		.buff = bench_iio_samples,
+		.size = sizeof(bench_iio_samples),
+	};
+	struct iio_demo_desc *demo;
+	struct iio_desc *iio;
+	uint64_t start;
+	uint32_t i, j;
+	int32_t ret;
+
+	ret = iio_demo_dev_init(&demo, &demo_param);
+	if (ret < 0)
+		goto out;
+
+	ret = iio_init(&iio, &iio_param);
+	if (ret < 0)
+		goto out_demo;
+
+	ret = iio_register(iio, &iio_demo_dev_in_descriptor, "demo_device_input",
+			   demo, &rd_buf, NULL);
+	if (ret < 0)
+		goto out_iio;
+
+	for (i = 0; i < iterations; i++) {
+		client.cmd = 0;
+		client.pos = 0;
+		client.bytes = 0;
+		sim_delay_reset();
+
+		start = bench_now_ns();
+		for (j = 0; j < client.num_cmds; j++) {
+			ret = iio_step(iio);
+			if (ret < 0)
+				break;
+		}
+		res->wall_ns += bench_now_ns() - start;
+		res->delay_us += sim_delay_get_us();
+		res->transactions += j;
+		res->bytes += client.bytes;
+		res->iterations++;
+		if (ret < 0)
+			break;
+	}
+
+	iio_unregister(iio, "demo_device_input");
+out_iio:
+	iio_remove(iio);
+out_demo:
+	iio_demo_dev_remove(demo);
+out:
+	res->ret = ret < 0 ? ret : SUCCESS;
+
+	return res->ret;
+}
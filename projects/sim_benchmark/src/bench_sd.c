@@ -0,0 +1,472 @@
+/***************************************************************************//**
+ *   @file   bench_sd.c
+ *   @brief  SD card sequential write benchmarks on the host simulation platform.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "error.h"
+#include "spi.h"
+#include "crc16.h"
+#include "sim_delay.h"
+#include "sim_spi.h"
+#include "sd.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* 8 MiB card: (C_SIZE + 1) * 512 KiB */
+#define SD_SIM_C_SIZE		15
+#define SD_SIM_SIZE		((SD_SIM_C_SIZE + 1) * 512 * 1024)
+/* Bytes clocked before the start token of a read block */
+#define SD_SIM_NAC		8
+/* Busy bytes after a block written in a multi-block write, a single-block
+ * write and the stop token; the card programs faster when pre-erased */
+#define SD_SIM_BUSY_MULTI	100
+#define SD_SIM_BUSY_ERASED	50
+#define SD_SIM_BUSY_SINGLE	1000
+#define SD_SIM_BUSY_STOP	200
+/* Data written by each benchmark iteration */
+#define SD_BENCH_LEN		(1024 * 1024)
+#define SD_BENCH_LOG_CHUNK	100
+#define SD_BENCH_SEQ_CHUNK	4096
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+enum sd_sim_state {
+	SD_SIM_CMD,
+	SD_SIM_READ,
+	SD_SIM_WRITE_TOKEN,
+	SD_SIM_WRITE_DATA,
+};
+
+struct sd_sim {
+	uint8_t		*mem;
+	enum sd_sim_state state;
+	bool		idle;
+	bool		app_cmd;
+	bool		crc_on;
+	bool		multi;
+	uint32_t	erased;
+	uint32_t	block;
+	uint8_t		cmd[6];
+	uint32_t	cmd_len;
+	uint8_t		rx[DATA_BLOCK_LEN + 2];
+	uint32_t	rx_len;
+	uint8_t		out[SD_SIM_NAC + 1 + DATA_BLOCK_LEN + 2 + 24];
+	uint32_t	out_pos;
+	uint32_t	out_len;
+	uint32_t	busy;
+	uint16_t	crc_table[CRC16_TABLE_SIZE];
+	uint32_t	crc_errors;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Queue bytes to be clocked out by the card.
+ */
+static void sd_sim_queue(struct sd_sim *sd, const uint8_t *data, uint32_t len)
+{
+	if (sd->out_pos == sd->out_len)
+		sd->out_pos = sd->out_len = 0;
+	memcpy(sd->out + sd->out_len, data, len);
+	sd->out_len += len;
+}
+
+/**
+ * @brief Queue an R1 response, after one byte of command response time.
+ */
+static void sd_sim_r1(struct sd_sim *sd, uint8_t r1)
+{
+	uint8_t resp[2] = {0xFF, r1};
+
+	sd_sim_queue(sd, resp, sizeof(resp));
+}
+
+/**
+ * @brief Queue the next block of a read.
+ */
+static void sd_sim_read_block(struct sd_sim *sd)
+{
+	uint8_t *blk = sd->mem + (uint64_t)sd->block * DATA_BLOCK_LEN;
+	uint16_t crc = crc16(sd->crc_table, blk, DATA_BLOCK_LEN, 0);
+	uint8_t head[SD_SIM_NAC + 1];
+	uint8_t tail[2] = {crc >> 8, crc & 0xFF};
+
+	memset(head, 0xFF, SD_SIM_NAC);
+	head[SD_SIM_NAC] = 0xFE;
+	sd_sim_queue(sd, head, sizeof(head));
+	sd_sim_queue(sd, blk, DATA_BLOCK_LEN);
+	sd_sim_queue(sd, tail, sizeof(tail));
+	sd->block++;
+}
+
+/**
+ * @brief Execute a command received by the card.
+ */
+static void sd_sim_command(struct sd_sim *sd)
+{
+	static const uint8_t r7[] = {0xFF, 0x01, 0x00, 0x00, 0x01, 0xAA};
+	static const uint8_t r3[] = {0xFF, 0x00, 0xC0, 0xFF, 0x80, 0x00};
+	uint8_t csd[1 + 1 + 16 + 2] = {0xFF, 0xFE};
+	uint8_t idx = sd->cmd[0] & 0x3F;
+	uint32_t arg = ((uint32_t)sd->cmd[1] << 24) | (sd->cmd[2] << 16) |
+		       (sd->cmd[3] << 8) | sd->cmd[4];
+	bool app = sd->app_cmd;
+	uint8_t crc = 0;
+	uint32_t i, bit;
+	uint8_t byte;
+
+	for (i = 0; i < 5; i++) {
+		byte = sd->cmd[i];
+		for (bit = 0; bit < 8; bit++) {
+			crc <<= 1;
+			if ((byte ^ crc) & 0x80)
+				crc ^= 0x09;
+			byte <<= 1;
+		}
+	}
+	if ((sd->crc_on || idx == 0 || idx == 8) &&
+	    (uint8_t)((crc << 1) | 1) != sd->cmd[5]) {
+		sd->crc_errors++;
+		sd_sim_r1(sd, 0x08 | sd->idle);
+		return;
+	}
+
+	sd->app_cmd = false;
+	switch (idx) {
+	case 0:
+		sd->idle = true;
+		sd->crc_on = false;
+		sd_sim_r1(sd, 0x01);
+		break;
+	case 8:
+		sd_sim_queue(sd, r7, sizeof(r7));
+		break;
+	case 9:
+		sd_sim_r1(sd, 0x00);
+		csd[2 + 7] = (SD_SIM_C_SIZE >> 16) & 0x3F;
+		csd[2 + 8] = (SD_SIM_C_SIZE >> 8) & 0xFF;
+		csd[2 + 9] = SD_SIM_C_SIZE & 0xFF;
+		sd_sim_queue(sd, csd, sizeof(csd));
+		break;
+	case 12:
+		sd->state = SD_SIM_CMD;
+		sd->out_pos = sd->out_len = 0;
+		sd_sim_r1(sd, 0x00);
+		sd->busy = 4;
+		break;
+	case 17:
+	case 18:
+		if (arg >= SD_SIM_SIZE / DATA_BLOCK_LEN) {
+			sd_sim_r1(sd, 0x40);
+			break;
+		}
+		sd_sim_r1(sd, 0x00);
+		sd->block = arg;
+		sd->multi = idx == 18;
+		sd->state = SD_SIM_READ;
+		sd_sim_read_block(sd);
+		break;
+	case 23:
+		sd->erased = app ? arg & 0x7FFFFF : 0;
+		sd_sim_r1(sd, app ? 0x00 : 0x04);
+		break;
+	case 24:
+	case 25:
+		if (arg >= SD_SIM_SIZE / DATA_BLOCK_LEN) {
+			sd_sim_r1(sd, 0x40);
+			break;
+		}
+		sd_sim_r1(sd, 0x00);
+		sd->block = arg;
+		sd->multi = idx == 25;
+		if (!sd->multi)
+			sd->erased = 0;
+		sd->state = SD_SIM_WRITE_TOKEN;
+		break;
+	case 41:
+		sd->idle = false;
+		sd_sim_r1(sd, 0x00);
+		break;
+	case 55:
+		sd->app_cmd = true;
+		sd_sim_r1(sd, sd->idle);
+		break;
+	case 58:
+		sd_sim_queue(sd, r3, sizeof(r3));
+		break;
+	case 59:
+		sd->crc_on = arg & 1;
+		sd_sim_r1(sd, sd->idle);
+		break;
+	default:
+		sd_sim_r1(sd, 0x04 | sd->idle);
+		break;
+	}
+}
+
+/**
+ * @brief Receive the data block or the token of a write.
+ */
+static void sd_sim_write(struct sd_sim *sd, uint8_t in)
+{
+	uint8_t resp = 0x05;
+	uint16_t crc;
+
+	if (sd->state == SD_SIM_WRITE_TOKEN) {
+		if (in == (sd->multi ? 0xFC : 0xFE)) {
+			sd->state = SD_SIM_WRITE_DATA;
+			sd->rx_len = 0;
+		} else if (in == 0xFD && sd->multi) {
+			sd->state = SD_SIM_CMD;
+			sd->erased = 0;
+			sd->busy = SD_SIM_BUSY_STOP;
+		}
+		return;
+	}
+
+	sd->rx[sd->rx_len++] = in;
+	if (sd->rx_len < sizeof(sd->rx))
+		return;
+
+	crc = (sd->rx[DATA_BLOCK_LEN] << 8) | sd->rx[DATA_BLOCK_LEN + 1];
+	if (sd->crc_on && crc != crc16(sd->crc_table, sd->rx, DATA_BLOCK_LEN, 0)) {
+		sd->crc_errors++;
+		resp = 0x0B;
+	} else if (sd->block >= SD_SIM_SIZE / DATA_BLOCK_LEN) {
+		resp = 0x0D;
+	} else {
+		memcpy(sd->mem + (uint64_t)sd->block * DATA_BLOCK_LEN, sd->rx,
+		       DATA_BLOCK_LEN);
+		sd->block++;
+	}
+	sd_sim_queue(sd, &resp, 1);
+
+	if (!sd->multi) {
+		sd->busy = SD_SIM_BUSY_SINGLE;
+		sd->state = SD_SIM_CMD;
+	} else if (sd->erased) {
+		sd->erased--;
+		sd->busy = SD_SIM_BUSY_ERASED;
+		sd->state = SD_SIM_WRITE_TOKEN;
+	} else {
+		sd->busy = SD_SIM_BUSY_MULTI;
+		sd->state = SD_SIM_WRITE_TOKEN;
+	}
+}
+
+/**
+ * @brief SD card in SPI mode, clocked one byte at a time.
+ * @param model - SPI device model.
+ * @param data - Bytes from the host, receives the card's bytes.
+ * @param bytes_number - Number of bytes.
+ * @return SUCCESS.
+ */
+static int32_t sd_sim_xfer(struct sim_spi_model *model, uint8_t *data,
+			   uint16_t bytes_number)
+{
+	struct sd_sim *sd = model->priv;
+	uint8_t in;
+	uint32_t i;
+
+	for (i = 0; i < bytes_number; i++) {
+		in = data[i];
+
+		if (sd->out_pos < sd->out_len) {
+			data[i] = sd->out[sd->out_pos++];
+		} else if (sd->busy) {
+			sd->busy--;
+			data[i] = 0x00;
+		} else {
+			data[i] = 0xFF;
+			if (sd->state == SD_SIM_READ && sd->multi)
+				sd_sim_read_block(sd);
+			else if (sd->state == SD_SIM_READ)
+				sd->state = SD_SIM_CMD;
+		}
+
+		if (sd->state == SD_SIM_WRITE_TOKEN ||
+		    sd->state == SD_SIM_WRITE_DATA) {
+			if (!sd->busy && sd->out_pos == sd->out_len)
+				sd_sim_write(sd, in);
+			continue;
+		}
+
+		if (!sd->cmd_len && (in & 0xC0) != 0x40)
+			continue;
+		sd->cmd[sd->cmd_len++] = in;
+		if (sd->cmd_len == sizeof(sd->cmd)) {
+			sd->cmd_len = 0;
+			sd_sim_command(sd);
+		}
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write SD_BENCH_LEN bytes in chunks through sd_write() and read them
+ *        back, only the writes and the final flush are measured.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of init/write/remove cycles.
+ * @param chunk - Bytes written by each sd_write() call.
+ * @param param - SD card parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t bench_sd(struct bench_result *res, uint32_t iterations,
+			uint32_t chunk, struct sd_init_param *param)
+{
+	struct sd_sim *sd;
+	struct sim_spi_model model = {
+		.xfer = sd_sim_xfer,
+	};
+	struct spi_init_param spi_param = {
+		.max_speed_hz = 25000000,
+		.mode = SPI_MODE_0,
+		.platform_ops = &sim_spi_platform_ops,
+		.extra = &model,
+	};
+	struct sd_desc *desc;
+	uint8_t *src, *dst;
+	uint64_t start;
+	uint32_t i, off, len;
+	int32_t ret = -ENOMEM;
+
+	sd = calloc(1, sizeof(*sd));
+	src = malloc(SD_BENCH_LEN);
+	dst = malloc(SD_BENCH_LEN);
+	if (sd)
+		sd->mem = calloc(1, SD_SIM_SIZE);
+	if (!sd || !sd->mem || !src || !dst)
+		goto out;
+	crc16_populate_msb(sd->crc_table, 0x1021);
+	model.priv = sd;
+	for (i = 0; i < SD_BENCH_LEN; i++)
+		src[i] = i * 7 + (i >> 9);
+
+	ret = spi_init(&param->spi_desc, &spi_param);
+	if (ret != SUCCESS)
+		goto out;
+
+	for (i = 0; i < iterations; i++) {
+		ret = sd_init(&desc, param);
+		if (ret != SUCCESS)
+			break;
+
+		model.transfers = 0;
+		model.bytes = 0;
+		sim_delay_reset();
+
+		/* Unaligned start, as a log appended to a file would be */
+		start = bench_now_ns();
+		for (off = 0; off < SD_BENCH_LEN && ret == SUCCESS; off += len) {
+			len = SD_BENCH_LEN - off < chunk ? SD_BENCH_LEN - off : chunk;
+			ret = sd_write(desc, src + off, 1000 + off, len);
+		}
+		if (ret == SUCCESS)
+			ret = sd_flush(desc);
+		res->wall_ns += bench_now_ns() - start;
+		res->delay_us += sim_delay_get_us();
+		res->transactions += model.transfers;
+		res->bytes += model.bytes;
+		res->iterations++;
+
+		if (ret == SUCCESS)
+			ret = sd_read(desc, dst, 1000, SD_BENCH_LEN);
+		if (ret == SUCCESS && (memcmp(src, dst, SD_BENCH_LEN) ||
+				       sd->crc_errors))
+			ret = FAILURE;
+		sd_remove(desc);
+		if (ret != SUCCESS)
+			break;
+	}
+
+	spi_remove(param->spi_desc);
+out:
+	if (sd)
+		free(sd->mem);
+	free(sd);
+	free(src);
+	free(dst);
+	res->ret = ret < 0 ? ret : SUCCESS;
+
+	return res->ret;
+}
+
+/**
+ * @brief Sequential 4 KiB writes, streamed as multi-block writes.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of iterations.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_sd_seq(struct bench_result *res, uint32_t iterations)
+{
+	struct sd_init_param param = {
+		.cache_blocks = 8,
+	};
+
+	return bench_sd(res, iterations, SD_BENCH_SEQ_CHUNK, &param);
+}
+
+/**
+ * @brief Sequential 100 byte log records, coalesced by the write-behind
+ *        cache, with CRC protection.
+ * @param res - Benchmark outcome.
+ * @param iterations - Number of iterations.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t bench_sd_log(struct bench_result *res, uint32_t iterations)
+{
+	struct sd_init_param param = {
+		.cache_blocks = 16,
+		.crc_enable = true,
+	};
+
+	return bench_sd(res, iterations, SD_BENCH_LOG_CHUNK, &param);
+}
@@ -0,0 +1,142 @@
+/***************************************************************************//**
+ *   @file   main.c
+ *   @brief  Host simulation benchmarks of driver initialization sequences.
+********************************************************************************
+ * Copyright 2020(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "sim_delay.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Monotonic host time in nanoseconds.
+ * @return Time in nanoseconds.
+ */
+uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Print a benchmark outcome, values are per iteration.
+ * @param res - Benchmark outcome.
+ */
+void bench_print(const struct bench_result *res)
+{
+	uint32_t n = res->iterations ? res->iterations : 1;
+
+	printf("%-10s %6s %10"PRIu64" %12"PRIu64" %12"PRIu64" %12"PRIu64"\n",
+	       res->name, res->ret ? "FAIL" : "ok", res->wall_ns / n / 1000,
+	       res->delay_us / n, res->transactions / n, res->bytes / n);
+}
+
+/**
+ * @brief Run the benchmarks given on the command line, or all of them.
+ *        Usage: sim_benchmark [-n iterations] [ad7124|ad7606|ad9361|ad9361_gt|ad9081_ftw|ad9081_ref|ad9081_nco|ad9081_hop|sd_seq|sd_log|iio]...
+ * @return 0 if all the benchmarks passed, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	static const struct {
+		const char *name;
+		int32_t (*run)(struct bench_result *res, uint32_t iterations);
+	} benches[] = {
+		{"ad7124", bench_ad7124},
+		{"ad7606", bench_ad7606},
+		{"ad9361", bench_ad9361},
+		{"ad9361_gt", bench_ad9361_gt},
+		{"ad9081_ftw", bench_ad9081_ftw},
+		{"ad9081_ref", bench_ad9081_ftw_ref},
+		{"ad9081_nco", bench_ad9081_nco},
+		{"ad9081_hop", bench_ad9081_hop},
+		{"sd_seq", bench_sd_seq},
+		{"sd_log", bench_sd_log},
+#ifdef IIO_SUPPORT
+		{"iio", bench_iio},
+#endif
+	};
+	struct bench_result res;
+	uint32_t iterations = 10;
+	int selected = 0;
+	int failed = 0;
+	int i, j;
+
+	for (i = 1; i < argc; i++)
+		if (!strcmp(argv[i], "-n") && i + 1 < argc)
+			iterations = strtoul(argv[++i], NULL, 0);
+		else
+			selected++;
+
+	/* Account the delays instead of sleeping: measure the code, not the waits */
+	sim_delay_set_real(false);
+
+	printf("%-10s %6s %10s %12s %12s %12s\n", "bench", "status", "wall_us",
+	       "delay_us", "transactions", "bytes");
+
+	for (j = 0; j < (int)(sizeof(benches) / sizeof(benches[0])); j++) {
+		if (selected) {
+			for (i = 1; i < argc; i++)
+				if (!strcmp(argv[i], benches[j].name))
+					break;
+			if (i == argc)
+				continue;
+		}
+
+		memset(&res, 0, sizeof(res));
+		res.name = benches[j].name;
+		benches[j].run(&res, iterations);
+		bench_print(&res);
+		if (res.ret)
+			failed = 1;
+	}
+
+	return failed;
+}
@@ -48,7 +48,7 @@ FATFS_DIR					= $(NO-OS)/libraries/fatfs
 FATFS_LIB					= $(FATFS_DIR)/libfatfs.a
 EXTRA_LIBS					+= $(FATFS_LIB)
 EXTRA_LIBS_PATHS			+= $(FATFS_DIR)
-EXTRA_INC_PATHS	+= $(FATFS_DIR)/source
+EXTRA_INC_PATHS	+= $(FATFS_DIR)/source $(FATFS_DIR)
 
 # Rules
 CLEAN_FATFS	= $(MAKE) -C $(NO-OS)/libraries/fatfs clean
@@ -40,6 +40,7 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <stddef.h>
 #include "error.h"
 #include "clk.h"
 
@@ -47,34 +48,265 @@
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+/**
+ * Drop the cached rates of a clock and of its descendants and notify the
+ * consumers of the clocks whose rate actually changed.
+ * Only clocks that have notifiers attached are read back, the others are
+ * re-read on demand by the next clk_recalc_rate() call.
+ * @param clk - The clock structure.
+ * @return SUCCESS in case of success, the first notifier error otherwise.
+ */
+static int32_t clk_propagate_rate(struct clk *clk)
+{
+	struct clk_notifier *nb;
+	struct clk *child;
+	uint64_t old_rate;
+	uint64_t new_rate;
+	bool old_valid;
+	int32_t ret = SUCCESS;
+	int32_t err;
+
+	old_rate = clk->rate;
+	old_valid = clk->rate_valid;
+	clk->rate_valid = false;
+	clk->round_valid = false;
+	clk->req_valid = false;
+
+	if (clk->notifiers && !clk_recalc_rate(clk, &new_rate) &&
+	    (!old_valid || (old_rate != new_rate))) {
+		for (nb = clk->notifiers; nb; nb = nb->next) {
+			err = nb->notifier_call(nb, clk,
+						old_valid ? old_rate : 0,
+						new_rate);
+			if (err && !ret)
+				ret = err;
+		}
+	}
+
+	for (child = clk->first_child; child; child = child->next_sibling) {
+		err = clk_propagate_rate(child);
+		if (err && !ret)
+			ret = err;
+	}
+
+	return ret;
+}
+
+/**
+ * Add the clock to the clock tree, under the given parent.
+ * The hw, hw_ch_num and name fields must be set by the caller, the tree
+ * links, the cached rates and the enable count are reset.
+ * @param clk - The clock structure.
+ * @param parent - The parent clock, NULL for a root clock.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t clk_register(struct clk *clk,
+		     struct clk *parent)
+{
+	if (!clk || (clk == parent))
+		return -EINVAL;
+
+	clk->parent = parent;
+	clk->first_child = NULL;
+	clk->next_sibling = NULL;
+	clk->rate_valid = false;
+	clk->req_valid = false;
+	clk->round_valid = false;
+	clk->enable_count = 0;
+	clk->notifiers = NULL;
+
+	if (parent) {
+		clk->next_sibling = parent->first_child;
+		parent->first_child = clk;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Remove the clock from the clock tree.
+ * The children of the clock become root clocks.
+ * @param clk - The clock structure.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t clk_unregister(struct clk *clk)
+{
+	struct clk **link;
+	struct clk *child;
+	struct clk *next;
+
+	if (!clk)
+		return -EINVAL;
+
+	if (clk->parent) {
+		link = &clk->parent->first_child;
+		while (*link && (*link != clk))
+			link = &(*link)->next_sibling;
+		if (*link)
+			*link = clk->next_sibling;
+	}
+
+	for (child = clk->first_child; child; child = next) {
+		next = child->next_sibling;
+		child->parent = NULL;
+		child->next_sibling = NULL;
+	}
+
+	clk->parent = NULL;
+	clk->first_child = NULL;
+	clk->next_sibling = NULL;
+	clk->notifiers = NULL;
+
+	return SUCCESS;
+}
+
+/**
+ * Attach a rate change notifier to the clock.
+ * @param clk - The clock structure.
+ * @param nb - The notifier, must stay valid until it is unregistered.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t clk_notifier_register(struct clk *clk,
+			      struct clk_notifier *nb)
+{
+	if (!clk || !nb || !nb->notifier_call)
+		return -EINVAL;
+
+	nb->next = clk->notifiers;
+	clk->notifiers = nb;
+
+	return SUCCESS;
+}
+
+/**
+ * Detach a rate change notifier from the clock.
+ * @param clk - The clock structure.
+ * @param nb - The notifier.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t clk_notifier_unregister(struct clk *clk,
+				struct clk_notifier *nb)
+{
+	struct clk_notifier **link;
+
+	if (!clk || !nb)
+		return -EINVAL;
+
+	for (link = &clk->notifiers; *link; link = &(*link)->next) {
+		if (*link == nb) {
+			*link = nb->next;
+			nb->next = NULL;
+			return SUCCESS;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * Drop the cached rates of the clock and of all its descendants.
+ * Must be called when the clock hardware was reprogrammed without going
+ * through clk_set_rate().
+ * @param clk - The clock structure.
+ */
+void clk_invalidate_rate(struct clk *clk)
+{
+	struct clk *child;
+
+	clk->rate_valid = false;
+	clk->req_valid = false;
+	clk->round_valid = false;
+
+	for (child = clk->first_child; child; child = child->next_sibling)
+		clk_invalidate_rate(child);
+}
+
+/**
+ * Enable a clock of the tree, enabling its parents first.
+ * Clocks without an enable callback are considered always running and are
+ * only reference counted.
+ * @param clk - The clock structure.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t clk_enable_tree(struct clk *clk)
+{
+	int32_t ret;
+
+	if (clk->enable_count) {
+		clk->enable_count++;
+		return SUCCESS;
+	}
+
+	if (clk->parent) {
+		ret = clk_enable_tree(clk->parent);
+		if (ret)
+			return ret;
+	}
+
+	if (clk->hw->dev_clk_enable) {
+		ret = clk->hw->dev_clk_enable(clk->hw->dev);
+		if (ret) {
+			if (clk->parent)
+				clk_disable(clk->parent);
+			return ret;
+		}
+	}
+
+	clk->enable_count = 1;
+
+	return SUCCESS;
+}
+
 /**
  * Start the clock.
+ * Calls are reference counted, the hardware is only touched by the first
+ * enable and the parent clocks are enabled before the clock itself.
  * @param clk - The clock structure.
  * @return SUCCESS in case of success, negative error code otherwise.
  */
 int32_t clk_enable(struct clk * clk)
 {
-	if (clk->hw->dev_clk_enable)
-		return clk->hw->dev_clk_enable(clk->hw->dev);
-	else
+	if (!clk->hw->dev_clk_enable)
 		return FAILURE;
+
+	return clk_enable_tree(clk);
 }
 
 /**
  * Stop the clock.
+ * The hardware is only touched by the disable call that balances the first
+ * enable, the parent clocks are released afterwards. A disable call on a
+ * clock that was never enabled is forwarded to the hardware as is.
  * @param clk - The clock structure.
  * @return SUCCESS in case of success, negative error code otherwise.
  */
 int32_t clk_disable(struct clk * clk)
 {
+	int32_t ret = SUCCESS;
+
+	if (!clk->enable_count) {
+		if (clk->hw->dev_clk_disable)
+			return clk->hw->dev_clk_disable(clk->hw->dev);
+		else
+			return FAILURE;
+	}
+
+	if (--clk->enable_count)
+		return SUCCESS;
+
 	if (clk->hw->dev_clk_disable)
-		return clk->hw->dev_clk_disable(clk->hw->dev);
-	else
-		return FAILURE;
+		ret = clk->hw->dev_clk_disable(clk->hw->dev);
+
+	if (clk->parent && clk->parent->enable_count)
+		clk_disable(clk->parent);
+
+	return ret;
 }
 
 /**
  * Get the current frequency of the clock.
+ * The rate is read from the hardware once and served from the cache until
+ * the clock or one of its ancestors changes rate.
  * @param clk - The clock structure.
  * @param rate - The current frequency.
  * @return SUCCESS in case of success, negative error code otherwise.
@@ -82,16 +314,31 @@ int32_t clk_disable(struct clk * clk)
 int32_t clk_recalc_rate(struct clk *clk,
 			uint64_t *rate)
 {
-	if (clk->hw->dev_clk_recalc_rate)
-		return clk->hw->dev_clk_recalc_rate(clk->hw->dev,
-						    clk->hw_ch_num,
-						    rate);
-	else
+	int32_t ret;
+
+	if (clk->rate_valid) {
+		*rate = clk->rate;
+		return SUCCESS;
+	}
+
+	if (!clk->hw->dev_clk_recalc_rate)
 		return FAILURE;
+
+	ret = clk->hw->dev_clk_recalc_rate(clk->hw->dev, clk->hw_ch_num,
+					   &clk->rate);
+	if (ret)
+		return ret;
+
+	clk->rate_valid = true;
+	*rate = clk->rate;
+
+	return SUCCESS;
 }
 
 /**
  * Round the desired frequency to a rate that the clock can actually output.
+ * The result of the last request is remembered, so a round followed by a set
+ * of the same rate only runs the divider search once.
  * @param clk - The clock structure.
  * @param rate - The desired frequency.
  * @param rounded_rate - The rounded frequency.
@@ -101,17 +348,35 @@ int32_t clk_round_rate(struct clk *clk,
 		       uint64_t rate,
 		       uint64_t *rounded_rate)
 {
-	if (clk->hw->dev_clk_round_rate)
-		return clk->hw->dev_clk_round_rate(clk->hw->dev,
-						   clk->hw_ch_num,
-						   rate,
-						   rounded_rate);
-	else
+	int32_t ret;
+
+	if (clk->round_valid && (clk->round_req == rate)) {
+		*rounded_rate = clk->round_rate;
+		return SUCCESS;
+	}
+
+	if (!clk->hw->dev_clk_round_rate)
 		return FAILURE;
+
+	ret = clk->hw->dev_clk_round_rate(clk->hw->dev, clk->hw_ch_num,
+					  rate, &clk->round_rate);
+	if (ret) {
+		clk->round_valid = false;
+		return ret;
+	}
+
+	clk->round_req = rate;
+	clk->round_valid = true;
+	*rounded_rate = clk->round_rate;
+
+	return SUCCESS;
 }
 
 /**
  * Change the frequency of the clock.
+ * Requesting the rate that is already programmed does not touch the
+ * hardware. On change, the cached rates of the whole subtree are dropped and
+ * the notifiers of the clocks whose rate moved are called.
  * @param clk - The clock structure.
  * @param rate - The desired frequency.
  * @return SUCCESS in case of success, negative error code otherwise.
@@ -119,10 +384,25 @@ int32_t clk_round_rate(struct clk *clk,
 int32_t clk_set_rate(struct clk *clk,
 		     uint64_t rate)
 {
-	if (clk->hw->dev_clk_set_rate)
-		return clk->hw->dev_clk_set_rate(clk->hw->dev,
-						 clk->hw_ch_num,
-						 rate);
-	else
+	int32_t ret;
+
+	if (!clk->hw->dev_clk_set_rate)
 		return FAILURE;
+
+	/* Nothing changed since the last request, skip the register writes. */
+	if (clk->req_valid && (clk->req_rate == rate))
+		return SUCCESS;
+
+	ret = clk->hw->dev_clk_set_rate(clk->hw->dev, clk->hw_ch_num, rate);
+	if (ret) {
+		clk_invalidate_rate(clk);
+		return ret;
+	}
+
+	ret = clk_propagate_rate(clk);
+
+	clk->req_rate = rate;
+	clk->req_valid = true;
+
+	return ret;
 }
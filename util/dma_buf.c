@@ -0,0 +1,380 @@
+/***************************************************************************//**
+ *   @file   dma_buf.c
+ *   @brief  Implementation of the DMA buffer allocator
+********************************************************************************
+ *   @copyright
+ * Copyright 2021(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "dma_buf.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define DMA_BUF_ALIGN_DOWN(x, line)	((x) & ~((uintptr_t)(line) - 1))
+#define DMA_BUF_ALIGN_UP(x, line)	DMA_BUF_ALIGN_DOWN((x) + (line) - 1, line)
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize a DMA buffer region.
+ * The start of the region is moved up to the next cache line boundary and
+ * its size is truncated to a multiple of the cache line size, so every
+ * buffer allocated from it owns whole cache lines.
+ * @param region - The region descriptor.
+ * @param param - The structure that contains the region parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_region_init(struct dma_buf_region **region,
+			    const struct dma_buf_region_init_param *param)
+{
+	struct dma_buf_region *desc;
+	uintptr_t start;
+	uintptr_t end;
+	int32_t ret;
+
+	if (!region || !param || !param->platform_ops ||
+	    !param->platform_ops->dma_buf_ops_flush ||
+	    !param->platform_ops->dma_buf_ops_invalidate)
+		return -EINVAL;
+
+	desc = (struct dma_buf_region *)calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->cpu_addr = param->cpu_addr;
+	desc->bus_addr = param->bus_addr;
+	desc->size = param->size;
+	desc->line_size = param->line_size ? param->line_size :
+			  DMA_BUF_DEFAULT_LINE_SIZE;
+	desc->coherent = param->coherent;
+	desc->platform_ops = param->platform_ops;
+
+	if (desc->line_size & (desc->line_size - 1)) {
+		ret = -EINVAL;
+		goto error;
+	}
+
+	if (desc->platform_ops->dma_buf_ops_init) {
+		ret = desc->platform_ops->dma_buf_ops_init(desc, param);
+		if (ret < 0)
+			goto error;
+	}
+
+	if (!desc->cpu_addr || !desc->size) {
+		ret = -EINVAL;
+		goto error_remove;
+	}
+	if (!desc->bus_addr)
+		desc->bus_addr = (uint32_t)desc->cpu_addr;
+
+	start = DMA_BUF_ALIGN_UP(desc->cpu_addr, desc->line_size);
+	end = DMA_BUF_ALIGN_DOWN(desc->cpu_addr + desc->size, desc->line_size);
+	if (end <= start) {
+		ret = -EINVAL;
+		goto error_remove;
+	}
+	desc->bus_addr += start - desc->cpu_addr;
+	desc->cpu_addr = start;
+	desc->size = end - start;
+
+	*region = desc;
+
+	return SUCCESS;
+
+error_remove:
+	if (desc->platform_ops->dma_buf_ops_remove)
+		desc->platform_ops->dma_buf_ops_remove(desc);
+error:
+	free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by dma_buf_region_init().
+ * @param region - The region descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_region_remove(struct dma_buf_region *region)
+{
+	int32_t ret;
+
+	if (!region)
+		return -EINVAL;
+
+	if (region->bufs)
+		return -EBUSY;
+
+	if (region->platform_ops->dma_buf_ops_remove) {
+		ret = region->platform_ops->dma_buf_ops_remove(region);
+		if (ret < 0)
+			return ret;
+	}
+
+	free(region);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Allocate a buffer from a region.
+ * The buffer starts on a cache line boundary and is padded to a multiple of
+ * the cache line size, so cache maintenance on it never touches data owned
+ * by someone else. The first free gap large enough is used.
+ * @param region - The region descriptor.
+ * @param size - Size of the buffer, in bytes.
+ * @param buf - The allocated buffer.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_alloc(struct dma_buf_region *region, uint32_t size,
+		      struct dma_buf **buf)
+{
+	struct dma_buf **link;
+	struct dma_buf *new_buf;
+	uintptr_t start;
+	uint32_t alloc_size;
+
+	if (!region || !size || !buf || size > region->size)
+		return -EINVAL;
+
+	alloc_size = DMA_BUF_ALIGN_UP(size, region->line_size);
+
+	start = region->cpu_addr;
+	for (link = &region->bufs; *link; link = &(*link)->next) {
+		if ((uintptr_t)(*link)->cpu_addr - start >= alloc_size)
+			break;
+		start = (uintptr_t)(*link)->cpu_addr + (*link)->alloc_size;
+	}
+	if (!*link && region->cpu_addr + region->size - start < alloc_size)
+		return -ENOMEM;
+
+	new_buf = (struct dma_buf *)calloc(1, sizeof(*new_buf));
+	if (!new_buf)
+		return -ENOMEM;
+
+	new_buf->region = region;
+	new_buf->cpu_addr = (void *)start;
+	new_buf->bus_addr = region->bus_addr + (start - region->cpu_addr);
+	new_buf->size = size;
+	new_buf->alloc_size = alloc_size;
+	new_buf->owner = DMA_BUF_OWNER_CPU;
+	new_buf->next = *link;
+	*link = new_buf;
+
+	*buf = new_buf;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Return a buffer to its region.
+ * @param buf - The buffer.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_free(struct dma_buf *buf)
+{
+	struct dma_buf **link;
+
+	if (!buf)
+		return -EINVAL;
+
+	for (link = &buf->region->bufs; *link; link = &(*link)->next) {
+		if (*link == buf) {
+			*link = buf->next;
+			free(buf);
+
+			return SUCCESS;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/**
+ * @brief Find the buffer that contains a CPU address.
+ * Lets code that receives plain pointers, like the IIO read_dev and
+ * write_dev callbacks, recover the bus address and the sync state.
+ * @param region - The region descriptor.
+ * @param cpu_addr - Address inside the buffer.
+ * @param buf - The buffer containing cpu_addr.
+ * @param offset - Offset of cpu_addr in the buffer. May be NULL.
+ * @return SUCCESS in case of success, -ENOENT if the address is not part of
+ *         a buffer of the region.
+ */
+int32_t dma_buf_lookup(struct dma_buf_region *region, const void *cpu_addr,
+		       struct dma_buf **buf, uint32_t *offset)
+{
+	struct dma_buf *it;
+	uintptr_t addr = (uintptr_t)cpu_addr;
+
+	if (!region || !buf)
+		return -EINVAL;
+
+	for (it = region->bufs; it; it = it->next) {
+		if (addr < (uintptr_t)it->cpu_addr)
+			break;
+		if (addr - (uintptr_t)it->cpu_addr < it->size) {
+			*buf = it;
+			if (offset)
+				*offset = addr - (uintptr_t)it->cpu_addr;
+
+			return SUCCESS;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Compute the cache line aligned range of a buffer part.
+ * @param buf - The buffer.
+ * @param offset - Offset of the part in the buffer.
+ * @param size - Size of the part.
+ * @param addr - Aligned start address.
+ * @param len - Aligned length.
+ * @return SUCCESS in case of success, -EINVAL if the part is out of bounds.
+ */
+static int32_t dma_buf_line_range(struct dma_buf *buf, uint32_t offset,
+				  uint32_t size, uintptr_t *addr,
+				  uint32_t *len)
+{
+	uintptr_t start;
+	uintptr_t end;
+
+	if (offset > buf->size || size > buf->size - offset)
+		return -EINVAL;
+
+	start = (uintptr_t)buf->cpu_addr + offset;
+	end = start + size;
+	*addr = DMA_BUF_ALIGN_DOWN(start, buf->region->line_size);
+	*len = DMA_BUF_ALIGN_UP(end, buf->region->line_size) - *addr;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Hand a part of the buffer to the device.
+ * Must be called before starting a transfer on the buffer. Dirty lines are
+ * written back for transfers to the device and discarded for transfers from
+ * it. The maintenance is done on every call, since the buffer parts synced
+ * may differ from one call to the next; only a coherent region skips it.
+ * @param buf - The buffer.
+ * @param offset - Offset of the transferred part, in bytes.
+ * @param size - Size of the transferred part, in bytes.
+ * @param dir - Direction of the transfer.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_sync_for_device(struct dma_buf *buf, uint32_t offset,
+				uint32_t size, enum dma_buf_dir dir)
+{
+	const struct dma_buf_platform_ops *ops;
+	uintptr_t addr;
+	uint32_t len;
+	int32_t ret;
+
+	if (!buf)
+		return -EINVAL;
+
+	ret = dma_buf_line_range(buf, offset, size, &addr, &len);
+	if (ret < 0)
+		return ret;
+
+	if (buf->region->coherent) {
+		buf->owner = DMA_BUF_OWNER_DEVICE;
+		return SUCCESS;
+	}
+
+	ops = buf->region->platform_ops;
+	if (dir == DMA_BUF_FROM_DEVICE)
+		ret = ops->dma_buf_ops_invalidate(buf->region, addr, len);
+	else
+		ret = ops->dma_buf_ops_flush(buf->region, addr, len);
+	if (ret < 0)
+		return ret;
+
+	buf->owner = DMA_BUF_OWNER_DEVICE;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Hand a part of the buffer back to the CPU.
+ * Must be called after a transfer completes and before the CPU accesses the
+ * buffer. Lines written by the device are invalidated so the CPU does not
+ * read stale data. As for dma_buf_sync_for_device(), only a coherent region
+ * skips the maintenance.
+ * @param buf - The buffer.
+ * @param offset - Offset of the transferred part, in bytes.
+ * @param size - Size of the transferred part, in bytes.
+ * @param dir - Direction of the transfer.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t dma_buf_sync_for_cpu(struct dma_buf *buf, uint32_t offset,
+			     uint32_t size, enum dma_buf_dir dir)
+{
+	uintptr_t addr;
+	uint32_t len;
+	int32_t ret;
+
+	if (!buf)
+		return -EINVAL;
+
+	ret = dma_buf_line_range(buf, offset, size, &addr, &len);
+	if (ret < 0)
+		return ret;
+
+	if (dir != DMA_BUF_TO_DEVICE && !buf->region->coherent) {
+		ret = buf->region->platform_ops->dma_buf_ops_invalidate(
+			      buf->region, addr, len);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (!offset && size == buf->size)
+		buf->owner = DMA_BUF_OWNER_CPU;
+	else
+		buf->owner = DMA_BUF_OWNER_SHARED;
+
+	return SUCCESS;
+}